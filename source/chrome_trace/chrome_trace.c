@@ -0,0 +1,228 @@
+/**
+ * @file chrome_trace.c
+ * @brief Chrome Trace main file
+ * @details Here we stream the Control Loop timeline as Chrome trace-event JSON: one span per tick & per Task
+ * (Control Loop track), one instant per Event Ring Record (Events track) and one span from every button edge
+ * (Switch goes PRE_PRESSED) to the Motor Angle change it caused (Edge to Motor Angle track). <br>
+ * Trace Events are formatted in a static buffer which is written only when full, so tracing costs a few
+ * formatted lines per tick and a File write every few thousand ticks. The JSON Array Format is used because
+ * viewers open it even without its closing bracket, a killed Controller still leaves a readable Trace
+ *
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdbool.h>
+
+ /*    Include Header    */
+#include"chrome_trace.h"
+
+ /*    Include Modules    */
+#include"../event_ring/event_ring.h"
+#include"../scheduler/scheduler.h"
+#include"../switches/switch.h"
+
+/** @brief Event Ring Records read at once */
+#define CHROME_TRACE_RECORDS    64
+
+/** @brief Trace File & its write buffer */
+static FILE* TRACE_FILE;
+static char BUFFER[CHROME_TRACE_BUFFER_SIZE];
+static size_t USED;
+static bool WRITE_OK;
+
+/** @brief Time of ChromeTrace_Open() & length of a time unit */
+static uint64_t ORIGIN;
+static double NS_PER_UNIT;
+
+/** @brief Event Ring Records already traced */
+static uint32_t CURSOR;
+
+/** @brief Switch edges waiting for a Motor Angle change */
+static uint64_t EDGE_TIME[3];
+static bool EDGE_PENDING[3];
+static long LAST_ANGLE;
+
+
+/** @brief Write buffer to Trace File
+ * @param void
+ * @return void
+ */
+static void ChromeTrace_Flush(void){
+    if(USED != 0 && fwrite(BUFFER, 1, USED, TRACE_FILE) != USED){
+        WRITE_OK = false;
+    }
+    USED = 0;
+}
+
+
+/** @brief Format text at the end of the buffer, the buffer is written first if the text doesn't fit
+ * @param FORMAT const char* printf format
+ * @return void
+ */
+static void ChromeTrace_Append(const char* FORMAT, ...){
+    va_list Args;
+    int Len;
+
+    va_start(Args, FORMAT);
+    Len = vsnprintf(BUFFER + USED, sizeof(BUFFER) - USED, FORMAT, Args);
+    va_end(Args);
+
+    if(Len < 0){
+        WRITE_OK = false;
+        return;
+    }
+    if((size_t)Len >= sizeof(BUFFER) - USED){
+        ChromeTrace_Flush();
+        va_start(Args, FORMAT);
+        Len = vsnprintf(BUFFER, sizeof(BUFFER), FORMAT, Args);
+        va_end(Args);
+        if(Len < 0 || (size_t)Len >= sizeof(BUFFER)){
+            WRITE_OK = false;
+            return;
+        }
+    }
+    USED += (size_t)Len;
+}
+
+
+/** @brief Trace time of a time, printed as us with "%llu.%03u" (integers format much faster than doubles)
+ * @param TIME uint64_t Time (EventRing_Now() units)
+ * @return uint64_t ns since ChromeTrace_Open()
+ */
+static uint64_t ChromeTrace_Ns(uint64_t TIME){
+    return (TIME > ORIGIN) ? (uint64_t)((double)(TIME - ORIGIN) * NS_PER_UNIT) : 0;
+}
+
+#define CHROME_TRACE_US(NS)     (unsigned long long)((NS) / 1000u), (unsigned int)((NS) % 1000u)
+
+
+bool ChromeTrace_Open(const char* PATH){
+    static const char* const TRACKS[] = {"", "Control Loop", "Events", "Edge to Motor Angle"};
+    unsigned int i;
+
+    if(TRACE_FILE != NULL){
+        ChromeTrace_Close();
+    }
+    TRACE_FILE = fopen(PATH, "wb");
+    if(TRACE_FILE == NULL){
+        return false;
+    }
+
+    NS_PER_UNIT = EventRing_NsPerUnit();
+    ORIGIN = EventRing_Now();
+    USED = 0;
+    WRITE_OK = true;
+    CURSOR = 0;
+    LAST_ANGLE = -1;
+    for(i = 0; i < 3; i++){
+        EDGE_PENDING[i] = false;
+    }
+
+    ChromeTrace_Append("[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"speedcontrol\"}}");
+    for(i = CHROME_TRACE_LOOP_TRACK; i <= CHROME_TRACE_LATENCY_TRACK; i++){
+        ChromeTrace_Append(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", i, TRACKS[i]);
+    }
+    return true;
+}
+
+
+void ChromeTrace_Task(unsigned int TASK, uint64_t START, uint64_t END){
+    const SchedTask_t* Task = Sched_Task(TASK);
+    uint64_t Start = ChromeTrace_Ns(START);
+
+    if(TRACE_FILE == NULL){
+        return;
+    }
+    ChromeTrace_Append(",\n{\"name\":\"%s\",\"cat\":\"task\",\"ph\":\"X\",\"ts\":%llu.%03u,\"dur\":%llu.%03u,\"pid\":1,\"tid\":%d}",
+                       (Task != NULL) ? Task->Name : "?", CHROME_TRACE_US(Start), CHROME_TRACE_US(ChromeTrace_Ns(END) - Start),
+                       CHROME_TRACE_LOOP_TRACK);
+}
+
+
+/** @brief Add an Event Ring Record, and the edge to Motor Angle spans it ends
+ * @param RECORD const EventRecord_t* Record
+ * @return void
+ */
+static void ChromeTrace_Record(const EventRecord_t* RECORD){
+    static const char* const SWITCHES[] = {"+ve", "-ve", "P"};
+    char Text[64];
+    uint64_t Ts = ChromeTrace_Ns(RECORD->Time);
+    uint64_t Edge;
+    unsigned int Sw;
+
+    EventRing_Describe(RECORD, Text, sizeof(Text));
+    ChromeTrace_Append(",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%d,\"args\":{\"seq\":%lu}}",
+                       Text, EventRing_IdName(RECORD->Id), CHROME_TRACE_US(Ts), CHROME_TRACE_EVENT_TRACK, (unsigned long)(RECORD->Seq - 1));
+
+    switch(RECORD->Id){
+    case EVENT_SWITCH_STATE:
+        Sw = RECORD->Arg % 3;
+        if((RECORD->Payload & 0xFF) == PREPRESSED && !EDGE_PENDING[Sw]){
+            EDGE_TIME[Sw] = RECORD->Time;
+            EDGE_PENDING[Sw] = true;
+
+        }else if((RECORD->Payload & 0xFF) == RELEASED){
+            EDGE_PENDING[Sw] = false;
+        }
+        break;
+
+    case EVENT_MOTOR_ANGLE:
+        if(LAST_ANGLE >= 0 && (long)RECORD->Payload != LAST_ANGLE){
+            for(Sw = 0; Sw < 3; Sw++){
+                if(EDGE_PENDING[Sw]){
+                    Edge = ChromeTrace_Ns(EDGE_TIME[Sw]);
+                    ChromeTrace_Append(",\n{\"name\":\"%s edge -> %lu degrees\",\"cat\":\"latency\",\"ph\":\"X\",\"ts\":%llu.%03u,\"dur\":%llu.%03u,\"pid\":1,\"tid\":%d}",
+                                       SWITCHES[Sw], (unsigned long)RECORD->Payload, CHROME_TRACE_US(Edge),
+                                       CHROME_TRACE_US(Ts - Edge), CHROME_TRACE_LATENCY_TRACK);
+                    EDGE_PENDING[Sw] = false;
+                }
+            }
+        }
+        LAST_ANGLE = (long)RECORD->Payload;
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void ChromeTrace_Tick(unsigned long TICK, uint64_t START, uint64_t END){
+    EventRecord_t Records[CHROME_TRACE_RECORDS];
+    unsigned int Count, i;
+    uint32_t Before;
+    uint64_t Start = ChromeTrace_Ns(START);
+
+    if(TRACE_FILE == NULL){
+        return;
+    }
+    ChromeTrace_Append(",\n{\"name\":\"tick\",\"cat\":\"tick\",\"ph\":\"X\",\"ts\":%llu.%03u,\"dur\":%llu.%03u,\"pid\":1,\"tid\":%d,\"args\":{\"tick\":%lu}}",
+                       CHROME_TRACE_US(Start), CHROME_TRACE_US(ChromeTrace_Ns(END) - Start), CHROME_TRACE_LOOP_TRACK, TICK);
+
+    do{
+        Before = CURSOR;
+        Count = EventRing_ReadFrom(&CURSOR, Records, CHROME_TRACE_RECORDS);
+        for(i = 0; i < Count; i++){
+            /* Records from before the Trace started are left out */
+            if(Records[i].Time >= ORIGIN){
+                ChromeTrace_Record(&Records[i]);
+            }
+        }
+    }while(CURSOR != Before);
+}
+
+
+bool ChromeTrace_Close(void){
+    bool Ok;
+
+    if(TRACE_FILE == NULL){
+        return false;
+    }
+    ChromeTrace_Append("\n]\n");
+    ChromeTrace_Flush();
+    Ok = WRITE_OK;
+    Ok = (fclose(TRACE_FILE) == 0) && Ok;
+    TRACE_FILE = NULL;
+    return Ok;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file chrome_trace.h
+ * @brief Chrome Trace header file
+ */
+
+#ifndef CHROME_TRACE_H_INCLUDED
+#define CHROME_TRACE_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Trace Events are formatted here and written when it is full */
+#ifndef CHROME_TRACE_BUFFER_SIZE
+#define CHROME_TRACE_BUFFER_SIZE    (64 * 1024)
+#endif
+
+/** @brief Trace viewer tracks (tid) */
+#define CHROME_TRACE_LOOP_TRACK     1
+#define CHROME_TRACE_EVENT_TRACK    2
+#define CHROME_TRACE_LATENCY_TRACK  3
+
+
+/** @brief Create Trace File in Chrome trace-event JSON Array Format (chrome://tracing, ui.perfetto.dev)
+ * and start tracing. Times are counted from now
+ * @param PATH const char* Trace File path
+ * @return bool true if Trace File is created & false if not
+ */
+bool ChromeTrace_Open(const char* PATH);
+
+
+/** @brief Add a Task span to the Control Loop track, same signature as Sched_OnTask
+ * @param TASK unsigned int Task index in Scheduler run order
+ * @param START uint64_t Start time (EventRing_Now() units)
+ * @param END uint64_t End time (EventRing_Now() units)
+ * @return void
+ */
+void ChromeTrace_Task(unsigned int TASK, uint64_t START, uint64_t END);
+
+
+/** @brief Add a tick span to the Control Loop track, then add the Event Ring Records of the tick
+ * (Switch, Speed & Motor Events) and button edge to Motor Angle change spans, same signature as Sched_OnTick
+ * @param TICK unsigned long Tick number
+ * @param START uint64_t Start time (EventRing_Now() units)
+ * @param END uint64_t End time (EventRing_Now() units)
+ * @return void
+ */
+void ChromeTrace_Tick(unsigned long TICK, uint64_t START, uint64_t END);
+
+
+/** @brief Write what is left and close Trace File. A Trace cut before it is closed still opens in the viewers
+ * @param void
+ * @return bool true if all Trace Events reached the File & false if not
+ */
+bool ChromeTrace_Close(void);
+
+#endif // CHROME_TRACE_H_INCLUDED
@@ -0,0 +1,463 @@
+/**
+ * @file command.c
+ * @brief Command Socket main file
+ * @details Here we let host test rigs drive a running Controller through a local UNIX socket instead of
+ * writing switch.txt & polling motor.txt. Commands push virtual Switches through the Get_SWLevel seam, so they go
+ * through the same debounce & Speed rules as real buttons. <br>
+ * The socket is polled once every tick with epoll (no waiting): all clients ready in this tick are read (at most
+ * COMMAND_READ_MAX bytes each), complete lines are executed while their replies fit in the client's output and the
+ * replies of one client are written with one send(). Lines left are executed on next ticks as replies are sent,
+ * a client not reading any reply for COMMAND_STALL_TICKS is closed, so the tick is never stalled by a client
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#endif
+
+ /*    Include Header    */
+#include"command.h"
+
+ /*    Include Modules    */
+#include"../speedcontrol/speedcontrol.h"
+#include"../scheduler/scheduler.h"
+
+/** @brief A virtual Switch: ticks left pushed or released & queued presses & holds (in ticks) */
+typedef struct {
+    unsigned long Queue[COMMAND_QUEUE];
+    unsigned int Head;
+    unsigned int Count;
+    unsigned long Hold;
+    unsigned int Gap;
+} VirtualSwitch_t;
+
+static VirtualSwitch_t SWITCHES[3];
+static CommandStats_t STATS;
+
+
+/** @brief Queue a press or hold on a virtual Switch
+ * @param SW Switch_t Which Switch
+ * @param TICKS unsigned long Ticks to push it
+ * @return bool true if queued & false if queue is full
+ */
+static bool Command_Push(Switch_t SW, unsigned long TICKS){
+    VirtualSwitch_t* Virtual = &SWITCHES[SW];
+
+    if(Virtual->Count == COMMAND_QUEUE){
+        return false;
+    }
+    Virtual->Queue[(Virtual->Head + Virtual->Count) % COMMAND_QUEUE] = TICKS;
+    Virtual->Count++;
+    return true;
+}
+
+
+/** @brief Get Switch from its Command name
+ * @param NAME const char* "+ve", "-ve" or "p"
+ * @param SW Switch_t* Switch
+ * @return bool true if NAME is a Switch & false if not
+ */
+static bool Command_Switch(const char* NAME, Switch_t* SW){
+    if(strcmp(NAME, "+ve") == 0){
+        *SW = POSTIVE;
+    }else if(strcmp(NAME, "-ve") == 0){
+        *SW = NEGATIVE;
+    }else if(strcmp(NAME, "p") == 0 || strcmp(NAME, "P") == 0){
+        *SW = P;
+    }else{
+        return false;
+    }
+    return true;
+}
+
+
+bool Command_Execute(const char* LINE, char* REPLY, size_t SIZE){
+    static const char* const SPEEDS[] = {"MIN", "MED", "MAX"};
+    char Copy[COMMAND_LINE_MAX];
+    char* Words[4];
+    char* Word;
+    unsigned int Count = 0;
+    SpeedController_t Ctl;
+    unsigned long Ms;
+    char* End;
+    Switch_t Sw;
+    const char* Error = NULL;
+
+    if(strlen(LINE) >= sizeof(Copy)){
+        Error = "line too long";
+    }else{
+        strcpy(Copy, LINE);
+        for(Word = strtok(Copy, " \t"); Word != NULL; Word = strtok(NULL, " \t")){
+            if(Count == 4){
+                /* Too many words, no Command has them */
+                Count++;
+                break;
+            }
+            Words[Count++] = Word;
+        }
+    }
+
+    if(Error != NULL){
+        /* Already known */
+    }else if(Count == 2 && strcmp(Words[0], "press") == 0 && Command_Switch(Words[1], &Sw)){
+        if(!Command_Push(Sw, COMMAND_PRESS_TICKS)){
+            Error = "queue full";
+        }
+    }else if(Count == 4 && strcmp(Words[0], "hold") == 0 && Command_Switch(Words[1], &Sw) && strcmp(Words[3], "ms") == 0){
+        Ms = strtoul(Words[2], &End, 10);
+        if(*End != '\0' || Ms == 0){
+            Error = "bad time";
+        }else if(!Command_Push(Sw, Ms / SW_TICK_MS + ((Ms % SW_TICK_MS) != 0))){
+            Error = "queue full";
+        }
+    }else if(Count == 2 && strcmp(Words[0], "get") == 0 && strcmp(Words[1], "speed") == 0){
+        Ctl.Speed = Speed_Get();
+        STATS.Commands++;
+        snprintf(REPLY, SIZE, "%s %d", SPEEDS[Ctl.Speed], SpeedCtl_Angle(&Ctl));
+        return true;
+    }else if(Count == 2 && strcmp(Words[0], "get") == 0 && strcmp(Words[1], "stats") == 0){
+        STATS.Commands++;
+        snprintf(REPLY, SIZE, "ticks %lu overruns %lu speed %s commands %lu errors %lu clients %lu",
+                 Sched_Ticks(), Sched_Overruns(), SPEEDS[Speed_Get()], STATS.Commands, STATS.Errors, STATS.Clients);
+        return true;
+    }else{
+        Error = "unknown command";
+    }
+
+    if(Error != NULL){
+        snprintf(REPLY, SIZE, "error %s", Error);
+        STATS.Errors++;
+        return false;
+    }
+    snprintf(REPLY, SIZE, "ok");
+    STATS.Commands++;
+    return true;
+}
+
+
+void Command_Step(void){
+    VirtualSwitch_t* Virtual;
+    unsigned int Sw;
+
+    for(Sw = 0; Sw < 3; Sw++){
+        Virtual = &SWITCHES[Sw];
+        if(Virtual->Hold > 0){
+            if(--Virtual->Hold == 0){
+                Virtual->Gap = COMMAND_RELEASE_TICKS;
+            }
+        }else if(Virtual->Gap > 0){
+            Virtual->Gap--;
+        }
+
+        if(Virtual->Hold == 0 && Virtual->Gap == 0 && Virtual->Count != 0){
+            Virtual->Hold = Virtual->Queue[Virtual->Head];
+            Virtual->Head = (Virtual->Head + 1) % COMMAND_QUEUE;
+            Virtual->Count--;
+        }
+    }
+}
+
+
+bool Command_Level(Switch_t SW){
+    return !IsOutOfBounds(SW) && SWITCHES[SW].Hold > 0;
+}
+
+
+void Command_Stats(CommandStats_t* STATS_OUT){
+    *STATS_OUT = STATS;
+}
+
+
+void Command_Reset(void){
+    memset(SWITCHES, 0, sizeof(SWITCHES));
+    memset(&STATS, 0, sizeof(STATS));
+}
+
+
+#ifdef __linux__
+
+/** @brief A connected client: bytes read but not executed, its partial Command line & replies not sent yet */
+typedef struct {
+    int Fd;
+    char Pending[COMMAND_READ_MAX];
+    size_t PendingUsed;
+    char In[COMMAND_LINE_MAX];
+    size_t InUsed;
+    bool TooLong;
+    char Out[COMMAND_OUT_MAX];
+    size_t OutUsed;
+    unsigned int Stalled;
+} CommandClient_t;
+
+/** @brief Longest reply line, a line is executed only when the client's output has room for it */
+#define COMMAND_REPLY_MAX   (COMMAND_LINE_MAX + 32)
+
+static CommandClient_t CLIENTS[COMMAND_MAX_CLIENTS];
+static int LISTEN_FD = -1;
+static int EPOLL_FD = -1;
+static char SOCKET_PATH[sizeof(((struct sockaddr_un*)0)->sun_path)];
+
+/** @brief epoll data of the listening socket, clients have their index */
+#define COMMAND_LISTENER    COMMAND_MAX_CLIENTS
+
+
+/** @brief Close a client
+ * @param CLIENT CommandClient_t* Client
+ * @return void
+ */
+static void Command_Drop(CommandClient_t* CLIENT){
+    epoll_ctl(EPOLL_FD, EPOLL_CTL_DEL, CLIENT->Fd, NULL);
+    close(CLIENT->Fd);
+    CLIENT->Fd = -1;
+}
+
+
+/** @brief Accept all waiting clients, clients over COMMAND_MAX_CLIENTS are closed at once
+ * @param void
+ * @return void
+ */
+static void Command_Accept(void){
+    struct epoll_event Event;
+    unsigned int i;
+    int Fd;
+
+    while((Fd = accept(LISTEN_FD, NULL, NULL)) >= 0){
+        for(i = 0; i < COMMAND_MAX_CLIENTS && CLIENTS[i].Fd >= 0; i++){
+        }
+        Event.events = EPOLLIN;
+        Event.data.u32 = i;
+        if(i == COMMAND_MAX_CLIENTS || epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, Fd, &Event) != 0){
+            close(Fd);
+            continue;
+        }
+        CLIENTS[i].Fd = Fd;
+        CLIENTS[i].PendingUsed = 0;
+        CLIENTS[i].InUsed = 0;
+        CLIENTS[i].TooLong = false;
+        CLIENTS[i].OutUsed = 0;
+        CLIENTS[i].Stalled = 0;
+        STATS.Clients++;
+    }
+}
+
+
+/** @brief Add a reply line for a client, the caller checked there is room for COMMAND_REPLY_MAX bytes
+ * @param CLIENT CommandClient_t* Client
+ * @param REPLY const char* Reply, without line end
+ * @return void
+ */
+static void Command_Reply(CommandClient_t* CLIENT, const char* REPLY){
+    size_t Len = strlen(REPLY);
+
+    memcpy(CLIENT->Out + CLIENT->OutUsed, REPLY, Len);
+    CLIENT->Out[CLIENT->OutUsed + Len] = '\n';
+    CLIENT->OutUsed += Len + 1;
+}
+
+
+/** @brief Execute the complete lines a client sent while their replies fit in its output, the rest is kept
+ * for next ticks
+ * @param CLIENT CommandClient_t* Client
+ * @return void
+ */
+static void Command_Parse(CommandClient_t* CLIENT){
+    char Reply[COMMAND_REPLY_MAX];
+    size_t i;
+
+    for(i = 0; i < CLIENT->PendingUsed; i++){
+        if(CLIENT->Pending[i] == '\n'){
+            if(sizeof(CLIENT->Out) - CLIENT->OutUsed < sizeof(Reply) + 1){
+                /* No room for the reply, the line is executed once replies are sent */
+                break;
+            }
+            if(CLIENT->InUsed > 0 && CLIENT->In[CLIENT->InUsed - 1] == '\r'){
+                CLIENT->InUsed--;
+            }
+            CLIENT->In[CLIENT->InUsed] = '\0';
+            if(CLIENT->TooLong){
+                snprintf(Reply, sizeof(Reply), "error line too long");
+                STATS.Errors++;
+            }else if(CLIENT->InUsed == 0){
+                continue;
+            }else{
+                Command_Execute(CLIENT->In, Reply, sizeof(Reply));
+            }
+            CLIENT->InUsed = 0;
+            CLIENT->TooLong = false;
+            Command_Reply(CLIENT, Reply);
+
+        }else if(CLIENT->InUsed < sizeof(CLIENT->In) - 1){
+            CLIENT->In[CLIENT->InUsed++] = CLIENT->Pending[i];
+        }else{
+            CLIENT->TooLong = true;
+        }
+    }
+    memmove(CLIENT->Pending, CLIENT->Pending + i, CLIENT->PendingUsed - i);
+    CLIENT->PendingUsed -= i;
+}
+
+
+/** @brief Read what a client sent, as much as there is room for next to the lines not executed yet
+ * (at most COMMAND_READ_MAX bytes), and execute it
+ * @param CLIENT CommandClient_t* Client
+ * @return void
+ */
+static void Command_Read(CommandClient_t* CLIENT){
+    ssize_t Got;
+
+    if(CLIENT->PendingUsed < sizeof(CLIENT->Pending)){
+        Got = recv(CLIENT->Fd, CLIENT->Pending + CLIENT->PendingUsed, sizeof(CLIENT->Pending) - CLIENT->PendingUsed, MSG_DONTWAIT);
+        if(Got == 0 || (Got < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)){
+            Command_Drop(CLIENT);
+            return;
+        }
+        if(Got > 0){
+            CLIENT->PendingUsed += (size_t)Got;
+        }
+    }
+    Command_Parse(CLIENT);
+}
+
+
+/** @brief Send replies of a client, what the socket doesn't take now is sent on next ticks. A client taking
+ * nothing for COMMAND_STALL_TICKS is closed
+ * @param CLIENT CommandClient_t* Client
+ * @return void
+ */
+static void Command_Send(CommandClient_t* CLIENT){
+    ssize_t Sent = send(CLIENT->Fd, CLIENT->Out, CLIENT->OutUsed, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+    if(Sent < 0){
+        if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR){
+            Command_Drop(CLIENT);
+        }else if(++CLIENT->Stalled >= COMMAND_STALL_TICKS){
+            STATS.Dropped++;
+            Command_Drop(CLIENT);
+        }
+        return;
+    }
+    CLIENT->Stalled = 0;
+    memmove(CLIENT->Out, CLIENT->Out + Sent, CLIENT->OutUsed - (size_t)Sent);
+    CLIENT->OutUsed -= (size_t)Sent;
+}
+
+
+bool Command_Open(const char* PATH){
+    struct sockaddr_un Address;
+    struct epoll_event Event;
+    unsigned int i;
+
+    if(strlen(PATH) >= sizeof(Address.sun_path)){
+        return false;
+    }
+    if(LISTEN_FD >= 0){
+        Command_Close();
+    }
+    Command_Reset();
+    for(i = 0; i < COMMAND_MAX_CLIENTS; i++){
+        CLIENTS[i].Fd = -1;
+    }
+
+    memset(&Address, 0, sizeof(Address));
+    Address.sun_family = AF_UNIX;
+    strcpy(Address.sun_path, PATH);
+    unlink(PATH);
+
+    LISTEN_FD = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    EPOLL_FD = epoll_create1(EPOLL_CLOEXEC);
+    Event.events = EPOLLIN;
+    Event.data.u32 = COMMAND_LISTENER;
+    if(LISTEN_FD < 0 || EPOLL_FD < 0 ||
+       bind(LISTEN_FD, (struct sockaddr*)&Address, sizeof(Address)) != 0 ||
+       listen(LISTEN_FD, COMMAND_MAX_CLIENTS) != 0 ||
+       epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, LISTEN_FD, &Event) != 0){
+        Command_Close();
+        return false;
+    }
+    strcpy(SOCKET_PATH, PATH);
+    Get_SWLevel = Command_Level;
+    return true;
+}
+
+
+void Command_Poll(void){
+    struct epoll_event Events[COMMAND_MAX_CLIENTS + 1];
+    int Ready, i;
+
+    if(EPOLL_FD >= 0){
+        Ready = epoll_wait(EPOLL_FD, Events, COMMAND_MAX_CLIENTS + 1, 0);
+        for(i = 0; i < Ready; i++){
+            if(Events[i].data.u32 == COMMAND_LISTENER){
+                Command_Accept();
+            }else if(CLIENTS[Events[i].data.u32].Fd >= 0){
+                Command_Read(&CLIENTS[Events[i].data.u32]);
+            }
+        }
+        for(i = 0; i < COMMAND_MAX_CLIENTS; i++){
+            if(CLIENTS[i].Fd >= 0 && CLIENTS[i].PendingUsed != 0){
+                /* Lines left by the last ticks, their replies may fit now */
+                Command_Parse(&CLIENTS[i]);
+            }
+            if(CLIENTS[i].Fd >= 0 && CLIENTS[i].OutUsed != 0){
+                Command_Send(&CLIENTS[i]);
+            }
+        }
+    }
+    Command_Step();
+}
+
+
+void Command_Close(void){
+    unsigned int i;
+
+    for(i = 0; i < COMMAND_MAX_CLIENTS; i++){
+        if(CLIENTS[i].Fd >= 0 && EPOLL_FD >= 0){
+            Command_Drop(&CLIENTS[i]);
+        }
+    }
+    if(LISTEN_FD >= 0){
+        close(LISTEN_FD);
+        LISTEN_FD = -1;
+    }
+    if(EPOLL_FD >= 0){
+        close(EPOLL_FD);
+        EPOLL_FD = -1;
+    }
+    if(SOCKET_PATH[0] != '\0'){
+        unlink(SOCKET_PATH);
+        SOCKET_PATH[0] = '\0';
+    }
+    if(Get_SWLevel == Command_Level){
+        Get_SWLevel = Get_RealSW_Level;
+    }
+}
+
+#else
+
+bool Command_Open(const char* PATH){
+    /* epoll & UNIX sockets, Linux only */
+    (void)PATH;
+    return false;
+}
+
+
+void Command_Poll(void){
+    Command_Step();
+}
+
+
+void Command_Close(void){
+    if(Get_SWLevel == Command_Level){
+        Get_SWLevel = Get_RealSW_Level;
+    }
+}
+
+#endif
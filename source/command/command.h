@@ -0,0 +1,111 @@
+/**
+ * @file command.h
+ * @brief Command Socket header file
+ */
+
+#ifndef COMMAND_H_INCLUDED
+#define COMMAND_H_INCLUDED
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include"../switches/switch.h"
+
+/** @brief Most clients connected at once, more are refused */
+#define COMMAND_MAX_CLIENTS     64
+
+/** @brief Longest Command line, a longer line is answered with an error and dropped */
+#define COMMAND_LINE_MAX        128
+
+/** @brief Replies waiting for a slow client, Commands are not executed while there is no room for their reply */
+#define COMMAND_OUT_MAX         4096
+
+/** @brief Ticks a client may keep replies without reading any of them, then it is closed (1 s) */
+#define COMMAND_STALL_TICKS     50
+
+/** @brief Bytes read from one client in one tick, so a busy client never stalls the tick. Lines not executed
+ * yet are kept & more is read only when there is room */
+#define COMMAND_READ_MAX        1024
+
+/** @brief A press pushes the Switch for 2 ticks (PRE_PRESSED then PRESSED), a Switch is released
+ * 2 ticks (PRE_RELEASED then RELEASED) before its next queued press or hold */
+#define COMMAND_PRESS_TICKS     2
+#define COMMAND_RELEASE_TICKS   2
+
+/** @brief Presses & holds queued per Switch */
+#define COMMAND_QUEUE           16
+
+/** @brief Counters of the Command Socket */
+typedef struct {
+    unsigned long Commands;         /* Commands executed */
+    unsigned long Errors;           /* Bad Commands */
+    unsigned long Clients;          /* Clients connected */
+    unsigned long Dropped;          /* Clients closed for not reading their replies for COMMAND_STALL_TICKS */
+} CommandStats_t;
+
+
+/** @brief Listen for Commands on a UNIX socket and drive the Switches from them: Get_SWLevel is set to Command_Level().
+ * Commands are text lines, every line gets one reply line ("ok", a value or "error ..."): <br>
+ * press +ve | press -ve | press p          push a Switch for COMMAND_PRESS_TICKS <br>
+ * hold +ve|-ve|p N ms                      push a Switch for N ms (e.g. hold p 31000 ms for a P long press) <br>
+ * get speed                                "MIN|MED|MAX ANGLE" <br>
+ * get stats                                ticks, overruns, Speed & Command counters
+ * @param PATH const char* Socket path, an old socket there is removed
+ * @return bool true if socket is listening & false if not (or not on Linux)
+ */
+bool Command_Open(const char* PATH);
+
+
+/** @brief Accept clients, read & execute every complete Command line they sent, write all replies of this tick at once,
+ * then move the virtual Switches one tick. Never blocks, call it once every tick before the Switches are updated
+ * (it is a Scheduler Task in main.c)
+ * @param void
+ * @return void
+ */
+void Command_Poll(void);
+
+
+/** @brief Execute one Command line
+ * @param LINE const char* Command, without line end
+ * @param REPLY char* Reply, without line end
+ * @param SIZE size_t Size of REPLY
+ * @return bool true if Command is executed & false if it is bad
+ */
+bool Command_Execute(const char* LINE, char* REPLY, size_t SIZE);
+
+
+/** @brief Move the virtual Switches one tick: end or start presses & holds (Command_Poll() calls it)
+ * @param void
+ * @return void
+ */
+void Command_Step(void);
+
+
+/** @brief Level of a virtual Switch, same signature as Get_SWLevel
+ * @param SW Switch_t Which Switch
+ * @return bool true while a press or hold pushes the Switch & false if not
+ */
+bool Command_Level(Switch_t SW);
+
+
+/** @brief Get Command Socket counters
+ * @param STATS_OUT CommandStats_t* Counters
+ * @return void
+ */
+void Command_Stats(CommandStats_t* STATS_OUT);
+
+
+/** @brief Release virtual Switches, drop queued presses & holds and clear counters
+ * @param void
+ * @return void
+ */
+void Command_Reset(void);
+
+
+/** @brief Close clients & socket and remove socket path
+ * @param void
+ * @return void
+ */
+void Command_Close(void);
+
+#endif // COMMAND_H_INCLUDED
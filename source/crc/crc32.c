@@ -0,0 +1,25 @@
+/**
+ * @file crc32.c
+ * @brief CRC-32 main file
+ * @details Here we check stored Records with a bitwise CRC-32, Records are a few bytes and written rarely
+ * so a table isn't worth its 1 KiB
+ *
+ */
+
+ /*    Include Header    */
+#include"crc32.h"
+
+
+uint32_t Crc32(const void* DATA, size_t LEN){
+    const uint8_t* Byte = DATA;
+    uint32_t Crc = 0xFFFFFFFFu;
+    unsigned int Bit;
+
+    while(LEN-- != 0){
+        Crc ^= *Byte++;
+        for(Bit = 0; Bit < 8; Bit++){
+            Crc = (Crc >> 1) ^ (0xEDB88320u & (0u - (Crc & 1u)));
+        }
+    }
+    return ~Crc;
+}
@@ -0,0 +1,20 @@
+/**
+ * @file crc32.h
+ * @brief CRC-32 header file
+ */
+
+#ifndef CRC32_H_INCLUDED
+#define CRC32_H_INCLUDED
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/** @brief CRC-32 (IEEE 802.3, same as zlib) of some bytes
+ * @param DATA const void* Bytes
+ * @param LEN size_t Number of bytes
+ * @return uint32_t CRC
+ */
+uint32_t Crc32(const void* DATA, size_t LEN);
+
+#endif // CRC32_H_INCLUDED
@@ -0,0 +1,330 @@
+/**
+ * @file event_ring.c
+ * @brief Event Ring main file
+ * @details Here we keep the last EVENT_RING_SIZE Events (Switch State changes, Speed changes & Motor Angle writes)
+ * in a static ring. The Control Loop is the only writer: it marks the Slot as being written, fills it,
+ * then publishes its Seq and the new Head, so recording is a few stores and no lock or atomic read-modify-write. <br>
+ * Records are stamped with the time set by EventRing_SetTime() (start of the tick or Task which added them),
+ * the clock is read by the Scheduler and not on every Record. <br>
+ * Readers (Snapshot, Raw Dump from a crash handler) check Seq before & after copying a Slot and
+ * leave out Slots overwritten meanwhile
+ *
+ */
+
+#include <string.h>
+#include <stdatomic.h>
+#include <signal.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#define EVENT_RING_WRITE(FD, BUF, LEN)     _write(FD, BUF, (unsigned int)(LEN))
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#define EVENT_RING_WRITE(FD, BUF, LEN)     write(FD, BUF, LEN)
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+ /*    Include Header    */
+#include"event_ring.h"
+
+#define EVENT_RING_MASK     (EVENT_RING_SIZE - 1)
+
+/** @brief One Slot, same layout as EventRecord_t so Raw Dump is the Slots themselves */
+typedef struct {
+    uint64_t Time;
+    atomic_uint_least32_t Seq;
+    uint16_t Id;
+    uint16_t Arg;
+    uint32_t Payload;
+    uint32_t Reserved;
+} EventSlot_t;
+
+_Static_assert(sizeof(EventSlot_t) == sizeof(EventRecord_t), "Event Slot & Record layouts differ");
+_Static_assert((EVENT_RING_SIZE & EVENT_RING_MASK) == 0, "EVENT_RING_SIZE must be a power of 2");
+
+/** @brief Records & number of Records ever added */
+static EventSlot_t SLOTS[EVENT_RING_SIZE];
+static atomic_uint_least32_t HEAD;
+
+/** @brief Time of next Records */
+static uint64_t RECORD_TIME;
+
+/** @brief Crash Dump File */
+static const char* CRASH_PATH;
+
+/** @brief Event names for text Dump */
+static const char* const EVENT_NAMES[] = {"?", "SWITCH", "SPEED", "MOTOR"};
+
+
+/** @brief Current monotonic time
+ * @param void
+ * @return uint64_t Time in ns
+ */
+static uint64_t EventRing_MonotonicNs(void){
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return (uint64_t)Now.tv_sec * 1000000000u + (uint64_t)Now.tv_nsec;
+}
+
+
+/* A cycle counter is used where there's one because it costs a few cycles only */
+uint64_t EventRing_Now(void){
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return EventRing_MonotonicNs();
+#endif
+}
+
+
+double EventRing_NsPerUnit(void){
+#if defined(__x86_64__) || defined(__i386__)
+    static double NS_PER_CYCLE;
+    uint64_t StartNs, EndNs, StartCycles;
+
+    /* Cycles are counted over 10 ms once, not on the hot path */
+    if(NS_PER_CYCLE == 0){
+        StartNs = EventRing_MonotonicNs();
+        StartCycles = __rdtsc();
+        do{
+            EndNs = EventRing_MonotonicNs();
+        }while(EndNs - StartNs < 10000000u);
+        NS_PER_CYCLE = (double)(EndNs - StartNs) / (double)(__rdtsc() - StartCycles);
+    }
+    return NS_PER_CYCLE;
+#else
+    return 1.0;
+#endif
+}
+
+
+EventTimeUnit_t EventRing_TimeUnit(void){
+#if defined(__x86_64__) || defined(__i386__)
+    return EVENT_TIME_CYCLES;
+#else
+    return EVENT_TIME_NS;
+#endif
+}
+
+
+void EventRing_Record(EventId_t ID, unsigned short ARG, unsigned long PAYLOAD){
+    uint32_t Head = atomic_load_explicit(&HEAD, memory_order_relaxed);
+    EventSlot_t* Slot = &SLOTS[Head & EVENT_RING_MASK];
+
+    /* Readers see 0 and skip the Slot till it is whole again */
+    atomic_store_explicit(&Slot->Seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    Slot->Time = RECORD_TIME;
+    Slot->Id = (uint16_t)ID;
+    Slot->Arg = ARG;
+    Slot->Payload = (uint32_t)PAYLOAD;
+
+    atomic_store_explicit(&Slot->Seq, Head + 1, memory_order_release);
+    atomic_store_explicit(&HEAD, Head + 1, memory_order_release);
+}
+
+
+void EventRing_SetTime(uint64_t TIME){
+    RECORD_TIME = TIME;
+}
+
+
+void EventRing_Reset(void){
+    unsigned int i;
+
+    RECORD_TIME = EventRing_Now();
+
+    for(i = 0; i < EVENT_RING_SIZE; i++){
+        atomic_store_explicit(&SLOTS[i].Seq, 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&HEAD, 0, memory_order_release);
+}
+
+
+/** @brief Copy Records from FIRST to before LAST in order, Records being written or overwritten are left out
+ * @param FIRST uint32_t Number of first Record
+ * @param LAST uint32_t Number after last Record
+ * @param OUT EventRecord_t* Where to copy
+ * @return unsigned int Number of Records copied
+ */
+static unsigned int EventRing_Copy(uint32_t FIRST, uint32_t LAST, EventRecord_t* OUT){
+    uint32_t Seq, i;
+    const EventSlot_t* Slot;
+    unsigned int Count = 0;
+
+    for(i = FIRST; i != LAST; i++){
+        Slot = &SLOTS[i & EVENT_RING_MASK];
+        Seq = atomic_load_explicit(&Slot->Seq, memory_order_acquire);
+        if(Seq != i + 1){
+            continue;
+        }
+        OUT[Count].Time = Slot->Time;
+        OUT[Count].Id = Slot->Id;
+        OUT[Count].Arg = Slot->Arg;
+        OUT[Count].Payload = Slot->Payload;
+        OUT[Count].Reserved = 0;
+        OUT[Count].Seq = Seq;
+
+        /* Writer got here meanwhile, the copy may be mixed */
+        atomic_thread_fence(memory_order_acquire);
+        if(atomic_load_explicit(&Slot->Seq, memory_order_relaxed) == Seq){
+            Count++;
+        }
+    }
+    return Count;
+}
+
+
+unsigned int EventRing_Snapshot(EventRecord_t* OUT, unsigned int MAX){
+    uint32_t Head = atomic_load_explicit(&HEAD, memory_order_acquire);
+    uint32_t First = (Head > EVENT_RING_SIZE) ? Head - EVENT_RING_SIZE : 0;
+
+    if(Head - First > MAX){
+        First = Head - MAX;
+    }
+    return EventRing_Copy(First, Head, OUT);
+}
+
+
+unsigned int EventRing_ReadFrom(uint32_t* CURSOR, EventRecord_t* OUT, unsigned int MAX){
+    uint32_t Head = atomic_load_explicit(&HEAD, memory_order_acquire);
+    uint32_t First = *CURSOR;
+
+    /* Overwritten Records are lost, go on from the oldest kept one */
+    if(Head - First > EVENT_RING_SIZE){
+        First = Head - EVENT_RING_SIZE;
+    }
+    if(Head - First > MAX){
+        Head = First + MAX;
+    }
+    *CURSOR = Head;
+    return EventRing_Copy(First, Head, OUT);
+}
+
+
+const char* EventRing_IdName(unsigned int ID){
+    return EVENT_NAMES[ID < sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]) ? ID : 0];
+}
+
+
+void EventRing_Describe(const EventRecord_t* RECORD, char* TEXT, size_t SIZE){
+    static const char* const STATES[] = {"PRE_PRESSED", "PRESSED", "PRE_RELEASED", "RELEASED"};
+    static const char* const SWITCHES[] = {"+ve", "-ve", "P"};
+    static const char* const SPEEDS[] = {"MIN", "MED", "MAX"};
+
+    switch(RECORD->Id){
+    case EVENT_SWITCH_STATE:
+        if(RECORD->Arg == 2){
+            snprintf(TEXT, SIZE, "%s -> %s (press time %lu)", SWITCHES[2], STATES[(RECORD->Payload & 0xFF) % 4],
+                     (unsigned long)(RECORD->Payload >> 8));
+        }else{
+            snprintf(TEXT, SIZE, "%s -> %s", SWITCHES[RECORD->Arg % 3], STATES[(RECORD->Payload & 0xFF) % 4]);
+        }
+        break;
+    case EVENT_SPEED:
+        snprintf(TEXT, SIZE, "%s -> %s", SPEEDS[RECORD->Arg % 3], SPEEDS[RECORD->Payload % 3]);
+        break;
+    case EVENT_MOTOR_ANGLE:
+        snprintf(TEXT, SIZE, "%lu degrees", (unsigned long)RECORD->Payload);
+        break;
+    default:
+        snprintf(TEXT, SIZE, "arg %u payload %lu", RECORD->Arg, (unsigned long)RECORD->Payload);
+        break;
+    }
+}
+
+
+void EventRing_Print(FILE* OUT, const EventRecord_t* RECORDS, unsigned int COUNT){
+    char Text[64];
+    unsigned int i;
+
+    for(i = 0; i < COUNT; i++){
+        EventRing_Describe(&RECORDS[i], Text, sizeof(Text));
+        fprintf(OUT, "%10lu %20llu %-7s %s\n", (unsigned long)(RECORDS[i].Seq - 1), (unsigned long long)RECORDS[i].Time,
+                EventRing_IdName(RECORDS[i].Id), Text);
+    }
+}
+
+
+void EventRing_Dump(FILE* OUT){
+    static EventRecord_t Records[EVENT_RING_SIZE];
+    unsigned int Count = EventRing_Snapshot(Records, EVENT_RING_SIZE);
+
+    fprintf(OUT, "%u events, time in %s\n", Count, EventRing_TimeUnit() == EVENT_TIME_CYCLES ? "cycles" : "ns");
+    EventRing_Print(OUT, Records, Count);
+}
+
+
+bool EventRing_WriteRaw(int FD){
+    unsigned char Header[EVENT_RING_HEADER_SIZE] = {'E', 'V', 'R', 'G', EVENT_RING_VERSION, sizeof(EventRecord_t)};
+    uint32_t Count = EVENT_RING_SIZE;
+    const unsigned char* Data = (const unsigned char*)SLOTS;
+    size_t Left = sizeof(SLOTS);
+    long Written;
+
+    /* Slots are written as they are, Seq tells the decoder which are valid & their order */
+    Header[6] = (unsigned char)EventRing_TimeUnit();
+    memcpy(Header + 8, &Count, sizeof(Count));
+    if(EVENT_RING_WRITE(FD, Header, sizeof(Header)) != (long)sizeof(Header)){
+        return false;
+    }
+    while(Left != 0){
+        Written = (long)EVENT_RING_WRITE(FD, Data, Left);
+        if(Written <= 0){
+            return false;
+        }
+        Data += Written;
+        Left -= (size_t)Written;
+    }
+    return true;
+}
+
+
+/** @brief Crash handler, write Raw Dump then die by the same signal
+ * @param SIG int Signal number
+ * @return void
+ */
+static void EventRing_OnCrash(int SIG){
+#ifdef _WIN32
+    int Fd = _open(CRASH_PATH, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644);
+#else
+    int Fd = open(CRASH_PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+
+    if(Fd >= 0){
+        EventRing_WriteRaw(Fd);
+#ifdef _WIN32
+        _close(Fd);
+#else
+        close(Fd);
+#endif
+    }
+    signal(SIG, SIG_DFL);
+    raise(SIG);
+}
+
+
+bool EventRing_DumpOnCrash(const char* PATH){
+    static const int SIGNALS[] = {
+        SIGSEGV, SIGILL, SIGFPE, SIGABRT,
+#ifdef SIGBUS
+        SIGBUS,
+#endif
+    };
+    unsigned int i;
+    bool Ok = true;
+
+    CRASH_PATH = PATH;
+    for(i = 0; i < sizeof(SIGNALS) / sizeof(SIGNALS[0]); i++){
+        Ok = (signal(SIGNALS[i], EventRing_OnCrash) != SIG_ERR) && Ok;
+    }
+    return Ok;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file event_ring.h
+ * @brief Event Ring header file
+ */
+
+#ifndef EVENT_RING_H_INCLUDED
+#define EVENT_RING_H_INCLUDED
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Number of Records kept, must be a power of 2, oldest Record is overwritten */
+#ifndef EVENT_RING_SIZE
+#define EVENT_RING_SIZE         4096
+#endif
+
+/** @brief Raw Dump Header: "EVRG" | version | Record size | time unit | reserved | Record count (4 bytes) */
+#define EVENT_RING_MAGIC        "EVRG"
+#define EVENT_RING_VERSION      1
+#define EVENT_RING_HEADER_SIZE  12
+
+/** @brief A variable can assign the recorded Events */
+typedef enum {
+    EVENT_SWITCH_STATE = 1,     /* Arg: Switch, Payload: new State | P Press Time << 8 */
+    EVENT_SPEED,                /* Arg: old Speed, Payload: new Speed */
+    EVENT_MOTOR_ANGLE           /* Arg: Speed, Payload: written Angle */
+} EventId_t;
+
+/** @brief A variable can assign the time unit of Records */
+typedef enum {EVENT_TIME_NS, EVENT_TIME_CYCLES} EventTimeUnit_t;
+
+/** @brief One Record, 24 bytes. Seq is Record number + 1, it is 0 while the Record is written */
+typedef struct {
+    uint64_t Time;
+    uint32_t Seq;
+    uint16_t Id;
+    uint16_t Arg;
+    uint32_t Payload;
+    uint32_t Reserved;
+} EventRecord_t;
+
+
+/** @brief Add a Record, it never blocks nor allocates. One writer (the Control Loop) only,
+ * readers can run at the same time on other threads or in a signal handler
+ * @param ID EventId_t Event
+ * @param ARG unsigned short Event argument
+ * @param PAYLOAD unsigned long Event payload
+ * @return void
+ */
+void EventRing_Record(EventId_t ID, unsigned short ARG, unsigned long PAYLOAD);
+
+
+/** @brief Set the time of next Records, the Scheduler sets it at the start of every tick (and every Task
+ * if Sched_OnTask is set) so adding a Record reads no clock. Till it is set Records have the time of EventRing_Reset()
+ * @param TIME uint64_t Time (EventRing_Now() units)
+ * @return void
+ */
+void EventRing_SetTime(uint64_t TIME);
+
+
+/** @brief Forget all Records, next Records have the time of now
+ * @param void
+ * @return void
+ */
+void EventRing_Reset(void);
+
+
+/** @brief Copy Records in order, oldest first. Records overwritten while copying are left out
+ * @param OUT EventRecord_t* Where to copy
+ * @param MAX unsigned int Most Records to copy, newest are copied if there are more
+ * @return unsigned int Number of Records copied
+ */
+unsigned int EventRing_Snapshot(EventRecord_t* OUT, unsigned int MAX);
+
+
+/** @brief Copy Records after a cursor in order, oldest first, and move the cursor after them.
+ * Records overwritten before being read are lost
+ * @param CURSOR uint32_t* Number of Records already read, start with 0
+ * @param OUT EventRecord_t* Where to copy
+ * @param MAX unsigned int Most Records to copy, call again for the rest
+ * @return unsigned int Number of Records copied
+ */
+unsigned int EventRing_ReadFrom(uint32_t* CURSOR, EventRecord_t* OUT, unsigned int MAX);
+
+
+/** @brief Current time in EventRing_TimeUnit(), the clock of Record times
+ * @param void
+ * @return uint64_t Time
+ */
+uint64_t EventRing_Now(void);
+
+
+/** @brief Length of one time unit, cycles are measured against the monotonic clock on first call (10 ms)
+ * @param void
+ * @return double ns per time unit
+ */
+double EventRing_NsPerUnit(void);
+
+
+/** @brief Time unit of Record times, cycles if a cycle counter is used
+ * @param void
+ * @return EventTimeUnit_t Time unit
+ */
+EventTimeUnit_t EventRing_TimeUnit(void);
+
+
+/** @brief Name of an Event
+ * @param ID unsigned int Event
+ * @return const char* "SWITCH", "SPEED", "MOTOR" or "?"
+ */
+const char* EventRing_IdName(unsigned int ID);
+
+
+/** @brief Describe a Record as text, e.g. "+ve -> PRESSED" or "MED -> MAX"
+ * @param RECORD const EventRecord_t* Record
+ * @param TEXT char* Where to write
+ * @param SIZE size_t Size of TEXT
+ * @return void
+ */
+void EventRing_Describe(const EventRecord_t* RECORD, char* TEXT, size_t SIZE);
+
+
+/** @brief Print Records as text, one Line per Record
+ * @param OUT FILE* Where to print
+ * @param RECORDS const EventRecord_t* Records
+ * @param COUNT unsigned int Number of Records
+ * @return void
+ */
+void EventRing_Print(FILE* OUT, const EventRecord_t* RECORDS, unsigned int COUNT);
+
+
+/** @brief Print all Records now as text
+ * @param OUT FILE* Where to print
+ * @return void
+ */
+void EventRing_Dump(FILE* OUT);
+
+
+/** @brief Write Raw Dump (Header & Records) to a File descriptor, only async signal safe calls are used
+ * @param FD int File descriptor
+ * @return bool true if all is written & false if not
+ */
+bool EventRing_WriteRaw(int FD);
+
+
+/** @brief Write Raw Dump to a File when the program crashes (SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT),
+ * then the program is stopped by the same signal. Decode the File with event_dump tool
+ * @param PATH const char* Dump File path, it is kept (not copied)
+ * @return bool true if crash handlers are installed & false if not
+ */
+bool EventRing_DumpOnCrash(const char* PATH);
+
+#endif // EVENT_RING_H_INCLUDED
@@ -0,0 +1,28 @@
+/**
+ * @file file_sync.c
+ * @brief File Sync main file
+ * @details Here we sync Files of the non-volatile Stores (persist, journal): fflush() only hands bytes to the OS,
+ * they reach the disk on fsync() (_commit() on Windows)
+ *
+ */
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+ /*    Include Header    */
+#include"file_sync.h"
+
+
+bool File_Sync(FILE* STREAM){
+    if(fflush(STREAM) != 0){
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(STREAM)) == 0;
+#else
+    return fsync(fileno(STREAM)) == 0;
+#endif
+}
@@ -0,0 +1,19 @@
+/**
+ * @file file_sync.h
+ * @brief File Sync header file
+ */
+
+#ifndef FILE_SYNC_H_INCLUDED
+#define FILE_SYNC_H_INCLUDED
+
+#include <stdio.h>
+#include <stdbool.h>
+
+
+/** @brief Write buffered bytes of a File to the disk, not only to the OS, so they are kept over power off
+ * @param STREAM FILE* File
+ * @return bool true if File is synced & false if not
+ */
+bool File_Sync(FILE* STREAM);
+
+#endif // FILE_SYNC_H_INCLUDED
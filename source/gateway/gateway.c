@@ -0,0 +1,528 @@
+/**
+ * @file gateway.c
+ * @brief Gateway main file
+ * @details Here we run thousands of Speed Controllers in one process behind one local socket, instead of one
+ * Controller process per simulated unit. <br>
+ * Clients write fixed size Requests (Unit & Switches Inputs, as one Speed Update) as fast as they like, every
+ * complete Request read from a client at once is one batch. A batch is split by Shard: every Shard thread scans
+ * it and updates only its own Units (Unit % Shards), so Controllers are never shared nor locked and Requests of one
+ * Unit keep their order. Replies are written in place and sent back with one send() per batch. <br>
+ * Clients are served with epoll on one thread, the Shards wake once per batch (small batches are run at once on the
+ * socket thread)
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#endif
+
+ /*    Include Header    */
+#include"gateway.h"
+
+/** @brief A connected client, Requests not complete yet & Replies not sent yet */
+struct GatewayClient_s {
+    int Fd;
+    unsigned int Index;
+    bool Writing;
+    size_t InUsed;
+    size_t OutUsed;
+    size_t OutSent;
+    uint8_t In[GATEWAY_BUFFER_SIZE];
+    uint8_t Out[GATEWAY_BUFFER_SIZE];
+};
+
+_Static_assert(GATEWAY_BUFFER_SIZE % GATEWAY_REQUEST_SIZE == 0, "Gateway buffer must hold whole Requests");
+_Static_assert(GATEWAY_REQUEST_SIZE == GATEWAY_REPLY_SIZE, "One Reply per Request must fit in the Request size");
+
+
+/** @brief Load 32 bits little endian
+ * @param BYTES const uint8_t* 4 bytes
+ * @return uint32_t Value
+ */
+static uint32_t Gateway_Get32(const uint8_t* BYTES){
+    return (uint32_t)BYTES[0] | ((uint32_t)BYTES[1] << 8) | ((uint32_t)BYTES[2] << 16) | ((uint32_t)BYTES[3] << 24);
+}
+
+
+/** @brief Run one Request on its Unit and write its Reply
+ * @param GATEWAY Gateway_t* Gateway
+ * @param REQUEST const uint8_t* Request
+ * @param REPLY uint8_t* Reply
+ * @return void
+ */
+static void Gateway_One(Gateway_t* GATEWAY, const uint8_t* REQUEST, uint8_t* REPLY){
+    uint32_t Unit = Gateway_Get32(REQUEST);
+    SpeedController_t* Ctl;
+    SpeedInput_t Input;
+    short Angle;
+
+    memcpy(REPLY, REQUEST, 4);
+    if(Unit >= GATEWAY->Units){
+        REPLY[4] = 0;
+        REPLY[5] = GATEWAY_BAD_UNIT;
+        REPLY[6] = 0;
+        REPLY[7] = 0;
+        return;
+    }
+
+    Ctl = &GATEWAY->Shards[Unit % GATEWAY->ShardCount].Units[Unit / GATEWAY->ShardCount];
+    if(REQUEST[4] > RELEASED || REQUEST[5] > RELEASED || REQUEST[6] > RELEASED){
+        REPLY[5] = GATEWAY_BAD_INPUT;
+    }else{
+        Input.Postive_State = (SwitchState_t)REQUEST[4];
+        Input.Negative_State = (SwitchState_t)REQUEST[5];
+        Input.P_State = (SwitchState_t)REQUEST[6];
+        Input.P_PressTime = REQUEST[7];
+        SpeedCtl_Update(Ctl, &Input);
+        REPLY[5] = GATEWAY_OK;
+    }
+    Angle = SpeedCtl_Angle(Ctl);
+    REPLY[4] = (uint8_t)Ctl->Speed;
+    REPLY[6] = (uint8_t)Angle;
+    REPLY[7] = (uint8_t)((unsigned short)Angle >> 8);
+}
+
+
+/** @brief Run the Requests of one Shard in a batch
+ * @param SHARD GatewayShard_t* Shard
+ * @param REQUESTS const uint8_t* Requests
+ * @param COUNT unsigned long Number of Requests
+ * @param REPLIES uint8_t* Replies
+ * @return void
+ */
+static void Gateway_Part(GatewayShard_t* SHARD, const uint8_t* REQUESTS, unsigned long COUNT, uint8_t* REPLIES){
+    Gateway_t* Gateway = SHARD->Gateway;
+    unsigned long i;
+    uint32_t Unit;
+
+    for(i = 0; i < COUNT; i++){
+        Unit = Gateway_Get32(REQUESTS + i * GATEWAY_REQUEST_SIZE);
+        /* Bad Units have no Shard, the first one answers them */
+        if((Unit < Gateway->Units) ? (Unit % Gateway->ShardCount == SHARD->Index) : (SHARD->Index == 0)){
+            Gateway_One(Gateway, REQUESTS + i * GATEWAY_REQUEST_SIZE, REPLIES + i * GATEWAY_REPLY_SIZE);
+        }
+    }
+}
+
+
+/** @brief Shard thread, it runs its part of every batch
+ * @param ARG void* GatewayShard_t
+ * @return void* NULL
+ */
+static void* Gateway_Shard(void* ARG){
+    GatewayShard_t* Shard = ARG;
+    Gateway_t* Gateway = Shard->Gateway;
+    unsigned long Seen;
+    const uint8_t* Requests;
+    uint8_t* Replies;
+    unsigned long Count;
+
+    /* Generation is 0 at Gateway_Init(), a batch given before this thread runs isn't missed */
+    Seen = 0;
+    pthread_mutex_lock(&Gateway->Lock);
+    for(;;){
+        while(Gateway->Generation == Seen && !Gateway->Quit){
+            pthread_cond_wait(&Gateway->Start, &Gateway->Lock);
+        }
+        if(Gateway->Quit){
+            break;
+        }
+        Seen = Gateway->Generation;
+        Requests = Gateway->Requests;
+        Replies = Gateway->Replies;
+        Count = Gateway->Count;
+        pthread_mutex_unlock(&Gateway->Lock);
+
+        Gateway_Part(Shard, Requests, Count, Replies);
+
+        pthread_mutex_lock(&Gateway->Lock);
+        if(--Gateway->Remaining == 0){
+            pthread_cond_signal(&Gateway->Done);
+        }
+    }
+    pthread_mutex_unlock(&Gateway->Lock);
+    return NULL;
+}
+
+
+/** @brief Number of Shards to use when it is not given
+ * @param void
+ * @return unsigned int Number of online CPUs
+ */
+static unsigned int Gateway_DefaultShards(void){
+#ifdef _SC_NPROCESSORS_ONLN
+    long Cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return (Cpus > 0) ? (unsigned int)Cpus : 1;
+#else
+    return 1;
+#endif
+}
+
+
+/** @brief Stop Shard threads & free Units
+ * @param GATEWAY Gateway_t* Gateway
+ * @param STARTED unsigned int Number of Shard threads started
+ * @return void
+ */
+static void Gateway_Stop(Gateway_t* GATEWAY, unsigned int STARTED){
+    unsigned int i;
+
+    pthread_mutex_lock(&GATEWAY->Lock);
+    GATEWAY->Quit = true;
+    pthread_cond_broadcast(&GATEWAY->Start);
+    pthread_mutex_unlock(&GATEWAY->Lock);
+    for(i = 0; i < STARTED; i++){
+        pthread_join(GATEWAY->Shards[i].Thread, NULL);
+    }
+    for(i = 0; i < GATEWAY->ShardCount; i++){
+        free(GATEWAY->Shards[i].Units);
+        GATEWAY->Shards[i].Units = NULL;
+    }
+    pthread_mutex_destroy(&GATEWAY->Lock);
+    pthread_cond_destroy(&GATEWAY->Start);
+    pthread_cond_destroy(&GATEWAY->Done);
+    GATEWAY->Units = 0;
+}
+
+
+bool Gateway_Init(Gateway_t* GATEWAY, unsigned long UNITS, unsigned int SHARDS){
+    GatewayShard_t* Shard;
+    unsigned int i, Started = 0;
+    unsigned long Unit;
+
+    memset(GATEWAY, 0, sizeof(*GATEWAY));
+    GATEWAY->ListenFd = -1;
+    GATEWAY->EpollFd = -1;
+    if(UNITS == 0 || UNITS > GATEWAY_MAX_UNITS){
+        return false;
+    }
+    if(SHARDS == 0){
+        SHARDS = Gateway_DefaultShards();
+    }
+    if(SHARDS > GATEWAY_MAX_SHARDS){
+        SHARDS = GATEWAY_MAX_SHARDS;
+    }
+    if(SHARDS > UNITS){
+        SHARDS = (unsigned int)UNITS;
+    }
+    GATEWAY->Units = UNITS;
+    GATEWAY->ShardCount = SHARDS;
+    pthread_mutex_init(&GATEWAY->Lock, NULL);
+    pthread_cond_init(&GATEWAY->Start, NULL);
+    pthread_cond_init(&GATEWAY->Done, NULL);
+
+    for(i = 0; i < SHARDS; i++){
+        Shard = &GATEWAY->Shards[i];
+        Shard->Index = i;
+        Shard->Gateway = GATEWAY;
+        Shard->Count = (UNITS - i + SHARDS - 1) / SHARDS;
+        Shard->Units = malloc(Shard->Count * sizeof(SpeedController_t));
+        if(Shard->Units == NULL){
+            Gateway_Stop(GATEWAY, 0);
+            return false;
+        }
+        for(Unit = 0; Unit < Shard->Count; Unit++){
+            SpeedCtl_Init(&Shard->Units[Unit]);
+        }
+    }
+
+    /* One Shard needs no thread, the caller runs it */
+    if(SHARDS > 1){
+        for(i = 0; i < SHARDS; i++){
+            if(pthread_create(&GATEWAY->Shards[i].Thread, NULL, Gateway_Shard, &GATEWAY->Shards[i]) != 0){
+                Gateway_Stop(GATEWAY, Started);
+                return false;
+            }
+            Started++;
+        }
+        GATEWAY->Threads = true;
+    }
+    return true;
+}
+
+
+void Gateway_Process(Gateway_t* GATEWAY, const uint8_t* REQUESTS, unsigned long COUNT, uint8_t* REPLIES){
+    unsigned long i;
+
+    GATEWAY->Stats.Requests += COUNT;
+    GATEWAY->Stats.Batches++;
+
+    /* Shards are waiting, so their Units can be used here */
+    if(!GATEWAY->Threads || COUNT < GATEWAY_INLINE_RECORDS){
+        for(i = 0; i < COUNT; i++){
+            Gateway_One(GATEWAY, REQUESTS + i * GATEWAY_REQUEST_SIZE, REPLIES + i * GATEWAY_REPLY_SIZE);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&GATEWAY->Lock);
+    GATEWAY->Requests = REQUESTS;
+    GATEWAY->Replies = REPLIES;
+    GATEWAY->Count = COUNT;
+    GATEWAY->Remaining = GATEWAY->ShardCount;
+    GATEWAY->Generation++;
+    pthread_cond_broadcast(&GATEWAY->Start);
+    while(GATEWAY->Remaining != 0){
+        pthread_cond_wait(&GATEWAY->Done, &GATEWAY->Lock);
+    }
+    pthread_mutex_unlock(&GATEWAY->Lock);
+}
+
+
+void Gateway_Stats(const Gateway_t* GATEWAY, GatewayStats_t* STATS){
+    *STATS = GATEWAY->Stats;
+}
+
+
+void Gateway_Destroy(Gateway_t* GATEWAY){
+    if(GATEWAY->Units == 0){
+        /* Not created or already destroyed */
+        return;
+    }
+    Gateway_Close(GATEWAY);
+    Gateway_Stop(GATEWAY, GATEWAY->Threads ? GATEWAY->ShardCount : 0);
+    GATEWAY->Threads = false;
+}
+
+
+#ifdef __linux__
+
+/** @brief Close a client
+ * @param GATEWAY Gateway_t* Gateway
+ * @param CLIENT GatewayClient_t* Client
+ * @return void
+ */
+static void Gateway_Drop(Gateway_t* GATEWAY, GatewayClient_t* CLIENT){
+    epoll_ctl(GATEWAY->EpollFd, EPOLL_CTL_DEL, CLIENT->Fd, NULL);
+    close(CLIENT->Fd);
+    GATEWAY->Clients[CLIENT->Index] = NULL;
+    GATEWAY->Stats.Clients--;
+    free(CLIENT);
+}
+
+
+/** @brief Wait for a client to read (EPOLLOUT) or to write (EPOLLIN)
+ * @param GATEWAY Gateway_t* Gateway
+ * @param CLIENT GatewayClient_t* Client
+ * @param WRITING bool true while Replies are left to send
+ * @return void
+ */
+static void Gateway_Watch(Gateway_t* GATEWAY, GatewayClient_t* CLIENT, bool WRITING){
+    struct epoll_event Event;
+
+    if(CLIENT->Writing != WRITING){
+        Event.events = WRITING ? EPOLLOUT : EPOLLIN;
+        Event.data.u32 = CLIENT->Index;
+        epoll_ctl(GATEWAY->EpollFd, EPOLL_CTL_MOD, CLIENT->Fd, &Event);
+        CLIENT->Writing = WRITING;
+    }
+}
+
+
+/** @brief Accept all waiting clients, clients over GATEWAY_MAX_CLIENTS are closed at once
+ * @param GATEWAY Gateway_t* Gateway
+ * @return void
+ */
+static void Gateway_Accept(Gateway_t* GATEWAY){
+    struct epoll_event Event;
+    GatewayClient_t* Client;
+    unsigned int i;
+    int Fd;
+
+    while((Fd = accept(GATEWAY->ListenFd, NULL, NULL)) >= 0){
+        for(i = 0; i < GATEWAY_MAX_CLIENTS && GATEWAY->Clients[i] != NULL; i++){
+        }
+        Client = (i < GATEWAY_MAX_CLIENTS) ? malloc(sizeof(GatewayClient_t)) : NULL;
+        Event.events = EPOLLIN;
+        Event.data.u32 = i;
+        if(Client == NULL || epoll_ctl(GATEWAY->EpollFd, EPOLL_CTL_ADD, Fd, &Event) != 0){
+            free(Client);
+            close(Fd);
+            continue;
+        }
+        Client->Fd = Fd;
+        Client->Index = i;
+        Client->Writing = false;
+        Client->InUsed = 0;
+        Client->OutUsed = 0;
+        Client->OutSent = 0;
+        GATEWAY->Clients[i] = Client;
+        GATEWAY->Stats.Clients++;
+        GATEWAY->Stats.Accepted++;
+    }
+}
+
+
+/** @brief Send Replies left, the client is read again once all are sent
+ * @param GATEWAY Gateway_t* Gateway
+ * @param CLIENT GatewayClient_t* Client
+ * @return void
+ */
+static void Gateway_Send(Gateway_t* GATEWAY, GatewayClient_t* CLIENT){
+    ssize_t Sent = send(CLIENT->Fd, CLIENT->Out + CLIENT->OutSent, CLIENT->OutUsed - CLIENT->OutSent,
+                        MSG_NOSIGNAL | MSG_DONTWAIT);
+
+    if(Sent < 0){
+        if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR){
+            Gateway_Drop(GATEWAY, CLIENT);
+        }else{
+            Gateway_Watch(GATEWAY, CLIENT, true);
+        }
+        return;
+    }
+    CLIENT->OutSent += (size_t)Sent;
+    if(CLIENT->OutSent == CLIENT->OutUsed){
+        CLIENT->OutUsed = 0;
+        CLIENT->OutSent = 0;
+        Gateway_Watch(GATEWAY, CLIENT, false);
+    }else{
+        Gateway_Watch(GATEWAY, CLIENT, true);
+    }
+}
+
+
+/** @brief Read Requests of a client, run the complete ones as one batch and send their Replies
+ * @param GATEWAY Gateway_t* Gateway
+ * @param CLIENT GatewayClient_t* Client, it has no Replies left to send
+ * @return void
+ */
+static void Gateway_Read(Gateway_t* GATEWAY, GatewayClient_t* CLIENT){
+    ssize_t Got = recv(CLIENT->Fd, CLIENT->In + CLIENT->InUsed, sizeof(CLIENT->In) - CLIENT->InUsed, MSG_DONTWAIT);
+    unsigned long Count;
+    size_t Used;
+
+    if(Got == 0 || (Got < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)){
+        Gateway_Drop(GATEWAY, CLIENT);
+        return;
+    }
+    if(Got < 0){
+        return;
+    }
+    CLIENT->InUsed += (size_t)Got;
+
+    Count = CLIENT->InUsed / GATEWAY_REQUEST_SIZE;
+    if(Count == 0){
+        return;
+    }
+    Gateway_Process(GATEWAY, CLIENT->In, Count, CLIENT->Out);
+    CLIENT->OutUsed = Count * GATEWAY_REPLY_SIZE;
+
+    /* Keep the part of a Request which is not read yet */
+    Used = Count * GATEWAY_REQUEST_SIZE;
+    memmove(CLIENT->In, CLIENT->In + Used, CLIENT->InUsed - Used);
+    CLIENT->InUsed -= Used;
+
+    Gateway_Send(GATEWAY, CLIENT);
+}
+
+
+bool Gateway_Listen(Gateway_t* GATEWAY, const char* PATH){
+    struct sockaddr_un Address;
+    struct epoll_event Event;
+
+    if(strlen(PATH) >= sizeof(Address.sun_path) || strlen(PATH) >= sizeof(GATEWAY->Path)){
+        return false;
+    }
+    Gateway_Close(GATEWAY);
+
+    memset(&Address, 0, sizeof(Address));
+    Address.sun_family = AF_UNIX;
+    strcpy(Address.sun_path, PATH);
+    unlink(PATH);
+
+    GATEWAY->ListenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    GATEWAY->EpollFd = epoll_create1(EPOLL_CLOEXEC);
+    Event.events = EPOLLIN;
+    Event.data.u32 = GATEWAY_MAX_CLIENTS;
+    if(GATEWAY->ListenFd < 0 || GATEWAY->EpollFd < 0 ||
+       bind(GATEWAY->ListenFd, (struct sockaddr*)&Address, sizeof(Address)) != 0 ||
+       listen(GATEWAY->ListenFd, GATEWAY_MAX_CLIENTS) != 0 ||
+       epoll_ctl(GATEWAY->EpollFd, EPOLL_CTL_ADD, GATEWAY->ListenFd, &Event) != 0){
+        Gateway_Close(GATEWAY);
+        return false;
+    }
+    strcpy(GATEWAY->Path, PATH);
+    return true;
+}
+
+
+void Gateway_Poll(Gateway_t* GATEWAY, int TIMEOUT_MS){
+    struct epoll_event Events[GATEWAY_MAX_CLIENTS + 1];
+    GatewayClient_t* Client;
+    int Ready, i;
+
+    if(GATEWAY->EpollFd < 0){
+        return;
+    }
+    Ready = epoll_wait(GATEWAY->EpollFd, Events, GATEWAY_MAX_CLIENTS + 1, TIMEOUT_MS);
+    for(i = 0; i < Ready; i++){
+        if(Events[i].data.u32 == GATEWAY_MAX_CLIENTS){
+            Gateway_Accept(GATEWAY);
+            continue;
+        }
+        Client = GATEWAY->Clients[Events[i].data.u32];
+        if(Client == NULL){
+            continue;
+        }
+        if(Client->Writing){
+            Gateway_Send(GATEWAY, Client);
+        }else{
+            Gateway_Read(GATEWAY, Client);
+        }
+    }
+}
+
+
+void Gateway_Close(Gateway_t* GATEWAY){
+    unsigned int i;
+
+    for(i = 0; i < GATEWAY_MAX_CLIENTS; i++){
+        if(GATEWAY->Clients[i] != NULL){
+            Gateway_Drop(GATEWAY, GATEWAY->Clients[i]);
+        }
+    }
+    if(GATEWAY->ListenFd >= 0){
+        close(GATEWAY->ListenFd);
+        GATEWAY->ListenFd = -1;
+    }
+    if(GATEWAY->EpollFd >= 0){
+        close(GATEWAY->EpollFd);
+        GATEWAY->EpollFd = -1;
+    }
+    if(GATEWAY->Path[0] != '\0'){
+        unlink(GATEWAY->Path);
+        GATEWAY->Path[0] = '\0';
+    }
+}
+
+#else
+
+bool Gateway_Listen(Gateway_t* GATEWAY, const char* PATH){
+    /* epoll & UNIX sockets, Linux only */
+    (void)GATEWAY;
+    (void)PATH;
+    return false;
+}
+
+
+void Gateway_Poll(Gateway_t* GATEWAY, int TIMEOUT_MS){
+    (void)GATEWAY;
+    (void)TIMEOUT_MS;
+}
+
+
+void Gateway_Close(Gateway_t* GATEWAY){
+    (void)GATEWAY;
+}
+
+#endif
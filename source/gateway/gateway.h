@@ -0,0 +1,142 @@
+/**
+ * @file gateway.h
+ * @brief Gateway header file
+ */
+
+#ifndef GATEWAY_H_INCLUDED
+#define GATEWAY_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include"../speedcontrol/speedcontrol.h"
+
+/** @brief Request: Unit (4 bytes LE) | +ve State | -ve State | P State | P Press Time */
+#define GATEWAY_REQUEST_SIZE        8
+
+/** @brief Reply: Unit (4 bytes LE) | Speed | GatewayStatus_t | Motor Angle (2 bytes LE) */
+#define GATEWAY_REPLY_SIZE          8
+
+/** @brief Most Units & Shards of one Gateway */
+#define GATEWAY_MAX_UNITS           (1ul << 24)
+#define GATEWAY_MAX_SHARDS          64
+
+/** @brief Batches smaller than this are run by the calling thread, waking the Shards costs more */
+#ifndef GATEWAY_INLINE_RECORDS
+#define GATEWAY_INLINE_RECORDS      1024
+#endif
+
+/** @brief Most clients connected at once & bytes of Requests read from one client at once */
+#define GATEWAY_MAX_CLIENTS         256
+#define GATEWAY_BUFFER_SIZE         (64 * 1024)
+
+/** @brief Status of one Reply */
+typedef enum {GATEWAY_OK, GATEWAY_BAD_UNIT, GATEWAY_BAD_INPUT} GatewayStatus_t;
+
+typedef struct Gateway_s Gateway_t;
+typedef struct GatewayClient_s GatewayClient_t;
+
+/** @brief One Shard: the Units it owns (Unit % Shards == Shard, stored at Unit / Shards) & its thread */
+typedef struct {
+    SpeedController_t* Units;
+    unsigned long Count;
+    unsigned int Index;
+    Gateway_t* Gateway;
+    pthread_t Thread;
+} GatewayShard_t;
+
+/** @brief Counters of a Gateway */
+typedef struct {
+    unsigned long long Requests;
+    unsigned long long Batches;
+    unsigned long Clients;          /* Clients connected now */
+    unsigned long Accepted;         /* Clients connected since Gateway_Listen() */
+} GatewayStats_t;
+
+/** @brief Many Speed Controllers behind one socket */
+struct Gateway_s {
+    unsigned long Units;
+    unsigned int ShardCount;
+    bool Threads;
+    GatewayShard_t Shards[GATEWAY_MAX_SHARDS];
+
+    /* Batch handed to the Shard threads */
+    pthread_mutex_t Lock;
+    pthread_cond_t Start;
+    pthread_cond_t Done;
+    unsigned long Generation;
+    unsigned int Remaining;
+    bool Quit;
+    const uint8_t* Requests;
+    uint8_t* Replies;
+    unsigned long Count;
+
+    /* Socket */
+    int ListenFd;
+    int EpollFd;
+    char Path[108];
+    GatewayClient_t* Clients[GATEWAY_MAX_CLIENTS];
+    GatewayStats_t Stats;
+};
+
+
+/** @brief Create UNITS Controllers at default Speed, shared between SHARDS Shard threads
+ * @param GATEWAY Gateway_t* Gateway to create
+ * @param UNITS unsigned long Number of Units, Units are 0 to UNITS - 1
+ * @param SHARDS unsigned int Number of Shards, 0 uses one per CPU
+ * @return bool true if Gateway is created & false if not
+ */
+bool Gateway_Init(Gateway_t* GATEWAY, unsigned long UNITS, unsigned int SHARDS);
+
+
+/** @brief Update Units from a batch of Requests, every Shard updates its own Units so no Controller is shared.
+ * Requests of the same Unit are applied in batch order
+ * @param GATEWAY Gateway_t* Gateway
+ * @param REQUESTS const uint8_t* COUNT Requests
+ * @param COUNT unsigned long Number of Requests
+ * @param REPLIES uint8_t* COUNT Replies, in Request order
+ * @return void
+ */
+void Gateway_Process(Gateway_t* GATEWAY, const uint8_t* REQUESTS, unsigned long COUNT, uint8_t* REPLIES);
+
+
+/** @brief Listen for clients on a UNIX socket, clients write Requests and read one Reply per Request
+ * @param GATEWAY Gateway_t* Gateway
+ * @param PATH const char* Socket path, an old socket there is removed
+ * @return bool true if socket is listening & false if not (or not on Linux)
+ */
+bool Gateway_Listen(Gateway_t* GATEWAY, const char* PATH);
+
+
+/** @brief Wait for clients to be ready, then accept new clients, process every complete Request each client sent as
+ * one batch and send its Replies at once. A client not reading its Replies isn't read till it does
+ * @param GATEWAY Gateway_t* Listening Gateway
+ * @param TIMEOUT_MS int Most time to wait, 0 doesn't wait & -1 waits till a client is ready
+ * @return void
+ */
+void Gateway_Poll(Gateway_t* GATEWAY, int TIMEOUT_MS);
+
+
+/** @brief Get Gateway counters
+ * @param GATEWAY const Gateway_t* Gateway
+ * @param STATS GatewayStats_t* Counters
+ * @return void
+ */
+void Gateway_Stats(const Gateway_t* GATEWAY, GatewayStats_t* STATS);
+
+
+/** @brief Close clients & socket and remove socket path, Units are kept
+ * @param GATEWAY Gateway_t* Gateway
+ * @return void
+ */
+void Gateway_Close(Gateway_t* GATEWAY);
+
+
+/** @brief Close socket, stop Shard threads & free Units, a destroyed Gateway may be destroyed again
+ * @param GATEWAY Gateway_t* Gateway
+ * @return void
+ */
+void Gateway_Destroy(Gateway_t* GATEWAY);
+
+#endif // GATEWAY_H_INCLUDED
@@ -0,0 +1,279 @@
+/**
+ * @file journal.c
+ * @brief State Journal main file
+ * @details Here we keep the full Controller State (Speed, Switches States, P Press Time accumulators & Scheduler
+ * phase) in an append-only Journal, so a restarted Controller carries on from its last tick instead of starting
+ * again from RELEASED Switches & MED Speed. <br>
+ * Records have a fixed size and a CRC-32, so the newest one is read at the end of the File without replaying
+ * the Journal, and a torn write (partial or bad last Record) is skipped for the Record before it. A restored
+ * State is also checked before it is applied, so a Controller never starts from an invalid State. <br>
+ * The Journal is compacted every COMPACT_RECORDS to its newest Record through a synced temporary File & rename
+ *
+ */
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+ /*    Include Header    */
+#include"journal.h"
+
+ /*    Include Modules    */
+#include"../crc/crc32.h"
+#include"../file_sync/file_sync.h"
+#include"../scheduler/scheduler.h"
+
+
+/** @brief Store little endian
+ * @param BYTES uint8_t* Bytes
+ * @param VALUE uint64_t Value
+ * @param SIZE unsigned int Number of bytes
+ * @return void
+ */
+static void Journal_Put(uint8_t* BYTES, uint64_t VALUE, unsigned int SIZE){
+    unsigned int i;
+
+    for(i = 0; i < SIZE; i++){
+        BYTES[i] = (uint8_t)(VALUE >> (8 * i));
+    }
+}
+
+
+/** @brief Load little endian
+ * @param BYTES const uint8_t* Bytes
+ * @param SIZE unsigned int Number of bytes
+ * @return uint64_t Value
+ */
+static uint64_t Journal_Get(const uint8_t* BYTES, unsigned int SIZE){
+    uint64_t Value = 0;
+
+    while(SIZE-- != 0){
+        Value = (Value << 8) | BYTES[SIZE];
+    }
+    return Value;
+}
+
+
+/** @brief Encode a State Record
+ * @param RECORD uint8_t* JOURNAL_RECORD_SIZE bytes
+ * @param STATE const ControllerState_t* State
+ * @param SEQ uint32_t Record Seq
+ * @return void
+ */
+static void Journal_Encode(uint8_t* RECORD, const ControllerState_t* STATE, uint32_t SEQ){
+    memset(RECORD, 0, JOURNAL_RECORD_SIZE);
+    RECORD[0] = JOURNAL_MAGIC;
+    RECORD[1] = JOURNAL_VERSION;
+    RECORD[2] = (uint8_t)STATE->Speed;
+    RECORD[3] = (uint8_t)STATE->Switches.States[POSTIVE];
+    RECORD[4] = (uint8_t)STATE->Switches.States[NEGATIVE];
+    RECORD[5] = (uint8_t)STATE->Switches.States[P];
+    RECORD[6] = STATE->Switches.PressTime;
+    Journal_Put(RECORD + 8, STATE->Switches.PressTicks, 4);
+    Journal_Put(RECORD + 12, SEQ, 4);
+    Journal_Put(RECORD + 16, STATE->Ticks, 8);
+    Journal_Put(RECORD + 28, Crc32(RECORD, 28), 4);
+}
+
+
+/** @brief Decode a State Record
+ * @param RECORD const uint8_t* JOURNAL_RECORD_SIZE bytes
+ * @param STATE ControllerState_t* State
+ * @param SEQ uint32_t* Record Seq
+ * @return bool true if Record is valid & false if it is torn or not a Record
+ */
+static bool Journal_Decode(const uint8_t* RECORD, ControllerState_t* STATE, uint32_t* SEQ){
+    if(RECORD[0] != JOURNAL_MAGIC || RECORD[1] != JOURNAL_VERSION ||
+       Crc32(RECORD, 28) != (uint32_t)Journal_Get(RECORD + 28, 4)){
+        return false;
+    }
+    STATE->Speed = (MotorSpeed_t)RECORD[2];
+    STATE->Switches.States[POSTIVE] = (SwitchState_t)RECORD[3];
+    STATE->Switches.States[NEGATIVE] = (SwitchState_t)RECORD[4];
+    STATE->Switches.States[P] = (SwitchState_t)RECORD[5];
+    STATE->Switches.PressTime = RECORD[6];
+    STATE->Switches.PressTicks = (unsigned int)Journal_Get(RECORD + 8, 4);
+    *SEQ = (uint32_t)Journal_Get(RECORD + 12, 4);
+    STATE->Ticks = (unsigned long)Journal_Get(RECORD + 16, 8);
+    return true;
+}
+
+
+/** @brief Check a State can be applied
+ * @param STATE const ControllerState_t* State
+ * @return bool true if State is valid & false if not
+ */
+static bool Journal_IsValid(const ControllerState_t* STATE){
+    unsigned int Sw;
+
+    if((unsigned int)STATE->Speed > MAX || STATE->Switches.PressTicks >= SW_TICKS_PER_SECOND){
+        return false;
+    }
+    for(Sw = 0; Sw < 3; Sw++){
+        if((unsigned int)STATE->Switches.States[Sw] > RELEASED){
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void Journal_Capture(ControllerState_t* STATE){
+    STATE->Speed = Speed_Get();
+    SW_Save(&STATE->Switches);
+    STATE->Ticks = Sched_Ticks();
+}
+
+
+bool Journal_Apply(const ControllerState_t* STATE){
+    if(!Journal_IsValid(STATE) || !SW_Restore(&STATE->Switches)){
+        return false;
+    }
+    Speed_Set(STATE->Speed);
+    Sched_SetTicks(STATE->Ticks);
+    return true;
+}
+
+
+bool Journal_Open(Journal_t* JOURNAL, const char* PATH, unsigned long COMPACT_RECORDS){
+    uint8_t Record[JOURNAL_RECORD_SIZE];
+    ControllerState_t State;
+    uint32_t Seq;
+    FILE* File;
+    long Size = 0, Valid = 0;
+    long Index;
+
+    memset(JOURNAL, 0, sizeof(*JOURNAL));
+    if(strlen(PATH) + sizeof(".tmp") > sizeof(JOURNAL->Path)){
+        return false;
+    }
+    strcpy(JOURNAL->Path, PATH);
+    JOURNAL->CompactRecords = (COMPACT_RECORDS < 2) ? 2 : COMPACT_RECORDS;
+
+    /* Newest valid Record is the last one, go back only over torn or bad Records */
+    File = fopen(PATH, "rb");
+    if(File != NULL){
+        if(fseek(File, 0, SEEK_END) == 0){
+            Size = ftell(File);
+        }
+        for(Index = Size / JOURNAL_RECORD_SIZE - 1; Index >= 0 && !JOURNAL->HasNewest; Index--){
+            if(fseek(File, Index * JOURNAL_RECORD_SIZE, SEEK_SET) == 0 &&
+               fread(Record, 1, sizeof(Record), File) == sizeof(Record) &&
+               Journal_Decode(Record, &State, &Seq) && Journal_IsValid(&State)){
+                JOURNAL->Newest = State;
+                JOURNAL->Seq = Seq;
+                JOURNAL->HasNewest = true;
+                Valid = Index + 1;
+            }
+        }
+        fclose(File);
+    }
+    JOURNAL->Records = (unsigned long)Valid;
+
+    /* Drop what is after the newest valid Record, so new Records follow it */
+    if(Size != Valid * JOURNAL_RECORD_SIZE && !Journal_Compact(JOURNAL)){
+        return false;
+    }
+    if(JOURNAL->File == NULL){
+        JOURNAL->File = fopen(PATH, "ab");
+    }
+    return JOURNAL->File != NULL;
+}
+
+
+bool Journal_Restore(const Journal_t* JOURNAL, ControllerState_t* STATE){
+    if(!JOURNAL->HasNewest){
+        return false;
+    }
+    *STATE = JOURNAL->Newest;
+    return true;
+}
+
+
+bool Journal_Append(Journal_t* JOURNAL, const ControllerState_t* STATE){
+    uint8_t Record[JOURNAL_RECORD_SIZE];
+
+    if(JOURNAL->File == NULL || !Journal_IsValid(STATE)){
+        return false;
+    }
+    Journal_Encode(Record, STATE, JOURNAL->Seq + 1);
+    if(fwrite(Record, 1, sizeof(Record), JOURNAL->File) != sizeof(Record) || fflush(JOURNAL->File) != 0){
+        return false;
+    }
+    JOURNAL->Seq++;
+    JOURNAL->Newest = *STATE;
+    JOURNAL->HasNewest = true;
+    JOURNAL->Records++;
+
+    if(JOURNAL->Records >= JOURNAL->CompactRecords){
+        /* A failed compaction keeps the old Journal, it is tried again on next Record */
+        Journal_Compact(JOURNAL);
+    }
+    return true;
+}
+
+
+bool Journal_Compact(Journal_t* JOURNAL){
+    uint8_t Record[JOURNAL_RECORD_SIZE];
+    char TmpPath[JOURNAL_PATH_MAX + 8];
+    FILE* Tmp;
+    bool Ok;
+
+    strcpy(TmpPath, JOURNAL->Path);
+    strcat(TmpPath, ".tmp");
+    Tmp = fopen(TmpPath, "wb");
+    if(Tmp == NULL){
+        return false;
+    }
+    Ok = true;
+    if(JOURNAL->HasNewest){
+        Journal_Encode(Record, &JOURNAL->Newest, JOURNAL->Seq);
+        Ok = fwrite(Record, 1, sizeof(Record), Tmp) == sizeof(Record);
+    }
+    Ok = File_Sync(Tmp) && Ok;
+    Ok = (fclose(Tmp) == 0) && Ok;
+    if(!Ok){
+        remove(TmpPath);
+        return false;
+    }
+
+    if(JOURNAL->File != NULL){
+        fclose(JOURNAL->File);
+        JOURNAL->File = NULL;
+    }
+#ifdef _WIN32
+    /* rename() doesn't replace a File on Windows */
+    Ok = MoveFileExA(TmpPath, JOURNAL->Path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    Ok = rename(TmpPath, JOURNAL->Path) == 0;
+#endif
+    if(!Ok){
+        remove(TmpPath);
+        JOURNAL->File = fopen(JOURNAL->Path, "ab");
+        return false;
+    }
+    JOURNAL->File = fopen(JOURNAL->Path, "ab");
+    JOURNAL->Records = JOURNAL->HasNewest ? 1 : 0;
+    JOURNAL->Compactions++;
+    return JOURNAL->File != NULL;
+}
+
+
+bool Journal_Update(Journal_t* JOURNAL){
+    ControllerState_t State;
+
+    Journal_Capture(&State);
+    /* This tick is done with Switches & Speed, a restarted Controller runs the next one */
+    State.Ticks++;
+    return Journal_Append(JOURNAL, &State);
+}
+
+
+void Journal_Close(Journal_t* JOURNAL){
+    if(JOURNAL->File != NULL){
+        fclose(JOURNAL->File);
+        JOURNAL->File = NULL;
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file journal.h
+ * @brief State Journal header file
+ */
+
+#ifndef JOURNAL_H_INCLUDED
+#define JOURNAL_H_INCLUDED
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include"../speedcontrol/speedcontrol.h"
+#include"../switches/switch.h"
+
+/** @brief Record: 'J' | version | Speed | 3 Switches States | Press Time | 0 | Press Ticks (4 bytes) | Seq (4 bytes) |
+ * Ticks (8 bytes) | 0 (4 bytes) | CRC-32 of first 28 bytes (4 bytes), all little endian */
+#define JOURNAL_MAGIC               'J'
+#define JOURNAL_VERSION             1
+#define JOURNAL_RECORD_SIZE         32
+
+/** @brief Journal is compacted to its newest Record when it has this many Records */
+#ifndef JOURNAL_COMPACT_RECORDS
+#define JOURNAL_COMPACT_RECORDS     1024
+#endif
+
+/** @brief Longest Journal File path */
+#define JOURNAL_PATH_MAX            256
+
+/** @brief Full Controller State */
+typedef struct {
+    MotorSpeed_t Speed;
+    SwitchSnapshot_t Switches;
+    unsigned long Ticks;            /* Scheduler phase, ticks run */
+} ControllerState_t;
+
+/** @brief An opened Journal */
+typedef struct {
+    FILE* File;
+    char Path[JOURNAL_PATH_MAX];
+    unsigned long CompactRecords;
+    unsigned long Records;          /* Records in File */
+    uint32_t Seq;                   /* Seq of newest Record */
+    ControllerState_t Newest;       /* State of newest valid Record */
+    bool HasNewest;
+    unsigned long Compactions;
+} Journal_t;
+
+
+/** @brief Take the State of the Controller (Speed, Switches & Scheduler)
+ * @param STATE ControllerState_t* State
+ * @return void
+ */
+void Journal_Capture(ControllerState_t* STATE);
+
+
+/** @brief Put a State back in the Controller, call it after Sched_Init()
+ * @param STATE const ControllerState_t* State
+ * @return bool true if State is applied & false if it isn't valid (nothing is changed)
+ */
+bool Journal_Apply(const ControllerState_t* STATE);
+
+
+/** @brief Open (or create) a Journal and find its newest valid Record. A torn or bad tail (the Controller died
+ * while writing) is dropped by compacting the Journal to that Record
+ * @param JOURNAL Journal_t* Journal to open
+ * @param PATH const char* Journal File path, PATH.tmp is used while compacting
+ * @param COMPACT_RECORDS unsigned long Records kept before compacting, at least 2
+ * @return bool true if Journal is opened & false if not
+ */
+bool Journal_Open(Journal_t* JOURNAL, const char* PATH, unsigned long COMPACT_RECORDS);
+
+
+/** @brief Get State of the newest valid Record, found by Journal_Open() (O(1), no replay)
+ * @param JOURNAL const Journal_t* Opened Journal
+ * @param STATE ControllerState_t* State
+ * @return bool true if there's a Record & false if Journal is empty
+ */
+bool Journal_Restore(const Journal_t* JOURNAL, ControllerState_t* STATE);
+
+
+/** @brief Append a State Record, the Journal is compacted when it reaches COMPACT_RECORDS
+ * @param JOURNAL Journal_t* Opened Journal
+ * @param STATE const ControllerState_t* State
+ * @return bool true if Record is written & false if not
+ */
+bool Journal_Append(Journal_t* JOURNAL, const ControllerState_t* STATE);
+
+
+/** @brief Rewrite the Journal with its newest Record only: PATH.tmp is written & synced then renamed over PATH,
+ * so a crash leaves either the old or the new Journal
+ * @param JOURNAL Journal_t* Opened Journal
+ * @return bool true if Journal is compacted & false if not (old Journal is kept)
+ */
+bool Journal_Compact(Journal_t* JOURNAL);
+
+
+/** @brief Append the Controller State at the end of this tick, call it once every tick after the Switches &
+ * Speed Tasks (it is a Scheduler Task in main.c)
+ * @param JOURNAL Journal_t* Opened Journal
+ * @return bool true if Record is written & false if not
+ */
+bool Journal_Update(Journal_t* JOURNAL);
+
+
+/** @brief Close a Journal
+ * @param JOURNAL Journal_t* Opened Journal
+ * @return void
+ */
+void Journal_Close(Journal_t* JOURNAL);
+
+#endif // JOURNAL_H_INCLUDED
@@ -0,0 +1,123 @@
+/**
+ * @file latency.c
+ * @brief Latency main file
+ * @details Here we keep one log2 Histogram per Switch of the time from a button edge (Update_Switch() sees the
+ * Switch go PRE_PRESSED) to the MotAngle_Write() of the Speed change it caused. Times stay in Event Ring units
+ * (cycles on x86) while adding, they are converted to ns only when read. <br>
+ * A P Switch latency includes the long press itself (Press Time 30 or more)
+ *
+ */
+
+#include <string.h>
+
+ /*    Include Header    */
+#include"latency.h"
+
+ /*    Include Modules    */
+#include"../event_ring/event_ring.h"
+
+/** @brief Histogram of every Switch & last latency of any Switch */
+static LatencyHistogram_t HISTOGRAMS[3];
+static uint64_t LAST;
+
+
+/** @brief Bucket of a latency
+ * @param UNITS uint64_t Latency
+ * @return unsigned int Bucket, number of bits of UNITS
+ */
+static unsigned int Latency_Bucket(uint64_t UNITS){
+    unsigned int Bits = 0;
+
+    while(UNITS != 0 && Bits < LATENCY_BUCKETS - 1){
+        UNITS >>= 1;
+        Bits++;
+    }
+    return Bits;
+}
+
+
+void Latency_Add(Switch_t SW, uint64_t UNITS){
+    LatencyHistogram_t* Histogram;
+
+    if(IsOutOfBounds(SW)){
+        return;
+    }
+    Histogram = &HISTOGRAMS[SW];
+    if(Histogram->Count == 0 || UNITS < Histogram->Min){
+        Histogram->Min = UNITS;
+    }
+    if(UNITS > Histogram->Max){
+        Histogram->Max = UNITS;
+    }
+    Histogram->Count++;
+    Histogram->Sum += UNITS;
+    Histogram->Last = UNITS;
+    Histogram->Buckets[Latency_Bucket(UNITS)]++;
+    LAST = UNITS;
+}
+
+
+bool Latency_Get(Switch_t SW, LatencyHistogram_t* HISTOGRAM){
+    if(IsOutOfBounds(SW)){
+        return false;
+    }
+    *HISTOGRAM = HISTOGRAMS[SW];
+    return true;
+}
+
+
+uint64_t Latency_Ns(uint64_t UNITS){
+    return (uint64_t)((double)UNITS * EventRing_NsPerUnit());
+}
+
+
+uint64_t Latency_PercentileNs(const LatencyHistogram_t* HISTOGRAM, double PERCENT){
+    uint64_t Target = (uint64_t)((double)HISTOGRAM->Count * PERCENT / 100.0 + 0.999999);
+    uint64_t Seen = 0, End;
+    unsigned int i;
+
+    if(HISTOGRAM->Count == 0){
+        return 0;
+    }
+    if(Target == 0){
+        Target = 1;
+    }
+    for(i = 0; i < LATENCY_BUCKETS; i++){
+        Seen += HISTOGRAM->Buckets[i];
+        if(Seen >= Target){
+            break;
+        }
+    }
+
+    /* Bucket i ends at 2^i - 1, no latency is more than Max */
+    End = ((uint64_t)1 << i) - 1;
+    return Latency_Ns(End < HISTOGRAM->Max ? End : HISTOGRAM->Max);
+}
+
+
+uint64_t Latency_LastNs(void){
+    return Latency_Ns(LAST);
+}
+
+
+void Latency_Reset(void){
+    memset(HISTOGRAMS, 0, sizeof(HISTOGRAMS));
+    LAST = 0;
+}
+
+
+void Latency_Print(FILE* OUT){
+    static const char* const SWITCHES[] = {"+ve", "-ve", "P"};
+    const LatencyHistogram_t* Histogram;
+    unsigned int Sw;
+
+    fprintf(OUT, "Button edge to Motor Angle latency (ns)\n%-6s %10s %14s %14s %14s %14s %14s\n",
+            "switch", "count", "min", "p50", "p90", "p99", "max");
+    for(Sw = 0; Sw < 3; Sw++){
+        Histogram = &HISTOGRAMS[Sw];
+        fprintf(OUT, "%-6s %10llu %14llu %14llu %14llu %14llu %14llu\n", SWITCHES[Sw], (unsigned long long)Histogram->Count,
+                (unsigned long long)Latency_Ns(Histogram->Min), (unsigned long long)Latency_PercentileNs(Histogram, 50),
+                (unsigned long long)Latency_PercentileNs(Histogram, 90), (unsigned long long)Latency_PercentileNs(Histogram, 99),
+                (unsigned long long)Latency_Ns(Histogram->Max));
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * @file latency.h
+ * @brief Latency header file
+ */
+
+#ifndef LATENCY_H_INCLUDED
+#define LATENCY_H_INCLUDED
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include"../switches/switch.h"
+
+/** @brief Histogram buckets, bucket 0 holds 0 and bucket i holds [2^(i-1), 2^i) time units, the last one holds the rest */
+#define LATENCY_BUCKETS     48
+
+/** @brief Button edge to Motor Angle change latencies of one Switch, in EventRing_Now() units */
+typedef struct {
+    uint64_t Count;
+    uint64_t Sum;
+    uint64_t Min;
+    uint64_t Max;
+    uint64_t Last;
+    uint64_t Buckets[LATENCY_BUCKETS];
+} LatencyHistogram_t;
+
+
+/** @brief Add a latency of a Switch
+ * @param SW Switch_t Switch whose edge was served
+ * @param UNITS uint64_t Latency in EventRing_Now() units
+ * @return void
+ */
+void Latency_Add(Switch_t SW, uint64_t UNITS);
+
+
+/** @brief Copy the Histogram of a Switch, call it from the Control Loop thread (it is the only writer)
+ * @param SW Switch_t Which Switch
+ * @param HISTOGRAM LatencyHistogram_t* Copy
+ * @return bool true if copied & false if Switch is out of bounds
+ */
+bool Latency_Get(Switch_t SW, LatencyHistogram_t* HISTOGRAM);
+
+
+/** @brief Latency under which a percentage of latencies are, rounded up to its bucket end
+ * @param HISTOGRAM const LatencyHistogram_t* Histogram
+ * @param PERCENT double 0 to 100
+ * @return uint64_t Latency in ns, 0 if Histogram is empty
+ */
+uint64_t Latency_PercentileNs(const LatencyHistogram_t* HISTOGRAM, double PERCENT);
+
+
+/** @brief Convert time units to ns
+ * @param UNITS uint64_t Time in EventRing_Now() units
+ * @return uint64_t Time in ns
+ */
+uint64_t Latency_Ns(uint64_t UNITS);
+
+
+/** @brief Last latency of any Switch
+ * @param void
+ * @return uint64_t Latency in ns, 0 if there's none yet
+ */
+uint64_t Latency_LastNs(void);
+
+
+/** @brief Forget all latencies
+ * @param void
+ * @return void
+ */
+void Latency_Reset(void);
+
+
+/** @brief Print count, min, p50, p90, p99 & max of every Switch
+ * @param OUT FILE* Where to print
+ * @return void
+ */
+void Latency_Print(FILE* OUT);
+
+#endif // LATENCY_H_INCLUDED
@@ -2,60 +2,218 @@
  * @file main.c
  * @author Omar Hesham
  * @brief The main file
- * @details Here we call unity test harness to do tests and update switches & speedcontrol  in main()
+ * @details Here we initialize switches & speedcontrol then update them every tick forever in main(),
+ * all tests are in the Tests build (test/test_main.c) so the Controller starts at once. <br>
+ * If the Controller crashes, the last Events are written to events.bin (decode it with event_dump tool) <br>
+ * Run with -c FILE to write the tick timeline as a Chrome Trace (open it in chrome://tracing or ui.perfetto.dev),
+ * the Trace is closed on SIGINT or SIGTERM. <br>
+ * Run with -s NAME to publish live Counters in shared memory NAME (watch them with telemetry_monitor tool). <br>
+ * Button edge to Motor Angle latencies are printed when the Controller stops. <br>
+ * The selected Speed is kept in speed.nv (or -p FILE) and the Controller starts at it next time. <br>
+ * Run with -j FILE to journal the full State every tick, a restarted Controller carries on from its last tick. <br>
+ * Run with -u SOCKET to drive the Switches with Commands on a UNIX socket (e.g. echo "press +ve" | nc -U SOCKET). <br>
+ * Run with -P FILE to take Motor Angles & P long press threshold from a Speed Profile File, it is used again
+ * every time it is saved without stopping the Controller
  *
  */
 
 /*    Include Standard Libraries of input-output stream    */
 #include <stdio.h>
-#include <stdlib.h>
-
-/*    Include Unity    */
-#include "../test/unity/unity_fixture.h"
-#define MAKE_UNITY_VERBOSE	argc = 2; argv[1] = "-v"
+#include <string.h>
+#include <signal.h>
 
 /*    Include Modules    */
 #include "switches/switch.h"
 #include "speedcontrol/speedcontrol.h"
+#include "event_ring/event_ring.h"
+#include "scheduler/scheduler.h"
+#include "chrome_trace/chrome_trace.h"
+#include "telemetry/telemetry.h"
+#include "latency/latency.h"
+#include "persist/persist.h"
+#include "journal/journal.h"
+#include "command/command.h"
+#include "profile/profile.h"
+
+/** @brief Set by SIGINT or SIGTERM to stop the Control Loop */
+static volatile sig_atomic_t STOP;
+
+/** @brief Shared memory Counters */
+static Telemetry_t TELEMETRY;
+
+/** @brief Non-volatile Speed Store */
+static PersistStore_t STORE;
+
+/** @brief Controller State Journal, not opened without -j */
+static Journal_t JOURNAL;
+
 
-/** @brief Test Groups Runner */
-static void RunAllTests(void){
-    RUN_TEST_GROUP(SET);
-    RUN_TEST_GROUP(INIT);
-    RUN_TEST_GROUP(UPDATE);
+/** @brief Control Loop Tasks, Update_Switch takes a Switch & MotAngle_Write returns the Angle */
+static void Update_P(void){
+    Update_Switch(P);
 }
 
-/** @brief main function run all Test Groups & SpeedControl Module
+static void Update_Postive(void){
+    Update_Switch(POSTIVE);
+}
+
+static void Update_Negative(void){
+    Update_Switch(NEGATIVE);
+}
+
+static void Write_Angle(void){
+    MotAngle_Write();
+}
+
+static void Save_Speed(void){
+    Persist_Update(&STORE, Speed_Get());
+}
+
+static void Save_State(void){
+    if(JOURNAL.File != NULL){
+        Journal_Update(&JOURNAL);
+    }
+}
+
+static void Publish_Telemetry(void){
+    Telemetry_Update(&TELEMETRY);
+}
+
+/** @brief Tasks run every tick in order, Telemetry is last so it is left out without -s */
+static const SchedTask_t TASKS[] = {
+    {"Command_Poll",            Command_Poll},
+    {"Update_Switch(P)",        Update_P},
+    {"Update_Switch(+ve)",      Update_Postive},
+    {"Update_Switch(-ve)",      Update_Negative},
+    {"Speed_Update",            Speed_Update},
+    {"MotAngle_Write",          Write_Angle},
+    {"Persist_Update",          Save_Speed},
+    {"Journal_Update",          Save_State},
+    {"Profile_Tick",            Profile_Tick},
+    {"Telemetry",               Publish_Telemetry},
+};
+
+#define TASKS_COUNT     (sizeof(TASKS) / sizeof(TASKS[0]))
+
+
+/** @brief Stop the Control Loop at the end of this tick
+ * @param SIG int Signal number
+ * @return void
+ */
+static void Stop(int SIG){
+    (void)SIG;
+    STOP = 1;
+}
+
+
+/** @brief main function run SpeedControl Module
  *
  * @param argc int
  * @param argv[] char*
  * @return int 0 if all is fine & 1 if there's an error
  */
-int main(int argc, char * argv[])
+int main(int argc, char* argv[])
 {
-    /*    Make Unity verbose rather than using Command Line    */
-    MAKE_UNITY_VERBOSE;
+    const char* TracePath = NULL;
+    const char* TelemetryName = NULL;
+    const char* StorePath = "speed.nv";
+    const char* JournalPath = NULL;
+    const char* SocketPath = NULL;
+    const char* ProfilePath = NULL;
+    MotorSpeed_t Saved;
+    ControllerState_t State;
+    int Arg;
 
-    /*    Call Unity Main    */
-    UnityMain(argc, argv, RunAllTests);
+    for(Arg = 1; Arg + 1 < argc; Arg += 2){
+        if(strcmp(argv[Arg], "-c") == 0){
+            TracePath = argv[Arg + 1];
+        }else if(strcmp(argv[Arg], "-s") == 0){
+            TelemetryName = argv[Arg + 1];
+        }else if(strcmp(argv[Arg], "-p") == 0){
+            StorePath = argv[Arg + 1];
+        }else if(strcmp(argv[Arg], "-j") == 0){
+            JournalPath = argv[Arg + 1];
+        }else if(strcmp(argv[Arg], "-u") == 0){
+            SocketPath = argv[Arg + 1];
+        }else if(strcmp(argv[Arg], "-P") == 0){
+            ProfilePath = argv[Arg + 1];
+        }else{
+            break;
+        }
+    }
+    if(Arg != argc){
+        fprintf(stderr, "Usage: %s [-c TRACE_JSON] [-s SHM_NAME] [-p SPEED_FILE] [-j JOURNAL_FILE] [-u SOCKET] [-P PROFILE_FILE]\n", argv[0]);
+        return 1;
+    }
 
     printf("App is Running.....");
+    EventRing_DumpOnCrash("events.bin");
     SW_Init(P);
     SW_Init(POSTIVE);
     SW_Init(NEGATIVE);
     Speed_Init();
 
-    while(1){
-
-        Update_Switch(P);
-        Update_Switch(POSTIVE);
-        Update_Switch(NEGATIVE);
+    if(!Persist_Open(&STORE, StorePath, PERSIST_STABLE_MS)){
+        fprintf(stderr, "Failed To open %s\n", StorePath);
+        return 1;
+    }
+    if(Persist_Load(&STORE, &Saved)){
+        Speed_Set(Saved);
+    }
+    if(TracePath != NULL){
+        if(!ChromeTrace_Open(TracePath)){
+            fprintf(stderr, "Failed To create %s\n", TracePath);
+            return 1;
+        }
+        Sched_OnTask = ChromeTrace_Task;
+        Sched_OnTick = ChromeTrace_Tick;
+    }
+    if(TelemetryName != NULL && !Telemetry_Create(&TELEMETRY, TelemetryName, 1)){
+        fprintf(stderr, "Failed To create %s\n", TelemetryName);
+        return 1;
+    }
+    if(ProfilePath != NULL && !Profile_Watch(ProfilePath, PROFILE_WATCH_MS)){
+        fprintf(stderr, "Failed To load %s\n", ProfilePath);
+        return 1;
+    }
+    if(SocketPath != NULL && !Command_Open(SocketPath)){
+        fprintf(stderr, "Failed To listen on %s\n", SocketPath);
+        return 1;
+    }
+    signal(SIGINT, Stop);
+    signal(SIGTERM, Stop);
 
-        Speed_Update();
-        MotAngle_Write();
+    Sched_Init(TASKS, (TelemetryName != NULL) ? TASKS_COUNT : TASKS_COUNT - 1);
+    if(JournalPath != NULL){
+        if(!Journal_Open(&JOURNAL, JournalPath, JOURNAL_COMPACT_RECORDS)){
+            fprintf(stderr, "Failed To open %s\n", JournalPath);
+            return 1;
+        }
+        if(Journal_Restore(&JOURNAL, &State) && Journal_Apply(&State)){
+            printf("Resumed at tick %lu.....", State.Ticks);
+        }
+    }
+    while(!STOP){
+        Sched_RunTick();
+        Sched_WaitNextTick();
     }
 
+    printf("\n");
+    Latency_Print(stdout);
+    if(!Persist_Flush(&STORE)){
+        fprintf(stderr, "Failed To write %s\n", StorePath);
+    }
+    Persist_Close(&STORE);
+    Journal_Close(&JOURNAL);
+    Command_Close();
+    Profile_Unwatch();
+    if(TelemetryName != NULL){
+        Telemetry_Close(&TELEMETRY);
+        Telemetry_Remove(TelemetryName);
+    }
+    if(TracePath != NULL && !ChromeTrace_Close()){
+        fprintf(stderr, "Failed To write %s\n", TracePath);
+        return 1;
+    }
     return 0;
 }
-
-
@@ -0,0 +1,298 @@
+/**
+ * @file persist.c
+ * @brief Persistent Speed main file
+ * @details Here we keep the selected Speed over power off in a small non-volatile Store (a File on the PC
+ * standing in for EEPROM), so Speed_Init() can be followed by the Speed the unit had. <br>
+ * EEPROM cells wear out after some 100k writes, so writes are deferred & coalesced: pressing the buttons many
+ * times writes only the Speed the user stops at, once it is kept for STABLE_MS. Every write goes to the next Slot
+ * (round robin) with a bigger Seq and a CRC-32, a torn write only loses its own Record and the one before it is used. <br>
+ * A Record is synced to the disk before it counts as saved. A sync can take milliseconds on flash, a big part of a
+ * 20 ms tick, so Records are written & synced by a Writer thread and Persist_Update() only hands the Speed over
+ *
+ */
+
+#include <string.h>
+
+ /*    Include Header    */
+#include"persist.h"
+
+ /*    Include Modules    */
+#include"../crc/crc32.h"
+#include"../file_sync/file_sync.h"
+#include"../switches/switch.h"
+
+
+/** @brief Store 32 bits little endian
+ * @param BYTES uint8_t* 4 bytes
+ * @param VALUE uint32_t Value
+ * @return void
+ */
+static void Persist_Put32(uint8_t* BYTES, uint32_t VALUE){
+    BYTES[0] = (uint8_t)VALUE;
+    BYTES[1] = (uint8_t)(VALUE >> 8);
+    BYTES[2] = (uint8_t)(VALUE >> 16);
+    BYTES[3] = (uint8_t)(VALUE >> 24);
+}
+
+
+/** @brief Load 32 bits little endian
+ * @param BYTES const uint8_t* 4 bytes
+ * @return uint32_t Value
+ */
+static uint32_t Persist_Get32(const uint8_t* BYTES){
+    return (uint32_t)BYTES[0] | ((uint32_t)BYTES[1] << 8) | ((uint32_t)BYTES[2] << 16) | ((uint32_t)BYTES[3] << 24);
+}
+
+
+/** @brief Read one Slot and check its Record
+ * @param STORE const PersistStore_t* Opened Store
+ * @param SLOT unsigned int Slot
+ * @param SPEED MotorSpeed_t* Record Speed
+ * @param SEQ uint32_t* Record Seq
+ * @return bool true if Slot has a valid Record & false if it is empty or torn
+ */
+static bool Persist_ReadSlot(const PersistStore_t* STORE, unsigned int SLOT, MotorSpeed_t* SPEED, uint32_t* SEQ){
+    uint8_t Record[PERSIST_RECORD_SIZE];
+
+    if(fseek(STORE->File, (long)SLOT * PERSIST_RECORD_SIZE, SEEK_SET) != 0 ||
+       fread(Record, 1, sizeof(Record), STORE->File) != sizeof(Record)){
+        return false;
+    }
+    if(Record[0] != PERSIST_MAGIC || Record[1] != PERSIST_VERSION || Record[2] > MAX ||
+       Crc32(Record, 8) != Persist_Get32(Record + 8)){
+        return false;
+    }
+    *SPEED = (MotorSpeed_t)Record[2];
+    *SEQ = Persist_Get32(Record + 4);
+    return true;
+}
+
+
+/** @brief Write a Record with the next Seq to the next Slot & sync it, then it is the saved one.
+ * Only one write runs at once (Busy or no Writer), so Slot & Seq are read without Lock
+ * @param STORE PersistStore_t* Opened Store
+ * @param SPEED MotorSpeed_t Speed
+ * @return bool true if Record is written & false if not
+ */
+static bool Persist_Write(PersistStore_t* STORE, MotorSpeed_t SPEED){
+    uint8_t Record[PERSIST_RECORD_SIZE];
+    unsigned int Slot = (STORE->Slot + 1) % PERSIST_SLOTS;
+    uint32_t Seq = STORE->Seq + 1;
+
+    Record[0] = PERSIST_MAGIC;
+    Record[1] = PERSIST_VERSION;
+    Record[2] = (uint8_t)SPEED;
+    Record[3] = 0;
+    Persist_Put32(Record + 4, Seq);
+    Persist_Put32(Record + 8, Crc32(Record, 8));
+
+    if(fseek(STORE->File, (long)Slot * PERSIST_RECORD_SIZE, SEEK_SET) != 0 ||
+       fwrite(Record, 1, sizeof(Record), STORE->File) != sizeof(Record) ||
+       !File_Sync(STORE->File)){
+        return false;
+    }
+    pthread_mutex_lock(&STORE->Lock);
+    STORE->Slot = Slot;
+    STORE->Seq = Seq;
+    STORE->Saved = SPEED;
+    STORE->HasSaved = true;
+    STORE->Writes++;
+    pthread_mutex_unlock(&STORE->Lock);
+    return true;
+}
+
+
+/** @brief Writer thread, it writes every Speed handed over by Persist_Update() till the Store is closed
+ * @param ARG void* PersistStore_t
+ * @return void* NULL
+ */
+static void* Persist_Writer(void* ARG){
+    PersistStore_t* Store = ARG;
+    MotorSpeed_t Speed;
+    bool Ok;
+
+    pthread_mutex_lock(&Store->Lock);
+    for(;;){
+        while(!Store->Busy && !Store->Quit){
+            pthread_cond_wait(&Store->Wake, &Store->Lock);
+        }
+
+        /* A Record given before Quit is still written */
+        if(!Store->Busy){
+            break;
+        }
+        Speed = Store->Request;
+        pthread_mutex_unlock(&Store->Lock);
+
+        Ok = Persist_Write(Store, Speed);
+
+        pthread_mutex_lock(&Store->Lock);
+        Store->Failed = !Ok;
+        Store->Busy = false;
+        pthread_cond_broadcast(&Store->Done);
+    }
+    pthread_mutex_unlock(&Store->Lock);
+    return NULL;
+}
+
+
+bool Persist_Open(PersistStore_t* STORE, const char* PATH, unsigned long STABLE_MS){
+    MotorSpeed_t Speed;
+    uint32_t Seq;
+    unsigned int Slot;
+
+    memset(STORE, 0, sizeof(*STORE));
+    STORE->File = fopen(PATH, "r+b");
+    if(STORE->File == NULL){
+        STORE->File = fopen(PATH, "w+b");
+        if(STORE->File == NULL){
+            return false;
+        }
+    }
+    STORE->StableTicks = (STABLE_MS + SW_TICK_MS - 1) / SW_TICK_MS;
+    STORE->Slot = PERSIST_SLOTS - 1;
+    STORE->Candidate = MED;
+
+    /* Newest Record has the biggest Seq, compared on a circle so Seq may wrap */
+    for(Slot = 0; Slot < PERSIST_SLOTS; Slot++){
+        if(Persist_ReadSlot(STORE, Slot, &Speed, &Seq) &&
+           (!STORE->HasSaved || (int32_t)(Seq - STORE->Seq) > 0)){
+            STORE->Saved = Speed;
+            STORE->Seq = Seq;
+            STORE->Slot = Slot;
+            STORE->HasSaved = true;
+        }
+    }
+    if(STORE->HasSaved){
+        STORE->Candidate = STORE->Saved;
+    }
+
+    pthread_mutex_init(&STORE->Lock, NULL);
+    pthread_cond_init(&STORE->Wake, NULL);
+    pthread_cond_init(&STORE->Done, NULL);
+    STORE->Threaded = pthread_create(&STORE->Writer, NULL, Persist_Writer, STORE) == 0;
+    return true;
+}
+
+
+bool Persist_Load(PersistStore_t* STORE, MotorSpeed_t* SPEED){
+    bool Ok;
+
+    if(STORE->File == NULL){
+        return false;
+    }
+    pthread_mutex_lock(&STORE->Lock);
+    Ok = STORE->HasSaved;
+    if(Ok){
+        *SPEED = STORE->Saved;
+    }
+    pthread_mutex_unlock(&STORE->Lock);
+    return Ok;
+}
+
+
+void Persist_Update(PersistStore_t* STORE, MotorSpeed_t SPEED){
+    bool Write = false;
+
+    if(STORE->File == NULL){
+        return;
+    }
+    if(SPEED != STORE->Candidate){
+        STORE->Candidate = SPEED;
+        STORE->Stable = 0;
+
+    }else if(STORE->Stable < STORE->StableTicks){
+        STORE->Stable++;
+    }
+
+    if(STORE->Stable < STORE->StableTicks){
+        return;
+    }
+
+    /* Lock is never held by Writer over the disk, so the tick doesn't wait for a sync */
+    pthread_mutex_lock(&STORE->Lock);
+    if(STORE->Failed){
+        /* A failed write is tried again after another STABLE_MS, not every tick */
+        STORE->Failed = false;
+        STORE->Stable = 0;
+
+    }else if(!STORE->Busy && !(STORE->HasSaved && STORE->Candidate == STORE->Saved)){
+        if(STORE->Threaded){
+            STORE->Request = STORE->Candidate;
+            STORE->Busy = true;
+            pthread_cond_signal(&STORE->Wake);
+        }else{
+            Write = true;
+        }
+    }
+    pthread_mutex_unlock(&STORE->Lock);
+
+    if(Write && !Persist_Write(STORE, STORE->Candidate)){
+        STORE->Stable = 0;
+    }
+}
+
+
+bool Persist_Flush(PersistStore_t* STORE){
+    bool Saved;
+
+    if(STORE->File == NULL){
+        return false;
+    }
+
+    /* Writer is idle after this and gets nothing new, the caller is the one giving it Speeds */
+    Persist_Wait(STORE);
+    pthread_mutex_lock(&STORE->Lock);
+    Saved = STORE->HasSaved && STORE->Candidate == STORE->Saved;
+    STORE->Failed = false;
+    pthread_mutex_unlock(&STORE->Lock);
+
+    return Saved || Persist_Write(STORE, STORE->Candidate);
+}
+
+
+void Persist_Wait(PersistStore_t* STORE){
+
+    if(STORE->File == NULL){
+        return;
+    }
+    pthread_mutex_lock(&STORE->Lock);
+    while(STORE->Busy){
+        pthread_cond_wait(&STORE->Done, &STORE->Lock);
+    }
+    pthread_mutex_unlock(&STORE->Lock);
+}
+
+
+unsigned long Persist_Writes(PersistStore_t* STORE){
+    unsigned long Writes;
+
+    if(STORE->File == NULL){
+        return STORE->Writes;
+    }
+    pthread_mutex_lock(&STORE->Lock);
+    Writes = STORE->Writes;
+    pthread_mutex_unlock(&STORE->Lock);
+    return Writes;
+}
+
+
+void Persist_Close(PersistStore_t* STORE){
+
+    if(STORE->File == NULL){
+        return;
+    }
+    if(STORE->Threaded){
+        pthread_mutex_lock(&STORE->Lock);
+        STORE->Quit = true;
+        pthread_cond_signal(&STORE->Wake);
+        pthread_mutex_unlock(&STORE->Lock);
+        pthread_join(STORE->Writer, NULL);
+        STORE->Threaded = false;
+    }
+    pthread_cond_destroy(&STORE->Done);
+    pthread_cond_destroy(&STORE->Wake);
+    pthread_mutex_destroy(&STORE->Lock);
+    fclose(STORE->File);
+    STORE->File = NULL;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file persist.h
+ * @brief Persistent Speed header file
+ */
+
+#ifndef PERSIST_H_INCLUDED
+#define PERSIST_H_INCLUDED
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include"../speedcontrol/speedcontrol.h"
+
+/** @brief Record: 'S' | version | Speed | 0 | Seq (4 bytes LE) | CRC-32 of first 8 bytes (4 bytes LE) */
+#define PERSIST_MAGIC           'S'
+#define PERSIST_VERSION         1
+#define PERSIST_RECORD_SIZE     12
+
+/** @brief Records are written round robin over the Slots so every Slot wears the same */
+#ifndef PERSIST_SLOTS
+#define PERSIST_SLOTS           8
+#endif
+
+/** @brief Speed must be kept this long before it is written */
+#ifndef PERSIST_STABLE_MS
+#define PERSIST_STABLE_MS       2000
+#endif
+
+/** @brief An opened Store, a File standing in for EEPROM */
+typedef struct {
+    FILE* File;
+    unsigned long StableTicks;      /* Ticks a Speed is kept before it is written */
+    unsigned long Stable;           /* Ticks Candidate is kept till now */
+    MotorSpeed_t Candidate;         /* Last Speed given to Persist_Update() */
+    MotorSpeed_t Saved;             /* Speed of newest Record */
+    bool HasSaved;
+    uint32_t Seq;                   /* Seq of newest Record */
+    unsigned int Slot;              /* Slot of newest Record */
+    unsigned long Writes;
+
+    /* Writer thread, it writes & syncs Records off the tick. Saved, HasSaved, Seq, Slot, Writes & below are
+     * shared with it under Lock */
+    pthread_t Writer;
+    pthread_mutex_t Lock;
+    pthread_cond_t Wake;
+    pthread_cond_t Done;
+    bool Threaded;                  /* Writer is running, else Records are written by Persist_Update() */
+    bool Quit;
+    bool Busy;                      /* A Record is being written */
+    bool Failed;                    /* Last write failed */
+    MotorSpeed_t Request;           /* Speed given to Writer */
+} PersistStore_t;
+
+
+/** @brief Open (or create) a Store and find its newest valid Record, Records with a bad CRC (torn writes) are skipped.
+ * The Writer thread is started, if it can't start Records are written by Persist_Update() itself
+ * @param STORE PersistStore_t* Store to open
+ * @param PATH const char* Store File path
+ * @param STABLE_MS unsigned long Time a Speed must be kept before it is written, 0 writes every change
+ * @return bool true if Store is opened & false if not
+ */
+bool Persist_Open(PersistStore_t* STORE, const char* PATH, unsigned long STABLE_MS);
+
+
+/** @brief Get Speed of the newest valid Record
+ * @param STORE const PersistStore_t* Opened Store
+ * @param SPEED MotorSpeed_t* Saved Speed
+ * @return bool true if there's a saved Speed & false if Store is empty
+ */
+bool Persist_Load(PersistStore_t* STORE, MotorSpeed_t* SPEED);
+
+
+/** @brief Give current Speed to the Store, call it once every tick (it is a Scheduler Task in main.c).
+ * Changes are coalesced: a Speed is written only after it is kept for STABLE_MS and only if it isn't saved already.
+ * It is handed to the Writer thread so the tick never waits for the disk, it is saved once its sync is done.
+ * Changes while a Record is being written are coalesced into the next write
+ * @param STORE PersistStore_t* Opened Store
+ * @param SPEED MotorSpeed_t Current Speed
+ * @return void
+ */
+void Persist_Update(PersistStore_t* STORE, MotorSpeed_t SPEED);
+
+
+/** @brief Write last Speed given to Persist_Update() now if it isn't saved, e.g. before power off.
+ * It waits for the Record being written first
+ * @param STORE PersistStore_t* Opened Store
+ * @return bool true if Speed is saved & false if the write failed
+ */
+bool Persist_Flush(PersistStore_t* STORE);
+
+
+/** @brief Wait till the Record being written by the Writer thread is synced (or failed)
+ * @param STORE PersistStore_t* Opened Store
+ * @return void
+ */
+void Persist_Wait(PersistStore_t* STORE);
+
+
+/** @brief Number of Records written & synced since Persist_Open()
+ * @param STORE PersistStore_t* Opened Store
+ * @return unsigned long Writes
+ */
+unsigned long Persist_Writes(PersistStore_t* STORE);
+
+
+/** @brief Close a Store, the Record being written is finished, Speed not given to a write yet is lost
+ * (call Persist_Flush() first to keep it)
+ * @param STORE PersistStore_t* Opened Store
+ * @return void
+ */
+void Persist_Close(PersistStore_t* STORE);
+
+#endif // PERSIST_H_INCLUDED
@@ -0,0 +1,85 @@
+/**
+ * @file probes.h
+ * @brief Static Probes header file
+ * @details Here we define USDT static probes (provider "speedcontrol") at the Control Loop decision points,
+ * so a deployed Controller can be traced on Linux with bpftrace, perf or SystemTap without rebuilding it: <br>
+ * bpftrace -e 'usdt:./speedcontrol_omar_hesham:speedcontrol:increase { printf("%d -> %d\n", arg1, arg2); }' <br>
+ * A probe is one nop plus a note in the .note.stapsdt section telling the tracer where the nop is and where its
+ * arguments are, so it costs nothing till a tracer puts a breakpoint on it. <br>
+ * Probes are built in when SPEEDCONTROL_PROBES is defined (every build target defines it). <sys/sdt.h> is used
+ * where it is installed, x86-64 ELF builds write the same notes themselves, other builds have no probes <br>
+ * Probes: rule_p_long_press(ctl, speed, press_time), rule_negative(ctl, speed), rule_postive(ctl, speed),
+ * increase(ctl, old, new), increase_clamped(ctl, speed), decrease(ctl, old, new), decrease_clamped(ctl, speed),
+ * switch_state(switch, old, new, press_time)
+ */
+
+#ifndef PROBES_H_INCLUDED
+#define PROBES_H_INCLUDED
+
+#if defined(SPEEDCONTROL_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define SPEED_PROBES_SDT        1
+#endif
+#endif
+
+#if defined(SPEEDCONTROL_PROBES) && defined(SPEED_PROBES_SDT)
+
+#include <sys/sdt.h>
+
+#define SPEED_PROBE1(NAME, A)               DTRACE_PROBE1(speedcontrol, NAME, A)
+#define SPEED_PROBE2(NAME, A, B)            DTRACE_PROBE2(speedcontrol, NAME, A, B)
+#define SPEED_PROBE3(NAME, A, B, C)         DTRACE_PROBE3(speedcontrol, NAME, A, B, C)
+#define SPEED_PROBE4(NAME, A, B, C, D)      DTRACE_PROBE4(speedcontrol, NAME, A, B, C, D)
+
+#elif defined(SPEEDCONTROL_PROBES) && defined(__x86_64__) && defined(__ELF__) && defined(__GNUC__)
+
+/** @brief SystemTap SDT version 3 note, same as <sys/sdt.h> writes: probe address, base address, no semaphore,
+ * provider, name & arguments ("8@%0" = 8 bytes unsigned at operand 0) */
+#define SPEED_PROBE_NOTE(NAME, ARGS, ...)                                               \
+    __asm__ __volatile__(                                                               \
+        "990: nop\n"                                                                    \
+        ".pushsection .note.stapsdt,\"?\",\"note\"\n"                                   \
+        ".balign 4\n"                                                                   \
+        ".4byte 992f-991f, 994f-993f, 3\n"                                              \
+        "991: .asciz \"stapsdt\"\n"                                                     \
+        "992: .balign 4\n"                                                              \
+        "993: .8byte 990b\n"                                                            \
+        ".8byte _.stapsdt.base\n"                                                       \
+        ".8byte 0\n"                                                                    \
+        ".asciz \"speedcontrol\"\n"                                                     \
+        ".asciz \"" #NAME "\"\n"                                                        \
+        ".asciz \"" ARGS "\"\n"                                                         \
+        "994: .balign 4\n"                                                              \
+        ".popsection\n"                                                                 \
+        ".ifndef _.stapsdt.base\n"                                                      \
+        ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"         \
+        ".weak _.stapsdt.base\n"                                                        \
+        ".hidden _.stapsdt.base\n"                                                      \
+        "_.stapsdt.base: .space 1\n"                                                    \
+        ".size _.stapsdt.base, 1\n"                                                     \
+        ".popsection\n"                                                                 \
+        ".endif\n"                                                                      \
+        : : __VA_ARGS__)
+
+#define SPEED_PROBE_ARG(X)      "nor"((unsigned long)(X))
+
+#define SPEED_PROBE1(NAME, A)                                                           \
+    SPEED_PROBE_NOTE(NAME, "8@%0", SPEED_PROBE_ARG(A))
+#define SPEED_PROBE2(NAME, A, B)                                                        \
+    SPEED_PROBE_NOTE(NAME, "8@%0 8@%1", SPEED_PROBE_ARG(A), SPEED_PROBE_ARG(B))
+#define SPEED_PROBE3(NAME, A, B, C)                                                     \
+    SPEED_PROBE_NOTE(NAME, "8@%0 8@%1 8@%2", SPEED_PROBE_ARG(A), SPEED_PROBE_ARG(B), SPEED_PROBE_ARG(C))
+#define SPEED_PROBE4(NAME, A, B, C, D)                                                  \
+    SPEED_PROBE_NOTE(NAME, "8@%0 8@%1 8@%2 8@%3", SPEED_PROBE_ARG(A), SPEED_PROBE_ARG(B),  \
+                     SPEED_PROBE_ARG(C), SPEED_PROBE_ARG(D))
+
+#else
+
+#define SPEED_PROBE1(NAME, A)               ((void)0)
+#define SPEED_PROBE2(NAME, A, B)            ((void)0)
+#define SPEED_PROBE3(NAME, A, B, C)         ((void)0)
+#define SPEED_PROBE4(NAME, A, B, C, D)      ((void)0)
+
+#endif
+
+#endif // PROBES_H_INCLUDED
@@ -0,0 +1,236 @@
+/**
+ * @file profile.c
+ * @brief Speed Profile main file
+ * @details Here we let the Speed to Motor Angle mapping & P long press threshold be tuned while the Controller runs,
+ * instead of rebuilding & restarting it for every try on the test floor. <br>
+ * A new Profile is read & checked off the Control Loop (watcher thread), copied to its own memory and published
+ * by swapping one atomic pointer, so a Speed Update sees the old or the new Profile, never half of one, and never
+ * waits. The replaced Profile may still be read by the tick running now, so it is kept till the end of the next
+ * tick: Profile_Tick() takes the Profiles replaced till now and frees them one tick later
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+ /*    Include Header    */
+#include"profile.h"
+
+/** @brief A published Profile & the next replaced one, Profile is first so both have the same address */
+typedef struct ProfileNode_s {
+    SpeedProfile_t Profile;
+    struct ProfileNode_s* Next;
+} ProfileNode_t;
+
+const SpeedProfile_t PROFILE_DEFAULT = {{140, 90, 10}, 30};
+
+/** @brief Profile in use */
+static _Atomic(const SpeedProfile_t*) CURRENT = &PROFILE_DEFAULT;
+
+/** @brief Profiles replaced since last Profile_Tick() (pushed by publishers) & Profiles freed on next Profile_Tick() */
+static _Atomic(ProfileNode_t*) RETIRED;
+static ProfileNode_t* PENDING;
+static atomic_uint RETIRED_COUNT;
+
+/** @brief Watched Profile File */
+static pthread_t WATCHER;
+static atomic_bool WATCHING;
+static const char* WATCH_PATH;
+static unsigned long WATCH_MS;
+static SpeedProfile_t WATCH_LAST;
+
+
+const SpeedProfile_t* Profile_Current(void){
+    return atomic_load_explicit(&CURRENT, memory_order_acquire);
+}
+
+
+bool Profile_IsValid(const SpeedProfile_t* PROFILE){
+    unsigned int i;
+
+    for(i = 0; i < 3; i++){
+        if(PROFILE->Angles[i] < 0 || PROFILE->Angles[i] > PROFILE_MAX_ANGLE){
+            return false;
+        }
+    }
+    return PROFILE->LongPress != 0;
+}
+
+
+/** @brief Free a list of replaced Profiles
+ * @param NODE ProfileNode_t* First Profile
+ * @return void
+ */
+static void Profile_Free(ProfileNode_t* NODE){
+    ProfileNode_t* Next;
+
+    while(NODE != NULL){
+        Next = NODE->Next;
+        free(NODE);
+        atomic_fetch_sub_explicit(&RETIRED_COUNT, 1, memory_order_relaxed);
+        NODE = Next;
+    }
+}
+
+
+bool Profile_Publish(const SpeedProfile_t* PROFILE){
+    ProfileNode_t* Node;
+    ProfileNode_t* Old;
+    const SpeedProfile_t* Replaced;
+
+    if(!Profile_IsValid(PROFILE)){
+        return false;
+    }
+    Node = malloc(sizeof(ProfileNode_t));
+    if(Node == NULL){
+        return false;
+    }
+    Node->Profile = *PROFILE;
+    Node->Next = NULL;
+
+    Replaced = atomic_exchange_explicit(&CURRENT, &Node->Profile, memory_order_acq_rel);
+    if(Replaced != &PROFILE_DEFAULT){
+        Old = (ProfileNode_t*)(void*)Replaced;
+        atomic_fetch_add_explicit(&RETIRED_COUNT, 1, memory_order_relaxed);
+        Old->Next = atomic_load_explicit(&RETIRED, memory_order_relaxed);
+        while(!atomic_compare_exchange_weak_explicit(&RETIRED, &Old->Next, Old, memory_order_release, memory_order_relaxed)){
+            /* Another publisher pushed first, Old->Next is updated */
+        }
+    }
+    return true;
+}
+
+
+void Profile_Tick(void){
+    /* Profiles taken on last tick aren't read by anyone since that tick ended */
+    Profile_Free(PENDING);
+    PENDING = atomic_exchange_explicit(&RETIRED, NULL, memory_order_acquire);
+}
+
+
+unsigned int Profile_Retired(void){
+    return atomic_load_explicit(&RETIRED_COUNT, memory_order_relaxed);
+}
+
+
+bool Profile_Load(const char* PATH, SpeedProfile_t* PROFILE){
+    static const char* const KEYS[] = {"min", "med", "max"};
+    char Line[128], Key[16], Extra;
+    char* Comment;
+    long Value;
+    unsigned int i;
+    int Read;
+    FILE* File;
+    bool Ok = true;
+
+    File = fopen(PATH, "r");
+    if(File == NULL){
+        return false;
+    }
+    *PROFILE = PROFILE_DEFAULT;
+
+    while(Ok && fgets(Line, sizeof(Line), File) != NULL){
+        Comment = strchr(Line, '#');
+        if(Comment != NULL){
+            *Comment = '\0';
+        }
+        Read = sscanf(Line, "%15s %ld %c", Key, &Value, &Extra);
+        if(Read == EOF){
+            continue;
+        }
+        Ok = (Read == 2);
+        if(!Ok){
+            break;
+        }
+
+        if(strcmp(Key, "long_press") == 0){
+            Ok = (Value > 0 && Value <= 255);
+            PROFILE->LongPress = (unsigned char)Value;
+        }else{
+            for(i = 0; i < 3 && strcmp(Key, KEYS[i]) != 0; i++){
+            }
+            Ok = (i < 3 && Value >= 0 && Value <= PROFILE_MAX_ANGLE);
+            if(Ok){
+                PROFILE->Angles[i] = (short)Value;
+            }
+        }
+    }
+    fclose(File);
+    return Ok && Profile_IsValid(PROFILE);
+}
+
+
+/** @brief Watcher thread, it reads the Profile File every WATCH_MS (it is a few bytes) and publishes it when its
+ * values change. A bad File is left out and the Profile in use is kept
+ * @param ARG void* Not used
+ * @return void* NULL
+ */
+static void* Profile_Watcher(void* ARG){
+    SpeedProfile_t Profile;
+
+    (void)ARG;
+    while(atomic_load(&WATCHING)){
+#ifdef _WIN32
+        Sleep((DWORD)WATCH_MS);
+#else
+        {
+            struct timespec Time;
+
+            Time.tv_sec = (time_t)(WATCH_MS / 1000);
+            Time.tv_nsec = (long)(WATCH_MS % 1000) * 1000000L;
+            nanosleep(&Time, NULL);
+        }
+#endif
+        if(Profile_Load(WATCH_PATH, &Profile) &&
+           (memcmp(Profile.Angles, WATCH_LAST.Angles, sizeof(Profile.Angles)) != 0 || Profile.LongPress != WATCH_LAST.LongPress) &&
+           Profile_Publish(&Profile)){
+            WATCH_LAST = Profile;
+        }
+    }
+    return NULL;
+}
+
+
+bool Profile_Watch(const char* PATH, unsigned long INTERVAL_MS){
+    SpeedProfile_t Profile;
+
+    if(atomic_load(&WATCHING) || !Profile_Load(PATH, &Profile) || !Profile_Publish(&Profile)){
+        return false;
+    }
+    WATCH_PATH = PATH;
+    WATCH_MS = INTERVAL_MS;
+    WATCH_LAST = Profile;
+    atomic_store(&WATCHING, true);
+    if(pthread_create(&WATCHER, NULL, Profile_Watcher, NULL) != 0){
+        atomic_store(&WATCHING, false);
+        return false;
+    }
+    return true;
+}
+
+
+void Profile_Unwatch(void){
+    if(atomic_exchange(&WATCHING, false)){
+        pthread_join(WATCHER, NULL);
+    }
+}
+
+
+void Profile_Reset(void){
+    const SpeedProfile_t* Replaced = atomic_exchange(&CURRENT, &PROFILE_DEFAULT);
+
+    if(Replaced != &PROFILE_DEFAULT){
+        free((void*)Replaced);
+    }
+    Profile_Free(PENDING);
+    PENDING = NULL;
+    Profile_Free(atomic_exchange(&RETIRED, NULL));
+}
@@ -0,0 +1,96 @@
+/**
+ * @file profile.h
+ * @brief Speed Profile header file
+ */
+
+#ifndef PROFILE_H_INCLUDED
+#define PROFILE_H_INCLUDED
+
+#include <stdbool.h>
+
+/** @brief Highest Motor Angle a Profile may set */
+#define PROFILE_MAX_ANGLE       180
+
+/** @brief Time between checks of a watched Profile File */
+#ifndef PROFILE_WATCH_MS
+#define PROFILE_WATCH_MS        500
+#endif
+
+/** @brief Speed to Motor Angle mapping & P long press threshold */
+typedef struct {
+    short Angles[3];                /* By MotorSpeed_t */
+    unsigned char LongPress;        /* P Press Time (seconds) which decreases Speed */
+} SpeedProfile_t;
+
+/** @brief Profile used till another one is published: 140, 90 & 10 degrees, long press at 30 seconds */
+extern const SpeedProfile_t PROFILE_DEFAULT;
+
+
+/** @brief Get Profile in use, Speed Updates read it once and don't keep it after their tick
+ * @param void
+ * @return const SpeedProfile_t* Profile
+ */
+const SpeedProfile_t* Profile_Current(void);
+
+
+/** @brief Check a Profile can be used: Angles 0 to PROFILE_MAX_ANGLE & long press after at least 1 second
+ * @param PROFILE const SpeedProfile_t* Profile
+ * @return bool true if Profile is valid & false if not
+ */
+bool Profile_IsValid(const SpeedProfile_t* PROFILE);
+
+
+/** @brief Publish a copy of a Profile, next Speed Updates use it. Call it from any thread except the Control Loop,
+ * the Profile it replaces is reclaimed by Profile_Tick() after the next tick
+ * @param PROFILE const SpeedProfile_t* Profile
+ * @return bool true if Profile is published & false if it isn't valid or there's no memory
+ */
+bool Profile_Publish(const SpeedProfile_t* PROFILE);
+
+
+/** @brief Reclaim Profiles replaced before the last tick, call it once at the end of every tick
+ * (it is a Scheduler Task in main.c)
+ * @param void
+ * @return void
+ */
+void Profile_Tick(void);
+
+
+/** @brief Number of replaced Profiles not reclaimed yet
+ * @param void
+ * @return unsigned int Profiles
+ */
+unsigned int Profile_Retired(void);
+
+
+/** @brief Read a Profile File, lines are "min|med|max ANGLE" or "long_press SECONDS", '#' starts a comment.
+ * Values not in the File are taken from PROFILE_DEFAULT
+ * @param PATH const char* Profile File path
+ * @param PROFILE SpeedProfile_t* Profile
+ * @return bool true if File is read & Profile is valid & false if not
+ */
+bool Profile_Load(const char* PATH, SpeedProfile_t* PROFILE);
+
+
+/** @brief Load & publish a Profile File now and every time it changes, from a watcher thread
+ * @param PATH const char* Profile File path, it is kept (not copied)
+ * @param INTERVAL_MS unsigned long Time between checks of the File
+ * @return bool true if File is published & watched & false if not
+ */
+bool Profile_Watch(const char* PATH, unsigned long INTERVAL_MS);
+
+
+/** @brief Stop watching the Profile File
+ * @param void
+ * @return void
+ */
+void Profile_Unwatch(void);
+
+
+/** @brief Use PROFILE_DEFAULT again and reclaim all replaced Profiles, only when no Speed Update runs
+ * @param void
+ * @return void
+ */
+void Profile_Reset(void);
+
+#endif // PROFILE_H_INCLUDED
@@ -0,0 +1,142 @@
+/**
+ * @file scheduler.c
+ * @brief Scheduler main file
+ * @details Here we run the Control Loop Tasks in order once every SCHED_TICK_NS. Ticks are kept on an absolute
+ * timeline so sleeping never drifts, a tick which ends late makes the next one start at once. <br>
+ * The clock is read once at the start of every tick to stamp its Event Records,
+ * Task times are taken only if a hook (Sched_OnTask, Sched_OnTick) wants them
+ *
+ */
+
+#include <stddef.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+ /*    Include Header    */
+#include"scheduler.h"
+
+ /*    Include Modules    */
+#include"../event_ring/event_ring.h"
+
+/** @brief Tasks in run order */
+static const SchedTask_t* SCHED_TASKS;
+static unsigned int TASK_COUNT;
+
+/** @brief Start of next tick in ns of the monotonic clock */
+static uint64_t NEXT_TICK_NS;
+
+/** @brief Ticks run & late ticks */
+static unsigned long TICKS;
+static unsigned long OVERRUNS;
+
+
+void (*Sched_OnTask)(unsigned int TASK, uint64_t START, uint64_t END) = NULL;
+
+void (*Sched_OnTick)(unsigned long TICK, uint64_t START, uint64_t END) = NULL;
+
+
+/** @brief Current monotonic time
+ * @param void
+ * @return uint64_t Time in ns
+ */
+static uint64_t Sched_NowNs(void){
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return (uint64_t)Now.tv_sec * 1000000000u + (uint64_t)Now.tv_nsec;
+}
+
+
+bool Sched_Init(const SchedTask_t* TASKS, unsigned int COUNT){
+    if(COUNT > SCHED_MAX_TASKS){
+        return false;
+    }
+    SCHED_TASKS = TASKS;
+    TASK_COUNT = COUNT;
+    TICKS = 0;
+    OVERRUNS = 0;
+    NEXT_TICK_NS = Sched_NowNs() + SCHED_TICK_NS;
+    return true;
+}
+
+
+void Sched_RunTick(void){
+    void (*OnTask)(unsigned int, uint64_t, uint64_t) = Sched_OnTask;
+    void (*OnTick)(unsigned long, uint64_t, uint64_t) = Sched_OnTick;
+    uint64_t TickStart = EventRing_Now(), Start, End;
+    unsigned int i;
+
+    EventRing_SetTime(TickStart);
+
+    if(OnTask == NULL){
+        for(i = 0; i < TASK_COUNT; i++){
+            SCHED_TASKS[i].Run();
+        }
+    }else{
+        /* Hook time is left out of Task times */
+        Start = EventRing_Now();
+        for(i = 0; i < TASK_COUNT; i++){
+            EventRing_SetTime(Start);
+            SCHED_TASKS[i].Run();
+            End = EventRing_Now();
+            OnTask(i, Start, End);
+            Start = EventRing_Now();
+        }
+    }
+
+    if(OnTick != NULL){
+        OnTick(TICKS, TickStart, EventRing_Now());
+    }
+    TICKS++;
+}
+
+
+bool Sched_WaitNextTick(void){
+    uint64_t Now = Sched_NowNs();
+    uint64_t Deadline = NEXT_TICK_NS;
+
+    if(Now > Deadline){
+        OVERRUNS++;
+        NEXT_TICK_NS = Now + SCHED_TICK_NS;
+        return false;
+    }
+
+    NEXT_TICK_NS = Deadline + SCHED_TICK_NS;
+#ifdef _WIN32
+    Sleep((DWORD)((Deadline - Now) / 1000000u));
+#else
+    {
+        struct timespec Wake;
+
+        Wake.tv_sec = (time_t)(Deadline / 1000000000u);
+        Wake.tv_nsec = (long)(Deadline % 1000000000u);
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Wake, NULL) != 0){
+            /* Woken by a signal, sleep again */
+        }
+    }
+#endif
+    return true;
+}
+
+
+unsigned long Sched_Ticks(void){
+    return TICKS;
+}
+
+
+void Sched_SetTicks(unsigned long TICKS_RUN){
+    TICKS = TICKS_RUN;
+}
+
+
+unsigned long Sched_Overruns(void){
+    return OVERRUNS;
+}
+
+
+const SchedTask_t* Sched_Task(unsigned int TASK){
+    return (TASK < TASK_COUNT) ? &SCHED_TASKS[TASK] : NULL;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file scheduler.h
+ * @brief Scheduler header file
+ */
+
+#ifndef SCHEDULER_H_INCLUDED
+#define SCHEDULER_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include"../switches/switch.h"
+
+/** @brief Tick period, Switches are updated every tick */
+#define SCHED_TICK_NS           ((uint64_t)SW_TICK_MS * 1000000u)
+
+/** @brief Most Tasks run every tick */
+#define SCHED_MAX_TASKS         16
+
+/** @brief A Task run once every tick */
+typedef struct {
+    const char* Name;
+    void (*Run)(void);
+} SchedTask_t;
+
+
+/** @brief Called after every Task with its start & end time (EventRing_Now() units), NULL if not needed
+ */
+extern void (*Sched_OnTask)(unsigned int TASK, uint64_t START, uint64_t END);
+
+
+/** @brief Called after every tick with its start & end time (EventRing_Now() units), NULL if not needed
+ */
+extern void (*Sched_OnTick)(unsigned long TICK, uint64_t START, uint64_t END);
+
+
+/** @brief Set Tasks and start the first tick now
+ * @param TASKS const SchedTask_t* Tasks in run order, they are kept (not copied)
+ * @param COUNT unsigned int Number of Tasks, at most SCHED_MAX_TASKS
+ * @return bool true if Tasks are set & false if there are too many
+ */
+bool Sched_Init(const SchedTask_t* TASKS, unsigned int COUNT);
+
+
+/** @brief Run every Task once in order
+ * @param void
+ * @return void
+ */
+void Sched_RunTick(void);
+
+
+/** @brief Sleep till next tick starts, a late tick starts at once and is counted as an overrun
+ * @param void
+ * @return bool true if the tick ended in time & false if it overran
+ */
+bool Sched_WaitNextTick(void);
+
+
+/** @brief Number of ticks run since Sched_Init()
+ * @param void
+ * @return unsigned long Ticks
+ */
+unsigned long Sched_Ticks(void);
+
+
+/** @brief Carry on counting ticks from a restored Snapshot (scheduler phase), call it after Sched_Init()
+ * @param TICKS_RUN unsigned long Ticks run before the restart
+ * @return void
+ */
+void Sched_SetTicks(unsigned long TICKS_RUN);
+
+
+/** @brief Number of ticks which ended after the next tick should have started
+ * @param void
+ * @return unsigned long Overruns
+ */
+unsigned long Sched_Overruns(void);
+
+
+/** @brief Get a Task
+ * @param TASK unsigned int Task index in run order
+ * @return const SchedTask_t* The Task or NULL if there's no such Task
+ */
+const SchedTask_t* Sched_Task(unsigned int TASK);
+
+#endif // SCHEDULER_H_INCLUDED
@@ -10,74 +10,208 @@
 #include"speedcontrol.h"
 
   /*    Include Modules    */
-#include"../../test/fake_switch/fake_switch.h"
+#include"../event_ring/event_ring.h"
+#include"../probes/probes.h"
+#include"../latency/latency.h"
+#include"../profile/profile.h"
 
-/** @brief a variables with MotorSpeed_t type store current Motor Speed */
-static MotorSpeed_t MOT_SPEED;
+/** @brief The Controller of this Motor, it stores current Motor Speed */
+static SpeedController_t MOT_SPEED;
+
+/** @brief Switch edges whose Speed change isn't written on the Motor yet & edges already served */
+static uint64_t PENDING_EDGE[3];
+static uint64_t SERVED_EDGE[3];
+
+/** @brief Last Motor Angle recorded, -1 if none since Speed_Init() */
+static short LAST_ANGLE;
 
 
 void Speed_Init(){
+    unsigned int Sw;
 
-    MOT_SPEED = MED;
+    SpeedCtl_Init(&MOT_SPEED);
+    LAST_ANGLE = -1;
+    for(Sw = 0; Sw < 3; Sw++){
+        PENDING_EDGE[Sw] = 0;
+        SERVED_EDGE[Sw] = 0;
+    }
  }
 
 
 short MotAngle_Write(){
+    short Angle = SpeedCtl_Angle(&MOT_SPEED);
+    uint64_t Now;
+    unsigned int Sw;
+
+    /* Only changes are recorded, the same Angle every tick would push Switch & Speed Events out of the Ring */
+    if(Angle != LAST_ANGLE){
+        EventRing_Record(EVENT_MOTOR_ANGLE, (unsigned short)MOT_SPEED.Speed, (unsigned long)Angle);
+        LAST_ANGLE = Angle;
+    }
+
+    /* The Speed changes of these edges reach the Motor now */
+    if((PENDING_EDGE[POSTIVE] | PENDING_EDGE[NEGATIVE] | PENDING_EDGE[P]) != 0){
+        Now = EventRing_Now();
+        for(Sw = 0; Sw < 3; Sw++){
+            if(PENDING_EDGE[Sw] != 0){
+                Latency_Add((Switch_t)Sw, Now - PENDING_EDGE[Sw]);
+                PENDING_EDGE[Sw] = 0;
+            }
+        }
+    }
+    return Angle;
+ }
 
-    if (MOT_SPEED == MIN){
-        return 140;
 
-    }else if (MOT_SPEED == MED){
-        return 90;
+/** @brief Record Speed change of the Motor Controller
+ * @param OLD MotorSpeed_t Speed before
+ * @return void
+ */
+static void Speed_Changed(MotorSpeed_t OLD){
+    if(MOT_SPEED.Speed != OLD){
+        EventRing_Record(EVENT_SPEED, (unsigned short)OLD, (unsigned long)MOT_SPEED.Speed);
+    }
+}
 
-    }else if (MOT_SPEED == MAX){
-        return 10;
 
-    }else{
+ void Speed_Increase(){
+    MotorSpeed_t Old = MOT_SPEED.Speed;
 
+    SpeedCtl_Increase(&MOT_SPEED);
+    Speed_Changed(Old);
+ }
+
+ void Speed_Decrease(){
+    MotorSpeed_t Old = MOT_SPEED.Speed;
+
+    SpeedCtl_Decrease(&MOT_SPEED);
+    Speed_Changed(Old);
+ }
+
+
+ void Speed_Update(){
+    SpeedInput_t Input;
+    MotorSpeed_t Old;
+    unsigned int Applied, Sw;
+    uint64_t Edge;
+
+    Input.Postive_State = Get_SWState(POSTIVE);
+    Input.Negative_State = Get_SWState(NEGATIVE);
+    Input.P_State = Get_SWState(P);
+    Input.P_PressTime = Get_PressTime();
+
+    Old = MOT_SPEED.Speed;
+    Applied = SpeedCtl_Update(&MOT_SPEED, &Input);
+    Speed_Changed(Old);
+
+    /* First Speed change of an edge carries its time to MotAngle_Write(), only Switches of applied rules are read */
+    if(MOT_SPEED.Speed != Old){
+        for(Sw = 0; Sw < 3; Sw++){
+            if((Applied & (1u << Sw)) == 0){
+                continue;
+            }
+            Edge = Get_SWEdgeTime((Switch_t)Sw);
+            if(Edge != 0 && Edge != SERVED_EDGE[Sw]){
+                PENDING_EDGE[Sw] = Edge;
+                SERVED_EDGE[Sw] = Edge;
+            }
+        }
     }
  }
 
 
- void Speed_Increase(){
-    if (MOT_SPEED == MIN){
-        MOT_SPEED = MED;
+ MotorSpeed_t Speed_Get(){
 
-    }else if (MOT_SPEED == MED){
-        MOT_SPEED = MAX;
+    return MOT_SPEED.Speed;
+ }
 
-    }else {
 
+ void Speed_Set(MotorSpeed_t SPEED){
+    MotorSpeed_t Old = MOT_SPEED.Speed;
+
+    if((unsigned int)SPEED <= MAX){
+        MOT_SPEED.Speed = SPEED;
+        Speed_Changed(Old);
+    }
+ }
+
+
+void SpeedCtl_Init(SpeedController_t* CTL){
+
+    CTL->Speed = MED;
+ }
+
+
+short SpeedCtl_Angle(const SpeedController_t* CTL){
+    const SpeedProfile_t* Profile = Profile_Current();
+
+    if (CTL->Speed == MIN){
+        return Profile->Angles[MIN];
+
+    }else if (CTL->Speed == MED){
+        return Profile->Angles[MED];
+
+    }else if (CTL->Speed == MAX){
+        return Profile->Angles[MAX];
+
+    }else{
+        return 0;
     }
  }
 
- void Speed_Decrease(){
-    if (MOT_SPEED == MAX){
-        MOT_SPEED = MED;
 
-    }else if (MOT_SPEED == MED){
-        MOT_SPEED = MIN;
+ void SpeedCtl_Increase(SpeedController_t* CTL){
+    if (CTL->Speed == MIN){
+        CTL->Speed = MED;
+        SPEED_PROBE3(increase, CTL, MIN, MED);
+
+    }else if (CTL->Speed == MED){
+        CTL->Speed = MAX;
+        SPEED_PROBE3(increase, CTL, MED, MAX);
 
     }else {
+        SPEED_PROBE2(increase_clamped, CTL, CTL->Speed);
+    }
+ }
 
+ void SpeedCtl_Decrease(SpeedController_t* CTL){
+    if (CTL->Speed == MAX){
+        CTL->Speed = MED;
+        SPEED_PROBE3(decrease, CTL, MAX, MED);
+
+    }else if (CTL->Speed == MED){
+        CTL->Speed = MIN;
+        SPEED_PROBE3(decrease, CTL, MED, MIN);
+
+    }else {
+        SPEED_PROBE2(decrease_clamped, CTL, CTL->Speed);
     }
  }
 
 
- void Speed_Update(){
+ unsigned int SpeedCtl_Update(SpeedController_t* CTL, const SpeedInput_t* INPUT){
+    unsigned int Applied = 0;
 
-    if (Get_FakeSW_State(P) == PRESSED && Get_FakeSW_PressTime() >= 30){
-        Speed_Decrease();
+    if (INPUT->P_State == PRESSED && INPUT->P_PressTime >= Profile_Current()->LongPress){
+        SPEED_PROBE3(rule_p_long_press, CTL, CTL->Speed, INPUT->P_PressTime);
+        SpeedCtl_Decrease(CTL);
+        Applied |= 1u << P;
 
     }
 
-    if (Get_FakeSW_State(NEGATIVE) == PREPRESSED){
-        Speed_Decrease();
+    if (INPUT->Negative_State == PREPRESSED){
+        SPEED_PROBE2(rule_negative, CTL, CTL->Speed);
+        SpeedCtl_Decrease(CTL);
+        Applied |= 1u << NEGATIVE;
 
     }
 
-    if (Get_FakeSW_State(POSTIVE) == PREPRESSED){
-        Speed_Increase();
+    if (INPUT->Postive_State == PREPRESSED){
+        SPEED_PROBE2(rule_postive, CTL, CTL->Speed);
+        SpeedCtl_Increase(CTL);
+        Applied |= 1u << POSTIVE;
 
     }
+
+    return Applied;
  }
@@ -7,10 +7,28 @@
 #define MOTOR_H_INCLUDED
 
 
+#include"../switches/switch.h"
+
 /** @brief A variable can assign the three States of Motor Speed */
 typedef enum {MIN, MED, MAX} MotorSpeed_t;
 
 
+/** @brief Switches States & P Press Time used by one Speed Update */
+typedef struct {
+    SwitchState_t Postive_State;
+    SwitchState_t Negative_State;
+    SwitchState_t P_State;
+    unsigned char P_PressTime;
+} SpeedInput_t;
+
+
+/** @brief One Speed Controller, Controllers don't share anything
+ * so many of them can run at the same time (one per thread) */
+typedef struct {
+    MotorSpeed_t Speed;
+} SpeedController_t;
+
+
 /** @brief Set Motor Default Speed to MED
  * @param void
  * @return void
@@ -21,7 +39,9 @@ void Speed_Init(void);
 /** @brief Write Current Speed State on the Motor as Degrees <br>
  * if Speed: MIN --> Angle = 140                             <br>
  * if Speed: MED --> Angle = 90                              <br>
- * if Speed: MAX --> Angle = 10
+ * if Speed: MAX --> Angle = 10                              <br>
+ * Angles are those of the Speed Profile in use (source/profile), above are the default ones. <br>
+ * A written Angle is added to the Event Ring when it differs from the last one
  * @param void
  * @return unsigned char current Motor Angle According to Speed State
  */
@@ -53,4 +73,54 @@ void Speed_Decrease(void);
  */
 void Speed_Update(void);
 
+
+/** @brief Get current Motor Speed
+ * @param void
+ * @return MotorSpeed_t Speed
+ */
+MotorSpeed_t Speed_Get(void);
+
+
+/** @brief Set Motor Speed, e.g. to resume the Speed saved before power off. Speeds out of MIN..MAX are ignored
+ * @param SPEED MotorSpeed_t Speed
+ * @return void
+ */
+void Speed_Set(MotorSpeed_t SPEED);
+
+
+/** @brief Set Controller Speed to MED (Speed_Init() for one Controller)
+ * @param CTL SpeedController_t* Controller
+ * @return void
+ */
+void SpeedCtl_Init(SpeedController_t* CTL);
+
+
+/** @brief Get Controller Motor Angle (MotAngle_Write() for one Controller)
+ * @param CTL const SpeedController_t* Controller
+ * @return short Motor Angle According to Controller Speed
+ */
+short SpeedCtl_Angle(const SpeedController_t* CTL);
+
+
+/** @brief Increase Controller Speed one step (Speed_Increase() for one Controller)
+ * @param CTL SpeedController_t* Controller
+ * @return void
+ */
+void SpeedCtl_Increase(SpeedController_t* CTL);
+
+
+/** @brief Decrease Controller Speed one step (Speed_Decrease() for one Controller)
+ * @param CTL SpeedController_t* Controller
+ * @return void
+ */
+void SpeedCtl_Decrease(SpeedController_t* CTL);
+
+
+/** @brief Update Controller Speed from given Switches Inputs (Speed_Update() for one Controller)
+ * @param CTL SpeedController_t* Controller
+ * @param INPUT const SpeedInput_t* Switches States & P Press Time
+ * @return unsigned int Switches whose rule was applied, bit (1 << Switch_t) for every Switch
+ */
+unsigned int SpeedCtl_Update(SpeedController_t* CTL, const SpeedInput_t* INPUT);
+
 #endif // MOTOR_H_INCLUDED
@@ -1,6 +1,10 @@
 /**
  * @file switch.c
  * @brief Switch main file
+ * @details Update_Switch() is called every SW_TICK_MS, it reads Switch level and moves its State: <br>
+ * RELEASED --pushed--> PRE_PRESSED --pushed--> PRESSED --not pushed--> PRE_RELEASED --not pushed--> RELEASED <br>
+ * so a State needs the same level on two ticks to be PRESSED or RELEASED (debounce).
+ * Every State change is recorded in the Event Ring
  *
  */
 
@@ -9,6 +13,10 @@
  /*    Include Header    */
 #include"switch.h"
 
+ /*    Include Modules    */
+#include"../event_ring/event_ring.h"
+#include"../probes/probes.h"
+
 
 /** @brief A variables with SwichState_t type store Switches State */
 static SwitchState_t POSTIVE_SWITCH_STATE;
@@ -16,14 +24,26 @@ static SwitchState_t NEGATIVE_SWITCH_STATE;
 static SwitchState_t P_SWITCH_STATE;
 
 /** @brief A variable to store Press Time for switch */
-unsigned char PRESS_TIME;
+static unsigned char PRESS_TIME;
+
+/** @brief Ticks P Switch is PRESSED since Press Time was increased */
+static unsigned int PRESS_TICKS;
+
+/** @brief Time of last edge of every Switch (EventRing_Now() units) */
+static uint64_t EDGE_TIME[3];
 
 
 
-SwitchState_t   (*Get_SWState)(Switch_t SW);
+SwitchState_t   (*Get_SWState)(Switch_t SW) = Get_RealSW_State;
 
-unsigned char   (*Get_PressTime)(void);
+unsigned char   (*Get_PressTime)(void) = Get_RealSW_PressTime;
 
+bool            (*Get_SWLevel)(Switch_t SW) = Get_RealSW_Level;
+
+
+bool IsOutOfBounds(Switch_t SW){
+    return (SW < 0) || (SW > 2);
+}
 
 
 
@@ -41,6 +61,7 @@ SwitchState_t Get_RealSW_State(Switch_t SW){
     default:
         break;
     }
+    return RELEASED;
 }
 
 
@@ -49,8 +70,10 @@ void SW_Init(Switch_t SW){
         return;
 
     }else{
+        EDGE_TIME[SW] = 0;
         Get_SWState = Get_RealSW_State;
         Get_PressTime = Get_RealSW_PressTime;
+        Get_SWLevel = Get_RealSW_Level;
         switch(SW){
         case POSTIVE:
             POSTIVE_SWITCH_STATE = RELEASED;
@@ -60,6 +83,8 @@ void SW_Init(Switch_t SW){
             break;
         case P:
             P_SWITCH_STATE = RELEASED;
+            PRESS_TIME = 0;
+            PRESS_TICKS = 0;
             break;
         default:
             break;
@@ -73,8 +98,112 @@ unsigned char Get_RealSW_PressTime(void){
 }
 
 
+bool Get_RealSW_Level(Switch_t SW){
+    /* No Switch pins on PC, Switches are never pushed */
+    (void)SW;
+    return false;
+}
+
+
+uint64_t Get_SWEdgeTime(Switch_t SW){
+    return IsOutOfBounds(SW) ? 0 : EDGE_TIME[SW];
+}
+
+
+/** @brief Get where State of a Switch is stored
+ * @param SW Switch_t Which Switch
+ * @return SwitchState_t* State of the Switch
+ */
+static SwitchState_t* SW_State(Switch_t SW){
+    switch(SW){
+    case POSTIVE:
+        return &POSTIVE_SWITCH_STATE;
+    case NEGATIVE:
+        return &NEGATIVE_SWITCH_STATE;
+    default:
+        return &P_SWITCH_STATE;
+    }
+}
+
+
 void Update_Switch(Switch_t SW){
+    SwitchState_t* State;
+    SwitchState_t Next;
+    bool Pushed;
 
+    if(IsOutOfBounds(SW)){
+        return;
+    }
+    State = SW_State(SW);
+    Pushed = Get_SWLevel(SW);
 
+    switch(*State){
+    case RELEASED:
+        Next = Pushed ? PREPRESSED : RELEASED;
+        break;
+    case PREPRESSED:
+    case PRESSED:
+        Next = Pushed ? PRESSED : PRERELEASED;
+        break;
+    default:
+        Next = Pushed ? PREPRESSED : RELEASED;
+        break;
+    }
+
+    /* P Press Time counts seconds while P is PRESSED and starts again on every press */
+    if(SW == P){
+        if(Next == PREPRESSED){
+            PRESS_TIME = 0;
+            PRESS_TICKS = 0;
+
+        }else if(Next == PRESSED && ++PRESS_TICKS >= SW_TICKS_PER_SECOND){
+            PRESS_TICKS = 0;
+            if(PRESS_TIME < 255){
+                PRESS_TIME++;
+            }
+        }
+    }
+
+    if(Next != *State){
+        SPEED_PROBE4(switch_state, SW, *State, Next, PRESS_TIME);
+        if(Next == PREPRESSED){
+            EDGE_TIME[SW] = EventRing_Now();
+        }
+        *State = Next;
+        EventRing_Record(EVENT_SWITCH_STATE, (unsigned short)SW, (unsigned long)Next | ((unsigned long)PRESS_TIME << 8));
+    }
 }
 
+
+
+void SW_Save(SwitchSnapshot_t* SNAPSHOT){
+    SNAPSHOT->States[POSTIVE] = POSTIVE_SWITCH_STATE;
+    SNAPSHOT->States[NEGATIVE] = NEGATIVE_SWITCH_STATE;
+    SNAPSHOT->States[P] = P_SWITCH_STATE;
+    SNAPSHOT->PressTime = PRESS_TIME;
+    SNAPSHOT->PressTicks = PRESS_TICKS;
+}
+
+
+bool SW_Restore(const SwitchSnapshot_t* SNAPSHOT){
+    unsigned int Sw;
+
+    for(Sw = 0; Sw < 3; Sw++){
+        if((unsigned int)SNAPSHOT->States[Sw] > RELEASED){
+            return false;
+        }
+    }
+    if(SNAPSHOT->PressTicks >= SW_TICKS_PER_SECOND){
+        return false;
+    }
+
+    POSTIVE_SWITCH_STATE = SNAPSHOT->States[POSTIVE];
+    NEGATIVE_SWITCH_STATE = SNAPSHOT->States[NEGATIVE];
+    P_SWITCH_STATE = SNAPSHOT->States[P];
+    PRESS_TIME = SNAPSHOT->PressTime;
+    PRESS_TICKS = SNAPSHOT->PressTicks;
+    for(Sw = 0; Sw < 3; Sw++){
+        EDGE_TIME[Sw] = 0;
+    }
+    return true;
+}
@@ -7,12 +7,33 @@
 #ifndef SWITCH_H_INCLUDED
 #define SWITCH_H_INCLUDED
 
+#include <stdbool.h>
+#include <stdint.h>
+
 /** @brief A variable can assign the four States of Switch */
 typedef enum {PREPRESSED, PRESSED, PRERELEASED, RELEASED} SwitchState_t;
 
 /** @brief A variable can assign three types of Switches */
 typedef enum {POSTIVE, NEGATIVE, P} Switch_t;
 
+/** @brief Update_Switch() is called every SW_TICK_MS, P Press Time is counted in seconds */
+#define SW_TICK_MS              20
+#define SW_TICKS_PER_SECOND     (1000 / SW_TICK_MS)
+
+/** @brief Switches States & P Press Time accumulators, enough to carry on Update_Switch() after a restart */
+typedef struct {
+    SwitchState_t States[3];        /* By Switch_t */
+    unsigned char PressTime;
+    unsigned int PressTicks;        /* Ticks P is PRESSED since Press Time was increased */
+} SwitchSnapshot_t;
+
+
+
+/** @brief Check Whether Switch value Out of Bounds or not
+ * @param SW Switch_t Tested Value
+ * @return bool true if Switch value Out of Bounds & False if not
+ */
+bool IsOutOfBounds(Switch_t SW);
 
 
 /** @brief Get Current State of Specific Switch
@@ -46,6 +67,44 @@ extern SwitchState_t   (*Get_SWState)(Switch_t SW);
 extern unsigned char   (*Get_PressTime)(void);
 
 
+/** @brief Get Level of a Switch pin
+ * @param SW Switch_t Which Switch
+ * @return bool true while Switch is pushed & false if not
+ */
+bool Get_RealSW_Level(Switch_t SW);
+
+
+/** @brief Pointer to Get Switch Level Functions, Fake or Virtual Switches can replace the pins
+ */
+extern bool            (*Get_SWLevel)(Switch_t SW);
+
+
+/** @brief Get Time of last Switch edge (Update_Switch() saw it go PRE_PRESSED)
+ * @param SW Switch_t Which Switch
+ * @return uint64_t Time in EventRing_Now() units, 0 if there's no edge since SW_Init()
+ */
+uint64_t Get_SWEdgeTime(Switch_t SW);
+
+
+/** @brief Move Switch State one tick according to its Level (debounce) & count P Press Time,
+ * call it every SW_TICK_MS
+ * @param SW Switch_t Which Switch to update
+ * @return void
+ */
 void Update_Switch(Switch_t SW);
 
+
+/** @brief Save Switches States & P Press Time accumulators
+ * @param SNAPSHOT SwitchSnapshot_t* Saved Switches
+ * @return void
+ */
+void SW_Save(SwitchSnapshot_t* SNAPSHOT);
+
+
+/** @brief Restore Switches saved by SW_Save(), edge times are cleared as in SW_Init()
+ * @param SNAPSHOT const SwitchSnapshot_t* Saved Switches
+ * @return bool true if Switches are restored & false if SNAPSHOT isn't valid (nothing is changed)
+ */
+bool SW_Restore(const SwitchSnapshot_t* SNAPSHOT);
+
 #endif // SWITCH_H_INCLUDED
@@ -0,0 +1,259 @@
+/**
+ * @file telemetry.c
+ * @brief Telemetry main file
+ * @details Here we keep live Counters of the Controller in a shared memory Segment so a monitor process
+ * (telemetry_monitor tool) can watch the running Control Loop without a debugger. <br>
+ * Every Controller Slot is a seqlock: the writer makes Seq odd, writes the Counters, then makes Seq even.
+ * A reader copies the Counters between two reads of the same even Seq, so it never sees half written Counters
+ * and the writer never waits for it. <br>
+ * Counters are collected once a tick from the Event Ring, Scheduler & Latency Histograms, the Control Loop hot path isn't touched
+ *
+ */
+
+#include <string.h>
+#include <stddef.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+ /*    Include Header    */
+#include"telemetry.h"
+
+ /*    Include Modules    */
+#include"../event_ring/event_ring.h"
+#include"../scheduler/scheduler.h"
+#include"../switches/switch.h"
+#include"../latency/latency.h"
+
+_Static_assert(sizeof(TelemetrySlot_t) == 128, "Telemetry Slot must be 128 bytes");
+_Static_assert(offsetof(TelemetrySegment_t, Slots) == 64, "Telemetry Header must be 64 bytes");
+
+/** @brief Event Ring Records read at once */
+#define TELEMETRY_RECORDS   64
+
+/** @brief Counters of this Controller & Event Ring Records already counted */
+static TelemetryCounters_t COUNTERS;
+static uint32_t CURSOR;
+
+
+/** @brief Map a Segment
+ * @param TELEMETRY Telemetry_t* Segment to open
+ * @param NAME const char* Shared memory name
+ * @param SIZE unsigned long Size to create or 0 to open an existing Segment
+ * @return bool true if Segment is mapped & false if not
+ */
+static bool Telemetry_Map(Telemetry_t* TELEMETRY, const char* NAME, unsigned long SIZE){
+#ifdef _WIN32
+    HANDLE Mapping;
+    MEMORY_BASIC_INFORMATION Info;
+
+    Mapping = (SIZE != 0) ? CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)SIZE, NAME)
+                          : OpenFileMappingA(FILE_MAP_READ, FALSE, NAME);
+    if(Mapping == NULL){
+        return false;
+    }
+    TELEMETRY->Segment = MapViewOfFile(Mapping, (SIZE != 0) ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, SIZE);
+    if(TELEMETRY->Segment == NULL){
+        CloseHandle(Mapping);
+        return false;
+    }
+    VirtualQuery(TELEMETRY->Segment, &Info, sizeof(Info));
+    TELEMETRY->Size = (SIZE != 0) ? SIZE : (unsigned long)Info.RegionSize;
+    TELEMETRY->Handle = Mapping;
+    return true;
+#else
+    struct stat Stat;
+    void* Address;
+    int Fd = (SIZE != 0) ? shm_open(NAME, O_RDWR | O_CREAT, 0644) : shm_open(NAME, O_RDONLY, 0);
+
+    if(Fd < 0){
+        return false;
+    }
+    if((SIZE != 0 && ftruncate(Fd, (off_t)SIZE) != 0) || fstat(Fd, &Stat) != 0){
+        close(Fd);
+        return false;
+    }
+    Address = mmap(NULL, (size_t)Stat.st_size, (SIZE != 0) ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, Fd, 0);
+    close(Fd);
+    if(Address == MAP_FAILED){
+        return false;
+    }
+    TELEMETRY->Segment = Address;
+    TELEMETRY->Size = (unsigned long)Stat.st_size;
+    TELEMETRY->Handle = NULL;
+    return true;
+#endif
+}
+
+
+bool Telemetry_Create(Telemetry_t* TELEMETRY, const char* NAME, unsigned int CONTROLLERS){
+    unsigned long Size = (unsigned long)(sizeof(TelemetrySegment_t) + CONTROLLERS * sizeof(TelemetrySlot_t));
+    TelemetrySegment_t* Segment;
+    unsigned int i;
+
+    if(CONTROLLERS == 0 || CONTROLLERS > TELEMETRY_MAX_CONTROLLERS || !Telemetry_Map(TELEMETRY, NAME, Size)){
+        return false;
+    }
+
+    /* Counters first, Header last, a monitor attaching meanwhile refuses the Segment till it is ready */
+    Segment = TELEMETRY->Segment;
+    memset(Segment->Magic, 0, sizeof(Segment->Magic));
+    for(i = 0; i < CONTROLLERS; i++){
+        memset(&Segment->Slots[i].Counters, 0, sizeof(TelemetryCounters_t));
+        atomic_store_explicit(&Segment->Slots[i].Seq, 0, memory_order_relaxed);
+    }
+    Segment->Version = TELEMETRY_VERSION;
+    Segment->SlotSize = sizeof(TelemetrySlot_t);
+    Segment->Controllers = CONTROLLERS;
+    atomic_thread_fence(memory_order_release);
+    memcpy(Segment->Magic, TELEMETRY_MAGIC, sizeof(Segment->Magic));
+
+    /* Cycles are measured now for latencies, not in the first tick */
+    (void)EventRing_NsPerUnit();
+    return true;
+}
+
+
+bool Telemetry_Attach(Telemetry_t* TELEMETRY, const char* NAME){
+    const TelemetrySegment_t* Segment;
+
+    if(!Telemetry_Map(TELEMETRY, NAME, 0)){
+        return false;
+    }
+    Segment = TELEMETRY->Segment;
+    if(TELEMETRY->Size < sizeof(TelemetrySegment_t) || memcmp(Segment->Magic, TELEMETRY_MAGIC, sizeof(Segment->Magic)) != 0
+       || Segment->Version != TELEMETRY_VERSION || Segment->SlotSize != sizeof(TelemetrySlot_t)
+       || TELEMETRY->Size < sizeof(TelemetrySegment_t) + (unsigned long)Segment->Controllers * sizeof(TelemetrySlot_t)){
+        Telemetry_Close(TELEMETRY);
+        return false;
+    }
+    return true;
+}
+
+
+void Telemetry_Publish(Telemetry_t* TELEMETRY, unsigned int CONTROLLER, const TelemetryCounters_t* COUNTERS){
+    TelemetrySlot_t* Slot;
+    uint32_t Seq;
+
+    if(TELEMETRY->Segment == NULL || CONTROLLER >= TELEMETRY->Segment->Controllers){
+        return;
+    }
+    Slot = &TELEMETRY->Segment->Slots[CONTROLLER];
+    Seq = atomic_load_explicit(&Slot->Seq, memory_order_relaxed);
+
+    atomic_store_explicit(&Slot->Seq, Seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    Slot->Counters = *COUNTERS;
+    atomic_store_explicit(&Slot->Seq, Seq + 2, memory_order_release);
+}
+
+
+bool Telemetry_Read(const Telemetry_t* TELEMETRY, unsigned int CONTROLLER, TelemetryCounters_t* COUNTERS){
+    TelemetrySlot_t* Slot;
+    uint32_t Before, After;
+    unsigned int Try;
+
+    if(TELEMETRY->Segment == NULL || CONTROLLER >= TELEMETRY->Segment->Controllers){
+        return false;
+    }
+    Slot = &TELEMETRY->Segment->Slots[CONTROLLER];
+
+    for(Try = 0; Try < TELEMETRY_READ_TRIES; Try++){
+        Before = atomic_load_explicit(&Slot->Seq, memory_order_acquire);
+        if(Before & 1u){
+            continue;
+        }
+        *COUNTERS = Slot->Counters;
+        atomic_thread_fence(memory_order_acquire);
+        After = atomic_load_explicit(&Slot->Seq, memory_order_relaxed);
+        if(After == Before){
+            return true;
+        }
+    }
+    return false;
+}
+
+
+unsigned int Telemetry_Controllers(const Telemetry_t* TELEMETRY){
+    return (TELEMETRY->Segment != NULL) ? TELEMETRY->Segment->Controllers : 0;
+}
+
+
+void Telemetry_Close(Telemetry_t* TELEMETRY){
+    if(TELEMETRY->Segment == NULL){
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(TELEMETRY->Segment);
+    CloseHandle(TELEMETRY->Handle);
+#else
+    munmap(TELEMETRY->Segment, TELEMETRY->Size);
+#endif
+    TELEMETRY->Segment = NULL;
+    TELEMETRY->Size = 0;
+    TELEMETRY->Handle = NULL;
+}
+
+
+void Telemetry_Remove(const char* NAME){
+#ifdef _WIN32
+    /* Windows removes the Segment with its last handle */
+    (void)NAME;
+#else
+    shm_unlink(NAME);
+#endif
+}
+
+
+/** @brief Count one Event Ring Record
+ * @param RECORD const EventRecord_t* Record
+ * @return void
+ */
+static void Telemetry_Count(const EventRecord_t* RECORD){
+    switch(RECORD->Id){
+    case EVENT_SWITCH_STATE:
+        if((RECORD->Payload & 0xFF) == PRESSED){
+            COUNTERS.Presses[RECORD->Arg % 3]++;
+        }
+        break;
+
+    case EVENT_SPEED:
+        COUNTERS.Transitions++;
+        COUNTERS.Speed = RECORD->Payload;
+        break;
+
+    case EVENT_MOTOR_ANGLE:
+        COUNTERS.Speed = RECORD->Arg;
+        COUNTERS.Angle = RECORD->Payload;
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void Telemetry_Update(Telemetry_t* TELEMETRY){
+    EventRecord_t Records[TELEMETRY_RECORDS];
+    unsigned int Count, i;
+    uint32_t Before;
+
+    do{
+        Before = CURSOR;
+        Count = EventRing_ReadFrom(&CURSOR, Records, TELEMETRY_RECORDS);
+        for(i = 0; i < Count; i++){
+            Telemetry_Count(&Records[i]);
+        }
+    }while(CURSOR != Before);
+
+    COUNTERS.Ticks = Sched_Ticks();
+    COUNTERS.Overruns = Sched_Overruns();
+    COUNTERS.LastEdgeLatencyNs = Latency_LastNs();
+    Telemetry_Publish(TELEMETRY, 0, &COUNTERS);
+}
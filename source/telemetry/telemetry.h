@@ -0,0 +1,124 @@
+/**
+ * @file telemetry.h
+ * @brief Telemetry header file
+ */
+
+#ifndef TELEMETRY_H_INCLUDED
+#define TELEMETRY_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/** @brief Segment Header: "TELM" | version | Slot size | number of Controllers */
+#define TELEMETRY_MAGIC             "TELM"
+#define TELEMETRY_VERSION           1
+
+/** @brief Most Controllers in one Segment */
+#define TELEMETRY_MAX_CONTROLLERS   1024
+
+/** @brief Tries to read a consistent Snapshot before giving up, the writer is inside its few stores meanwhile */
+#define TELEMETRY_READ_TRIES        1000
+
+/** @brief Counters of one Controller, fixed width so every process sees the same layout */
+typedef struct {
+    uint64_t Ticks;
+    uint64_t Overruns;
+    uint64_t Transitions;           /* Speed changes */
+    uint64_t Presses[3];            /* Switches going PRESSED, by Switch_t */
+    uint64_t LastEdgeLatencyNs;     /* Last button edge to Motor Angle change */
+    uint32_t Speed;                 /* MotorSpeed_t */
+    uint32_t Angle;                 /* Last written Motor Angle */
+} TelemetryCounters_t;
+
+/** @brief Counters of one Controller & their seqlock, Seq is odd while Counters are written.
+ * A Slot is 128 bytes so Controllers never share a cache line */
+typedef struct {
+    atomic_uint_least32_t Seq;
+    uint32_t Reserved;
+    TelemetryCounters_t Counters;
+    uint8_t Pad[128 - 8 - sizeof(TelemetryCounters_t)];
+} TelemetrySlot_t;
+
+/** @brief Shared Segment, Slots start after a 64 bytes Header */
+typedef struct {
+    char Magic[4];
+    uint16_t Version;
+    uint16_t SlotSize;
+    uint32_t Controllers;
+    uint8_t Reserved[52];
+    TelemetrySlot_t Slots[];
+} TelemetrySegment_t;
+
+/** @brief An opened Segment */
+typedef struct {
+    TelemetrySegment_t* Segment;
+    unsigned long Size;
+    void* Handle;
+} Telemetry_t;
+
+
+/** @brief Create (or open again) a Segment, all Counters are 0
+ * @param TELEMETRY Telemetry_t* Segment to open
+ * @param NAME const char* Shared memory name, "/name" on POSIX
+ * @param CONTROLLERS unsigned int Number of Controllers, 1 to TELEMETRY_MAX_CONTROLLERS
+ * @return bool true if Segment is created & false if not
+ */
+bool Telemetry_Create(Telemetry_t* TELEMETRY, const char* NAME, unsigned int CONTROLLERS);
+
+
+/** @brief Open a Segment created by another process, read only
+ * @param TELEMETRY Telemetry_t* Segment to open
+ * @param NAME const char* Shared memory name
+ * @return bool true if Segment is opened and its Header is known & false if not
+ */
+bool Telemetry_Attach(Telemetry_t* TELEMETRY, const char* NAME);
+
+
+/** @brief Publish Counters of one Controller, never blocks. One writer per Controller
+ * @param TELEMETRY Telemetry_t* Created Segment
+ * @param CONTROLLER unsigned int Controller number
+ * @param COUNTERS const TelemetryCounters_t* Counters
+ * @return void
+ */
+void Telemetry_Publish(Telemetry_t* TELEMETRY, unsigned int CONTROLLER, const TelemetryCounters_t* COUNTERS);
+
+
+/** @brief Read a consistent Snapshot of one Controller Counters, without stopping the writer
+ * @param TELEMETRY const Telemetry_t* Opened Segment
+ * @param CONTROLLER unsigned int Controller number
+ * @param COUNTERS TelemetryCounters_t* Snapshot
+ * @return bool true if Snapshot is read & false if there's no such Controller or the writer never let it be read
+ */
+bool Telemetry_Read(const Telemetry_t* TELEMETRY, unsigned int CONTROLLER, TelemetryCounters_t* COUNTERS);
+
+
+/** @brief Number of Controllers in a Segment
+ * @param TELEMETRY const Telemetry_t* Opened Segment
+ * @return unsigned int Controllers
+ */
+unsigned int Telemetry_Controllers(const Telemetry_t* TELEMETRY);
+
+
+/** @brief Unmap a Segment, it is kept for other processes
+ * @param TELEMETRY Telemetry_t* Opened Segment
+ * @return void
+ */
+void Telemetry_Close(Telemetry_t* TELEMETRY);
+
+
+/** @brief Remove a Segment name, processes which opened it keep it
+ * @param NAME const char* Shared memory name
+ * @return void
+ */
+void Telemetry_Remove(const char* NAME);
+
+
+/** @brief Collect this Controller Counters from Event Ring Records, Scheduler & Latency since last call and publish them
+ * as Controller 0, call it once every tick (it is a Scheduler Task in main.c)
+ * @param TELEMETRY Telemetry_t* Created Segment
+ * @return void
+ */
+void Telemetry_Update(Telemetry_t* TELEMETRY);
+
+#endif // TELEMETRY_H_INCLUDED
@@ -0,0 +1,100 @@
+/**
+ * @file alloc_guard.c
+ * @brief Allocation Guard main file
+ * @details Here we replace malloc, calloc, realloc & free of the C library for the whole test program.
+ * Outside a guarded part they call the C library ones. Inside, allocations are counted and sent to
+ * unity_malloc() which is told to fail them, so code under test can't allocate and every try is seen,
+ * even from Modules which don't include unity_fixture.h
+ *
+ */
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+ /*    Include Header    */
+#include"alloc_guard.h"
+
+ /*    Include Unity Memory, without its malloc macros so C library names can be defined here    */
+#include"../unity/unity_memory.h"
+#undef malloc
+#undef calloc
+#undef realloc
+#undef free
+
+/** @brief Guarding now or not, other threads may allocate at the same time */
+static atomic_int ARMED;
+
+/** @brief Allocation & free calls while guarding */
+static atomic_ulong CALLS;
+
+
+#if defined(__GLIBC__)
+
+/*    C library functions under their internal names    */
+extern void* __libc_malloc(size_t SIZE);
+extern void* __libc_calloc(size_t NUM, size_t SIZE);
+extern void* __libc_realloc(void* MEM, size_t SIZE);
+extern void  __libc_free(void* MEM);
+
+
+void* malloc(size_t SIZE){
+    if(atomic_load_explicit(&ARMED, memory_order_relaxed)){
+        atomic_fetch_add(&CALLS, 1);
+        return unity_malloc(SIZE);
+    }
+    return __libc_malloc(SIZE);
+}
+
+
+void* calloc(size_t NUM, size_t SIZE){
+    if(atomic_load_explicit(&ARMED, memory_order_relaxed)){
+        atomic_fetch_add(&CALLS, 1);
+        return unity_calloc(NUM, SIZE);
+    }
+    return __libc_calloc(NUM, SIZE);
+}
+
+
+void* realloc(void* MEM, size_t SIZE){
+    /* Old block is from the C library, it's kept as realloc does when it fails */
+    if(atomic_load_explicit(&ARMED, memory_order_relaxed)){
+        atomic_fetch_add(&CALLS, 1);
+        return NULL;
+    }
+    return __libc_realloc(MEM, SIZE);
+}
+
+
+void free(void* MEM){
+    if(MEM && atomic_load_explicit(&ARMED, memory_order_relaxed)){
+        atomic_fetch_add(&CALLS, 1);
+    }
+    __libc_free(MEM);
+}
+
+
+bool AllocGuard_Supported(void){
+    return true;
+}
+
+#else
+
+bool AllocGuard_Supported(void){
+    return false;
+}
+
+#endif
+
+
+void AllocGuard_Begin(void){
+    atomic_store(&CALLS, 0);
+    UnityMalloc_MakeMallocFailAfterCount(0);
+    atomic_store(&ARMED, 1);
+}
+
+
+unsigned long AllocGuard_End(void){
+    atomic_store(&ARMED, 0);
+    UnityMalloc_MakeMallocFailAfterCount(-1);
+    return atomic_load(&CALLS);
+}
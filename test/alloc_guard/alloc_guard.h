@@ -0,0 +1,34 @@
+/**
+ * @file alloc_guard.h
+ * @brief Allocation Guard header file
+ */
+
+#ifndef ALLOC_GUARD_H_INCLUDED
+#define ALLOC_GUARD_H_INCLUDED
+
+#include <stdbool.h>
+
+
+/** @brief Check if malloc & free of the whole program (Modules under test too) can be guarded,
+ * it needs C library functions to be replaced at link time (glibc)
+ * @param void
+ * @return bool true if Allocation Guard works & false if not
+ */
+bool AllocGuard_Supported(void);
+
+
+/** @brief Start guarding: from now every malloc, calloc & realloc is counted and fails
+ * through unity_malloc() (UnityMalloc_MakeMallocFailAfterCount(0)), free is counted only
+ * @param void
+ * @return void
+ */
+void AllocGuard_Begin(void);
+
+
+/** @brief Stop guarding, malloc & free work again
+ * @param void
+ * @return unsigned long Number of malloc, calloc, realloc & free calls since AllocGuard_Begin()
+ */
+unsigned long AllocGuard_End(void);
+
+#endif // ALLOC_GUARD_H_INCLUDED
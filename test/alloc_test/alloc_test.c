@@ -0,0 +1,179 @@
+/**
+ * @file alloc_test.c
+ * @brief Testing Control Loop doesn't allocate
+ * @details Here we apply Unit Test using Unity Test-Harness on the Control Loop (Update_Switch, Speed_Update & MotAngle_Write)
+ * running thousands of scheduler ticks while every malloc & free of the program is guarded. Speed_Update reads
+ * scripted States & Update_Switch reads scripted levels, so every rule & every debounce transition runs guarded
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../alloc_guard/alloc_guard.h"
+#include "../fake_switch/fake_switch.h"
+#include "../../source/speedcontrol/speedcontrol.h"
+#include "../../source/switches/switch.h"
+
+/** @brief Scheduler ticks before guarding, anything done once at start is allowed */
+#define WARMUP_TICKS        100
+
+/** @brief Guarded scheduler ticks */
+#define GUARDED_TICKS       10000
+
+/** @brief Switches Inputs repeated every 8 ticks, every Speed Update rule is applied */
+static const SpeedInput_t TICK_INPUTS[] = {
+    {PREPRESSED,  RELEASED,    RELEASED,  0},
+    {PRESSED,     RELEASED,    RELEASED,  0},
+    {PRERELEASED, PREPRESSED,  RELEASED,  0},
+    {RELEASED,    PRESSED,     PREPRESSED, 0},
+    {RELEASED,    PRERELEASED, PRESSED,   29},
+    {PREPRESSED,  RELEASED,    PRESSED,   30},
+    {PRESSED,     PREPRESSED,  PRESSED,   255},
+    {RELEASED,    RELEASED,    PRERELEASED, 0},
+};
+
+#define TICK_INPUTS_COUNT   (sizeof(TICK_INPUTS) / sizeof(TICK_INPUTS[0]))
+
+/** @brief Switches levels repeated every 8 ticks: RELEASED > PRE_PRESSED > PRESSED > PRE_RELEASED > PRE_PRESSED >
+ * PRE_RELEASED > RELEASED > PRE_PRESSED > PRE_RELEASED, so every State change of Update_Switch happens */
+static const bool TICK_LEVELS[] = {true, true, false, true, false, false, true, false};
+
+#define TICK_LEVELS_COUNT   (sizeof(TICK_LEVELS) / sizeof(TICK_LEVELS[0]))
+
+/** @brief Ticks run since setup & longest P Press Time seen */
+static unsigned int TICK;
+static unsigned char MAX_PRESS_TIME;
+
+/** @brief Scripted Switch level of this tick, P is also held 2 of every 3 seconds so its Press Time counts seconds
+ * @param SW Switch_t Which Switch
+ * @return bool true if pushed & false if not
+ */
+static bool Scripted_Level(Switch_t SW){
+    if(SW == P && TICK % (3 * SW_TICKS_PER_SECOND) < 2 * SW_TICKS_PER_SECOND){
+        return true;
+    }
+    return TICK_LEVELS[(TICK + (unsigned int)SW) % TICK_LEVELS_COUNT];
+}
+
+/** @brief Define (ALLOC) test group */
+TEST_GROUP(ALLOC);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(ALLOC){
+    SW_Init(POSTIVE);
+    SW_Init(NEGATIVE);
+    SW_Init(P);
+    FakeSW_Init(POSTIVE);
+    FakeSW_Init(NEGATIVE);
+    FakeSW_Init(P);
+    Speed_Init();
+    TICK = 0;
+    MAX_PRESS_TIME = 0;
+    UT_PTR_SET(Get_SWState, Get_FakeSW_State);
+    UT_PTR_SET(Get_PressTime, Get_FakeSW_PressTime);
+    UT_PTR_SET(Get_SWLevel, Scripted_Level);
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(ALLOC){
+    AllocGuard_End();
+    FakeSW_Destroy();
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Run Control Loop as main() does
+ * @param TICKS unsigned int Number of scheduler ticks
+ * @return long Sum of Motor Angles, so the Loop can't be removed
+ */
+static long Run_Ticks(unsigned int TICKS){
+    const SpeedInput_t* Input;
+    long Angles = 0;
+    unsigned int i;
+
+    for(i = 0; i < TICKS; i++){
+        Input = &TICK_INPUTS[i % TICK_INPUTS_COUNT];
+        Set_FakeSW_State(POSTIVE, Input->Postive_State);
+        Set_FakeSW_State(NEGATIVE, Input->Negative_State);
+        Set_FakeSW_State(P, Input->P_State);
+        Set_FakeSW_PressTime(Input->P_PressTime);
+
+        Update_Switch(P);
+        Update_Switch(POSTIVE);
+        Update_Switch(NEGATIVE);
+        Speed_Update();
+        Angles += MotAngle_Write();
+        if(Get_RealSW_PressTime() > MAX_PRESS_TIME){
+            MAX_PRESS_TIME = Get_RealSW_PressTime();
+        }
+        TICK++;
+    }
+    return Angles;
+}
+
+
+/*------------------Test Cases------------------*/
+
+
+/** <b> Test Description : </b> Allocation Guard sees allocations of the C library itself **/
+TEST(ALLOC, GuardSeesLibraryAllocation){
+    /*!
+		  * @par Given : Allocation Guard started
+		  * @par When  : strdup() allocates inside the C library
+		  * @par Then  : The allocation fails and is counted once
+	*/
+    char* Copy;
+
+    if(!AllocGuard_Supported()){
+        TEST_IGNORE_MESSAGE("malloc can't be replaced on this C library");
+    }
+
+    /* Act */
+    AllocGuard_Begin();
+    Copy = strdup("speed");
+
+    /* Assert */
+    LONGS_EQUAL(1, AllocGuard_End());
+    CHECK(Copy == NULL);
+}
+
+
+/** <b> Test Description : </b> Steady state Control Loop never allocates **/
+TEST(ALLOC, ControlLoopDoesNotAllocate){
+    /*!
+		  * @par Given : Control Loop after some warm up ticks
+		  * @par When  : 10,000 more ticks run with changing Switches Inputs & levels while Allocation Guard is started
+		  * @par Then  : No malloc, calloc, realloc or free is called & P Press Time counted seconds
+	*/
+    long Angles;
+
+    if(!AllocGuard_Supported()){
+        TEST_IGNORE_MESSAGE("malloc can't be replaced on this C library");
+    }
+
+    /* Arrange */
+    Run_Ticks(WARMUP_TICKS);
+
+    /* Act */
+    AllocGuard_Begin();
+    Angles = Run_Ticks(GUARDED_TICKS);
+
+    /* Assert */
+    LONGS_EQUAL(0, AllocGuard_End());
+    CHECK(Angles >= 10L * GUARDED_TICKS && Angles <= 140L * GUARDED_TICKS);
+    CHECK(MAX_PRESS_TIME >= 1);
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(ALLOC){
+    RUN_TEST_CASE(ALLOC, GuardSeesLibraryAllocation);
+    RUN_TEST_CASE(ALLOC, ControlLoopDoesNotAllocate);
+}
@@ -0,0 +1,159 @@
+/**
+ * @file chrome_trace_test.c
+ * @brief Testing Chrome Trace export
+ * @details Here we apply Unit Test using Unity Test-Harness on Chrome Trace which writes the Control Loop timeline
+ * of the Scheduler & Event Ring in Chrome trace-event JSON
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../fake_switch/fake_switch.h"
+#include "../../source/chrome_trace/chrome_trace.h"
+#include "../../source/event_ring/event_ring.h"
+#include "../../source/scheduler/scheduler.h"
+#include "../../source/speedcontrol/speedcontrol.h"
+#include "../../source/switches/switch.h"
+
+/** @brief Trace File written by the tests */
+#define TRACE_PATH      "chrome_trace_test.json"
+
+/** @brief Trace File text */
+static char TRACE[16 * 1024];
+
+/** @brief Define (CHROME) test group */
+TEST_GROUP(CHROME);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(CHROME){
+    SW_Init(POSTIVE);
+    SW_Init(NEGATIVE);
+    SW_Init(P);
+    Speed_Init();
+    FakeSW_Destroy();
+    EventRing_Reset();
+    UT_PTR_SET(Get_SWLevel, Get_FakeSW_Level);
+    UT_PTR_SET(Sched_OnTask, ChromeTrace_Task);
+    UT_PTR_SET(Sched_OnTick, ChromeTrace_Tick);
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(CHROME){
+    ChromeTrace_Close();
+    FakeSW_Destroy();
+    Sched_Init(NULL, 0);
+    remove(TRACE_PATH);
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Control Loop Tasks of +ve Switch */
+static void Update_Postive(void){
+    Update_Switch(POSTIVE);
+}
+
+static void Write_Angle(void){
+    MotAngle_Write();
+}
+
+static const SchedTask_t TASKS[] = {
+    {"Update_Switch(+ve)",  Update_Postive},
+    {"Speed_Update",        Speed_Update},
+    {"MotAngle_Write",      Write_Angle},
+};
+
+
+/** @brief Close Trace and read it in TRACE
+ * @param void
+ * @return void
+ */
+static void Read_Trace(void){
+    size_t Len;
+    FILE* File;
+
+    CHECK(ChromeTrace_Close());
+    File = fopen(TRACE_PATH, "rb");
+    CHECK(File != NULL);
+    Len = fread(TRACE, 1, sizeof(TRACE) - 1, File);
+    fclose(File);
+    TRACE[Len] = '\0';
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> Empty Trace is a JSON Array with track names only **/
+TEST(CHROME, EmptyTraceHasTrackNames){
+    /*!
+		  * @par Given : Opened Trace
+		  * @par When  : It is closed before any tick
+		  * @par Then  : It is a JSON Array naming the three tracks
+	*/
+
+    /* Act */
+    CHECK(ChromeTrace_Open(TRACE_PATH));
+    Read_Trace();
+
+    /* Assert */
+    CHECK(strncmp(TRACE, "[\n", 2) == 0);
+    CHECK(strcmp(TRACE + strlen(TRACE) - 3, "\n]\n") == 0);
+    CHECK(strstr(TRACE, "\"args\":{\"name\":\"Control Loop\"}") != NULL);
+    CHECK(strstr(TRACE, "\"args\":{\"name\":\"Events\"}") != NULL);
+    CHECK(strstr(TRACE, "\"args\":{\"name\":\"Edge to Motor Angle\"}") != NULL);
+}
+
+
+/** <b> Test Description : </b> Ticks, Tasks, Events and edge to Motor Angle change are traced **/
+TEST(CHROME, ButtonEdgeToMotorAngleIsTraced){
+    /*!
+		  * @par Given : Opened Trace and Scheduler running +ve Switch, Speed Update & Motor write
+		  * @par When  : One tick runs released then +ve is pushed for the next tick
+		  * @par Then  : Trace has both ticks, every Task, the Events and a +ve edge -> 10 degrees span
+	*/
+
+    /* Arrange */
+    CHECK(ChromeTrace_Open(TRACE_PATH));
+    CHECK(Sched_Init(TASKS, 3));
+
+    /* Act */
+    Sched_RunTick();
+    Set_FakeSW_Level(POSTIVE, true);
+    Sched_RunTick();
+    Read_Trace();
+
+    /* Assert */
+    CHECK(strstr(TRACE, "\"args\":{\"tick\":0}") != NULL);
+    CHECK(strstr(TRACE, "\"args\":{\"tick\":1}") != NULL);
+    CHECK(strstr(TRACE, "{\"name\":\"Speed_Update\",\"cat\":\"task\",\"ph\":\"X\"") != NULL);
+    CHECK(strstr(TRACE, "{\"name\":\"+ve -> PRE_PRESSED\",\"cat\":\"SWITCH\",\"ph\":\"i\"") != NULL);
+    CHECK(strstr(TRACE, "{\"name\":\"MED -> MAX\",\"cat\":\"SPEED\"") != NULL);
+    CHECK(strstr(TRACE, "{\"name\":\"+ve edge -> 10 degrees\",\"cat\":\"latency\",\"ph\":\"X\"") != NULL);
+}
+
+
+/** <b> Test Description : </b> Trace can't be opened in a missing Directory **/
+TEST(CHROME, OpenFailsOnBadPath){
+    /*!
+		  * @par Given : Path in a missing Directory
+		  * @par When  : ChromeTrace_Open() is called
+		  * @par Then  : It fails and ticks are not traced
+	*/
+    CHECK(!ChromeTrace_Open("missing_directory/trace.json"));
+    ChromeTrace_Tick(0, 0, 0);
+    CHECK(!ChromeTrace_Close());
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(CHROME){
+    RUN_TEST_CASE(CHROME, EmptyTraceHasTrackNames);
+    RUN_TEST_CASE(CHROME, ButtonEdgeToMotorAngleIsTraced);
+    RUN_TEST_CASE(CHROME, OpenFailsOnBadPath);
+}
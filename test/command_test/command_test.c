@@ -0,0 +1,291 @@
+/**
+ * @file command_test.c
+ * @brief Testing Command Socket
+ * @details Here we apply Unit Test using Unity Test-Harness on the Command Socket: Commands pushing virtual Switches
+ * through the Control Loop, bad Commands and batched Commands on a UNIX socket
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../../source/command/command.h"
+#include "../../source/speedcontrol/speedcontrol.h"
+#include "../../source/switches/switch.h"
+
+/** @brief Socket of the tests */
+#define COMMAND_TEST_SOCKET     "command_test.sock"
+
+/** @brief Reply of a Command */
+static char REPLY[COMMAND_LINE_MAX + 32];
+
+/** @brief Define (COMMAND) test group */
+TEST_GROUP(COMMAND);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(COMMAND){
+    SW_Init(POSTIVE);
+    SW_Init(NEGATIVE);
+    SW_Init(P);
+    Speed_Init();
+    Command_Reset();
+    UT_PTR_SET(Get_SWLevel, Command_Level);
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(COMMAND){
+    Command_Close();
+    Command_Reset();
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Run Control Loop ticks as main() does
+ * @param TICKS unsigned int Number of ticks
+ * @return void
+ */
+static void Run_Ticks(unsigned int TICKS){
+    unsigned int i;
+
+    for(i = 0; i < TICKS; i++){
+        Command_Poll();
+        Update_Switch(P);
+        Update_Switch(POSTIVE);
+        Update_Switch(NEGATIVE);
+        Speed_Update();
+        MotAngle_Write();
+    }
+}
+
+
+#ifdef __linux__
+/** @brief Open the Command Socket and connect a client to it
+ * @param void
+ * @return int Client socket
+ */
+static int Connect_Client(void){
+    struct sockaddr_un Address;
+    int Fd;
+
+    CHECK(Command_Open(COMMAND_TEST_SOCKET));
+    memset(&Address, 0, sizeof(Address));
+    Address.sun_family = AF_UNIX;
+    strcpy(Address.sun_path, COMMAND_TEST_SOCKET);
+    Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    CHECK(connect(Fd, (struct sockaddr*)&Address, sizeof(Address)) == 0);
+    Run_Ticks(1);
+    return Fd;
+}
+#endif
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> A press goes through debounce and steps Speed once **/
+TEST(COMMAND, PressStepsSpeedOnce){
+    /*!
+		  * @par Given : Motor at MED Speed
+		  * @par When  : "press +ve" is executed and 10 ticks are run
+		  * @par Then  : Speed is MAX and +ve Switch is RELEASED again
+	*/
+
+    /* Act */
+    CHECK(Command_Execute("press +ve", REPLY, sizeof(REPLY)));
+    Run_Ticks(10);
+
+    /* Assert */
+    STRCMP_EQUAL("ok", REPLY);
+    LONGS_EQUAL(MAX, Speed_Get());
+    LONGS_EQUAL(RELEASED, Get_RealSW_State(POSTIVE));
+}
+
+
+/** <b> Test Description : </b> Presses sent at once are queued and each one is a separate press **/
+TEST(COMMAND, QueuedPressesAreSeparate){
+    /*!
+		  * @par Given : Motor at MAX Speed
+		  * @par When  : "press -ve" is executed twice in the same tick and 10 ticks are run
+		  * @par Then  : Speed is MIN
+	*/
+
+    /* Arrange */
+    Speed_Set(MAX);
+
+    /* Act */
+    CHECK(Command_Execute("press -ve", REPLY, sizeof(REPLY)));
+    CHECK(Command_Execute("press -ve", REPLY, sizeof(REPLY)));
+    Run_Ticks(10);
+
+    /* Assert */
+    LONGS_EQUAL(MIN, Speed_Get());
+}
+
+
+/** <b> Test Description : </b> Holding P for 31 seconds is a long press **/
+TEST(COMMAND, HoldIsLongPress){
+    /*!
+		  * @par Given : Motor at MED Speed
+		  * @par When  : "hold p 31000 ms" is executed and 32 seconds of ticks are run
+		  * @par Then  : Speed is MIN and P is RELEASED again
+	*/
+
+    /* Act */
+    CHECK(Command_Execute("hold p 31000 ms", REPLY, sizeof(REPLY)));
+    Run_Ticks(29 * SW_TICKS_PER_SECOND);
+    LONGS_EQUAL(MED, Speed_Get());
+    Run_Ticks(3 * SW_TICKS_PER_SECOND);
+
+    /* Assert */
+    LONGS_EQUAL(MIN, Speed_Get());
+    LONGS_EQUAL(RELEASED, Get_RealSW_State(P));
+}
+
+
+/** <b> Test Description : </b> Bad Commands are answered with an error and change nothing **/
+TEST(COMMAND, BadCommandsAreRefused){
+    /*!
+		  * @par Given : Motor at MED Speed
+		  * @par When  : Bad Commands are executed
+		  * @par Then  : Every one is refused with an error, errors are counted and Speed is MED
+	*/
+    static const char* const BAD[] = {"fly", "press", "press x", "press +ve now", "hold p 10", "hold p abc ms", "hold p 0 ms", ""};
+    CommandStats_t Stats;
+    unsigned int i;
+
+    /* Act */
+    for(i = 0; i < sizeof(BAD) / sizeof(BAD[0]); i++){
+        CHECK(!Command_Execute(BAD[i], REPLY, sizeof(REPLY)));
+        CHECK(strncmp(REPLY, "error ", 6) == 0);
+    }
+    Run_Ticks(10);
+
+    /* Assert */
+    Command_Stats(&Stats);
+    LONGS_EQUAL(sizeof(BAD) / sizeof(BAD[0]), Stats.Errors);
+    LONGS_EQUAL(0, Stats.Commands);
+    LONGS_EQUAL(MED, Speed_Get());
+}
+
+
+/** <b> Test Description : </b> get speed & get stats read the Controller **/
+TEST(COMMAND, GetSpeedAndStats){
+    /*!
+		  * @par Given : Motor at MIN Speed
+		  * @par When  : "get speed" and "get stats" are executed
+		  * @par Then  : Speed & Angle are "MIN 140" and stats show the Speed & both Commands
+	*/
+
+    /* Arrange */
+    Speed_Set(MIN);
+
+    /* Act & Assert */
+    CHECK(Command_Execute("get speed", REPLY, sizeof(REPLY)));
+    STRCMP_EQUAL("MIN 140", REPLY);
+    CHECK(Command_Execute("get stats", REPLY, sizeof(REPLY)));
+    CHECK(strstr(REPLY, "speed MIN commands 2 errors 0") != NULL);
+}
+
+
+#ifdef __linux__
+/** <b> Test Description : </b> A batch of Commands on the socket is executed in one tick and answered in order **/
+TEST(COMMAND, SocketBatch){
+    /*!
+		  * @par Given : Command Socket and a connected client
+		  * @par When  : Client sends 3 Commands in one write, then "get speed" after 10 ticks
+		  * @par Then  : Replies are "ok", "MED 90" & an error after one tick and "MAX 10" at the end
+	*/
+    char Buffer[256];
+    ssize_t Got;
+    int Fd;
+
+    /* Arrange */
+    Fd = Connect_Client();
+
+    /* Act & Assert */
+    CHECK(write(Fd, "press +ve\nget speed\r\nbogus\n", 27) == 27);
+    Run_Ticks(1);
+    Got = recv(Fd, Buffer, sizeof(Buffer) - 1, MSG_DONTWAIT);
+    CHECK(Got > 0);
+    Buffer[Got] = '\0';
+    STRCMP_EQUAL("ok\nMED 90\nerror unknown command\n", Buffer);
+
+    Run_Ticks(10);
+    CHECK(write(Fd, "get speed\n", 10) == 10);
+    Run_Ticks(1);
+    Got = recv(Fd, Buffer, sizeof(Buffer) - 1, MSG_DONTWAIT);
+    CHECK(Got > 0);
+    Buffer[Got] = '\0';
+    STRCMP_EQUAL("MAX 10\n", Buffer);
+    close(Fd);
+}
+
+
+/** <b> Test Description : </b> A batch with more replies than a client's output holds is answered on next ticks **/
+TEST(COMMAND, SocketBatchOverOutput){
+    /*!
+		  * @par Given : Command Socket and a connected client
+		  * @par When  : Client sends 102 "get stats" in one write (~7 KiB of replies) and reads while ticks run
+		  * @par Then  : Client gets all 102 replies & is not dropped
+	*/
+    static char Batch[102 * 10 + 1];
+    static char Buffer[16384];
+    CommandStats_t Stats;
+    size_t Used = 0;
+    unsigned int Tick, Lines = 0;
+    ssize_t Got;
+    int Fd;
+    char* Line;
+
+    /* Arrange */
+    Fd = Connect_Client();
+    for(Tick = 0; Tick < 102; Tick++){
+        strcpy(Batch + Tick * 10, "get stats\n");
+    }
+
+    /* Act */
+    CHECK(write(Fd, Batch, 102 * 10) == 102 * 10);
+    for(Tick = 0; Tick < 20; Tick++){
+        Run_Ticks(1);
+        while((Got = recv(Fd, Buffer + Used, sizeof(Buffer) - 1 - Used, MSG_DONTWAIT)) > 0){
+            Used += (size_t)Got;
+        }
+    }
+    Buffer[Used] = '\0';
+    close(Fd);
+
+    /* Assert */
+    for(Line = strstr(Buffer, "ticks "); Line != NULL; Line = strstr(Line + 1, "\nticks ")){
+        Lines++;
+    }
+    LONGS_EQUAL(102, Lines);
+    Command_Stats(&Stats);
+    LONGS_EQUAL(102, Stats.Commands);
+    LONGS_EQUAL(0, Stats.Dropped);
+}
+#endif
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(COMMAND){
+    RUN_TEST_CASE(COMMAND, PressStepsSpeedOnce);
+    RUN_TEST_CASE(COMMAND, QueuedPressesAreSeparate);
+    RUN_TEST_CASE(COMMAND, HoldIsLongPress);
+    RUN_TEST_CASE(COMMAND, BadCommandsAreRefused);
+    RUN_TEST_CASE(COMMAND, GetSpeedAndStats);
+#ifdef __linux__
+    RUN_TEST_CASE(COMMAND, SocketBatch);
+    RUN_TEST_CASE(COMMAND, SocketBatchOverOutput);
+#endif
+}
@@ -0,0 +1,260 @@
+/**
+ * @file event_ring_test.c
+ * @brief Testing Event Ring
+ * @details Here we apply Unit Test using Unity Test-Harness on Event Ring and on the Events recorded by
+ * Update_Switch(), Speed_Increase(), Speed_Decrease() & MotAngle_Write()
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../fake_switch/fake_switch.h"
+#include "../../source/event_ring/event_ring.h"
+#include "../../source/speedcontrol/speedcontrol.h"
+#include "../../source/switches/switch.h"
+
+/** @brief Records copied from the Ring */
+static EventRecord_t RECORDS[EVENT_RING_SIZE];
+
+/** @brief Define (EVENT) test group */
+TEST_GROUP(EVENT);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(EVENT){
+    SW_Init(POSTIVE);
+    SW_Init(NEGATIVE);
+    SW_Init(P);
+    Speed_Init();
+    FakeSW_Destroy();
+    EventRing_Reset();
+    UT_PTR_SET(Get_SWLevel, Get_FakeSW_Level);
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(EVENT){
+    FakeSW_Destroy();
+    EventRing_Reset();
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Update P Switch some ticks with the same Level
+ * @param PUSHED bool Level of P Switch pin
+ * @param TICKS unsigned int Number of ticks
+ * @return void
+ */
+static void Update_P(bool PUSHED, unsigned int TICKS){
+    unsigned int i;
+
+    Set_FakeSW_Level(P, PUSHED);
+    for(i = 0; i < TICKS; i++){
+        Update_Switch(P);
+    }
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> Every Switch State change is recorded once **/
+TEST(EVENT, SwitchStateChangesAreRecorded){
+    /*!
+		  * @par Given : Released P Switch
+		  * @par When  : It is pushed for 3 ticks then let go for 3 ticks
+		  * @par Then  : PRE_PRESSED, PRESSED, PRE_RELEASED & RELEASED are recorded in order
+	*/
+    static const SwitchState_t EXPECTED[] = {PREPRESSED, PRESSED, PRERELEASED, RELEASED};
+    unsigned int Count, i;
+
+    /* Act */
+    Update_P(true, 3);
+    LONGS_EQUAL(PRESSED, Get_RealSW_State(P));
+    Update_P(false, 3);
+    Count = EventRing_Snapshot(RECORDS, EVENT_RING_SIZE);
+
+    /* Assert */
+    LONGS_EQUAL(RELEASED, Get_RealSW_State(P));
+    LONGS_EQUAL(4, Count);
+    for(i = 0; i < Count; i++){
+        LONGS_EQUAL(EVENT_SWITCH_STATE, RECORDS[i].Id);
+        LONGS_EQUAL(P, RECORDS[i].Arg);
+        LONGS_EQUAL(EXPECTED[i], RECORDS[i].Payload & 0xFF);
+        LONGS_EQUAL(i + 1, RECORDS[i].Seq);
+    }
+}
+
+
+/** <b> Test Description : </b> One tick bounce never reaches PRESSED **/
+TEST(EVENT, BounceIsDebounced){
+    /*!
+		  * @par Given : Released +ve Switch
+		  * @par When  : It is pushed for one tick only
+		  * @par Then  : It goes PRE_PRESSED, PRE_RELEASED then RELEASED
+	*/
+
+    /* Act */
+    Set_FakeSW_Level(POSTIVE, true);
+    Update_Switch(POSTIVE);
+    Set_FakeSW_Level(POSTIVE, false);
+    Update_Switch(POSTIVE);
+    Update_Switch(POSTIVE);
+
+    /* Assert */
+    LONGS_EQUAL(3, EventRing_Snapshot(RECORDS, EVENT_RING_SIZE));
+    LONGS_EQUAL(PREPRESSED, RECORDS[0].Payload);
+    LONGS_EQUAL(PRERELEASED, RECORDS[1].Payload);
+    LONGS_EQUAL(RELEASED, RECORDS[2].Payload);
+}
+
+
+/** <b> Test Description : </b> P Press Time counts seconds while P is PRESSED **/
+TEST(EVENT, PressTimeCountsSeconds){
+    /*!
+		  * @par Given : Released P Switch
+		  * @par When  : It is pushed for 2 seconds after being PRESSED
+		  * @par Then  : Press Time is 2 and it is recorded when P is let go
+	*/
+
+    /* Act */
+    Update_P(true, 1 + 2 * SW_TICKS_PER_SECOND);
+    LONGS_EQUAL(2, Get_RealSW_PressTime());
+    Update_P(false, 1);
+
+    /* Assert */
+    LONGS_EQUAL(3, EventRing_Snapshot(RECORDS, EVENT_RING_SIZE));
+    LONGS_EQUAL(PRERELEASED | (2 << 8), RECORDS[2].Payload);
+}
+
+
+/** <b> Test Description : </b> Speed changes are recorded, no change no Record **/
+TEST(EVENT, SpeedChangesAreRecorded){
+    /*!
+		  * @par Given : Motor at MED Speed
+		  * @par When  : Speed is Increased twice then Decreased
+		  * @par Then  : MED -> MAX & MAX -> MED are recorded only
+	*/
+
+    /* Act */
+    Speed_Increase();
+    Speed_Increase();
+    Speed_Decrease();
+
+    /* Assert */
+    LONGS_EQUAL(2, EventRing_Snapshot(RECORDS, EVENT_RING_SIZE));
+    LONGS_EQUAL(EVENT_SPEED, RECORDS[0].Id);
+    LONGS_EQUAL(MED, RECORDS[0].Arg);
+    LONGS_EQUAL(MAX, RECORDS[0].Payload);
+    LONGS_EQUAL(MAX, RECORDS[1].Arg);
+    LONGS_EQUAL(MED, RECORDS[1].Payload);
+}
+
+
+/** <b> Test Description : </b> Motor Angle writes are recorded when the Angle changes **/
+TEST(EVENT, MotorAngleChangesAreRecorded){
+    /*!
+		  * @par Given : Motor at MED Speed
+		  * @par When  : Motor Angle is written twice, Speed is increased then Motor Angle is written again
+		  * @par Then  : 90 degrees is recorded once, then the Speed change & 10 degrees
+	*/
+
+    /* Act */
+    MotAngle_Write();
+    MotAngle_Write();
+    Speed_Increase();
+    MotAngle_Write();
+
+    /* Assert */
+    LONGS_EQUAL(3, EventRing_Snapshot(RECORDS, EVENT_RING_SIZE));
+    LONGS_EQUAL(EVENT_MOTOR_ANGLE, RECORDS[0].Id);
+    LONGS_EQUAL(MED, RECORDS[0].Arg);
+    LONGS_EQUAL(90, RECORDS[0].Payload);
+    LONGS_EQUAL(EVENT_SPEED, RECORDS[1].Id);
+    LONGS_EQUAL(EVENT_MOTOR_ANGLE, RECORDS[2].Id);
+    LONGS_EQUAL(MAX, RECORDS[2].Arg);
+    LONGS_EQUAL(10, RECORDS[2].Payload);
+    CHECK(RECORDS[2].Time >= RECORDS[0].Time);
+}
+
+
+/** <b> Test Description : </b> Full Ring overwrites oldest Records **/
+TEST(EVENT, OldestRecordsAreOverwritten){
+    /*!
+		  * @par Given : Empty Ring
+		  * @par When  : 10 Records more than its size are added
+		  * @par Then  : The newest EVENT_RING_SIZE Records are kept in order
+	*/
+    unsigned int Count, i;
+
+    /* Act */
+    for(i = 0; i < EVENT_RING_SIZE + 10; i++){
+        EventRing_Record(EVENT_MOTOR_ANGLE, 0, i);
+    }
+    Count = EventRing_Snapshot(RECORDS, EVENT_RING_SIZE);
+
+    /* Assert */
+    LONGS_EQUAL(EVENT_RING_SIZE, Count);
+    for(i = 0; i < Count; i++){
+        LONGS_EQUAL(i + 10, RECORDS[i].Payload);
+        LONGS_EQUAL(i + 11, RECORDS[i].Seq);
+    }
+    LONGS_EQUAL(3, EventRing_Snapshot(RECORDS, 3));
+    LONGS_EQUAL(EVENT_RING_SIZE + 7, RECORDS[0].Payload);
+}
+
+
+/** <b> Test Description : </b> Raw Dump has its Header and all Slots **/
+TEST(EVENT, RawDumpHasHeaderAndSlots){
+    /*!
+		  * @par Given : Ring with one Record
+		  * @par When  : Raw Dump is written to a File
+		  * @par Then  : Header is right and the Record is in the first Slot
+	*/
+    unsigned char Header[EVENT_RING_HEADER_SIZE];
+    EventRecord_t Record;
+    uint32_t Count;
+    long Size;
+    FILE* File = tmpfile();
+
+    /* Arrange */
+    CHECK(File != NULL);
+    EventRing_Record(EVENT_SPEED, MIN, MED);
+
+    /* Act */
+    CHECK(EventRing_WriteRaw(fileno(File)));
+
+    /* Assert */
+    fseek(File, 0, SEEK_END);
+    Size = ftell(File);
+    rewind(File);
+    LONGS_EQUAL(EVENT_RING_HEADER_SIZE + EVENT_RING_SIZE * sizeof(EventRecord_t), Size);
+    CHECK(fread(Header, 1, sizeof(Header), File) == sizeof(Header));
+    CHECK(fread(&Record, sizeof(Record), 1, File) == 1);
+    fclose(File);
+
+    CHECK(memcmp(Header, EVENT_RING_MAGIC, 4) == 0);
+    LONGS_EQUAL(EVENT_RING_VERSION, Header[4]);
+    LONGS_EQUAL(sizeof(EventRecord_t), Header[5]);
+    memcpy(&Count, Header + 8, sizeof(Count));
+    LONGS_EQUAL(EVENT_RING_SIZE, Count);
+    LONGS_EQUAL(1, Record.Seq);
+    LONGS_EQUAL(EVENT_SPEED, Record.Id);
+    LONGS_EQUAL(MED, Record.Payload);
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(EVENT){
+    RUN_TEST_CASE(EVENT, SwitchStateChangesAreRecorded);
+    RUN_TEST_CASE(EVENT, BounceIsDebounced);
+    RUN_TEST_CASE(EVENT, PressTimeCountsSeconds);
+    RUN_TEST_CASE(EVENT, SpeedChangesAreRecorded);
+    RUN_TEST_CASE(EVENT, MotorAngleChangesAreRecorded);
+    RUN_TEST_CASE(EVENT, OldestRecordsAreOverwritten);
+    RUN_TEST_CASE(EVENT, RawDumpHasHeaderAndSlots);
+}
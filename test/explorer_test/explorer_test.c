@@ -0,0 +1,104 @@
+/**
+ * @file explorer_test.c
+ * @brief Testing Speed Update on the whole State Space
+ * @details Here we apply Unit Test using Unity Test-Harness on Speed Update for every Speed, Switches States
+ * combination, P Press Time class and every Input sequence of length 2, compared with the Reference Model
+ *
+ */
+
+#include <stdio.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../state_explorer/state_explorer.h"
+
+/** @brief Explorer Report of the last test */
+static ExplorerReport_t REPORT;
+
+/** @brief Define (EXPLORER) test group */
+TEST_GROUP(EXPLORER);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(EXPLORER){
+
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(EXPLORER){
+
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Speed Update with a boundary bug, P Switch must be pressed more than 30 to decrease Speed
+ * @param CTL SpeedController_t* Controller
+ * @param INPUT const SpeedInput_t* Switches States & P Press Time
+ * @return unsigned int Switches whose rule was applied
+ */
+static unsigned int Update_WrongBoundary(SpeedController_t* CTL, const SpeedInput_t* INPUT){
+    SpeedInput_t Input = *INPUT;
+
+    if(Input.P_PressTime == 30){
+        Input.P_PressTime = 29;
+    }
+    return SpeedCtl_Update(CTL, &Input);
+}
+
+
+/*------------------Test Cases------------------*/
+
+
+/** <b> Test Description : </b> Every single Speed Update matches the Reference Model **/
+TEST(EXPLORER, EveryInputFromEverySpeed){
+    /*!
+		  * @par Given : 3 Speeds and 384 Inputs (4 x 4 x 4 Switches States x 6 Press Time classes)
+		  * @par When  : One Speed Update is done for every Speed & Input
+		  * @par Then  : Motor Angle matches the Reference Model after all 1152 Speed Updates
+	*/
+    CHECK(Explorer_Run(SpeedCtl_Update, 1, &REPORT));
+    LONGS_EQUAL(EXPLORER_SPEEDS * EXPLORER_INPUTS, REPORT.Sequences);
+    LONGS_EQUAL(8, REPORT.Transitions);
+}
+
+
+/** <b> Test Description : </b> Every Input sequence of length 2 matches the Reference Model **/
+TEST(EXPLORER, EverySequenceOfTwoInputs){
+    /*!
+		  * @par Given : 3 Speeds and 384 x 384 Input sequences
+		  * @par When  : Each sequence is applied from each Speed
+		  * @par Then  : Motor Angle matches after every Speed Update & all 21 pairs of Speed transitions are reached (1-switch coverage)
+	*/
+    CHECK(Explorer_Run(SpeedCtl_Update, 2, &REPORT));
+    LONGS_EQUAL(EXPLORER_SPEEDS * EXPLORER_INPUTS * EXPLORER_INPUTS, REPORT.Sequences);
+    LONGS_EQUAL(8, REPORT.Transitions);
+    LONGS_EQUAL(21, REPORT.TransitionPairs);
+}
+
+
+/** <b> Test Description : </b> Explorer finds a Press Time boundary bug **/
+TEST(EXPLORER, BoundaryBugIsFound){
+    /*!
+		  * @par Given : Speed Update which ignores P Press Time equal to 30
+		  * @par When  : It is explored
+		  * @par Then  : A shortest failed sequence is one Input with P PRESSED for 30 from MED Speed
+	*/
+    CHECK(!Explorer_Run(Update_WrongBoundary, 2, &REPORT));
+    CHECK(REPORT.Failed);
+    LONGS_EQUAL(1, REPORT.Length);
+    LONGS_EQUAL(1, REPORT.StartSpeed);
+    LONGS_EQUAL(PRESSED, REPORT.Inputs[0].P_State);
+    LONGS_EQUAL(30, REPORT.Inputs[0].P_PressTime);
+    CHECK(REPORT.Expected != REPORT.Actual);
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(EXPLORER){
+    RUN_TEST_CASE(EXPLORER, EveryInputFromEverySpeed);
+    RUN_TEST_CASE(EXPLORER, EverySequenceOfTwoInputs);
+    RUN_TEST_CASE(EXPLORER, BoundaryBugIsFound);
+}
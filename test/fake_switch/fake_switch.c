@@ -16,15 +16,10 @@ static SwitchState_t NEGATIVE_SWITCH_STATE;
 static SwitchState_t P_SWITCH_STATE;
 
 /** @brief A variable to store Press Time for switch */
-unsigned char PRESS_TIME;
+static unsigned char PRESS_TIME;
 
-/** @brief Check Whether Switch value Out of Bounds or not
- * @param SW Switch_t Tested Value
- * @return bool true if Switch value Out of Bounds & False if not
- */
-bool IsOutOfBounds(Switch_t SW){
-    return (SW < 0) || (SW > 2);
-}
+/** @brief A variable to store Switches pin Level */
+static bool SWITCH_LEVEL[3];
 
 void Set_FakeSW_State(Switch_t SW, SwitchState_t STATE){
     switch(SW){
@@ -57,6 +52,7 @@ SwitchState_t Get_FakeSW_State(Switch_t SW){
     default:
         break;
     }
+    return RELEASED;
 }
 
 
@@ -92,9 +88,24 @@ unsigned char Get_FakeSW_PressTime(void){
 }
 
 
+void Set_FakeSW_Level(Switch_t SW, bool PUSHED){
+    if(!IsOutOfBounds(SW)){
+        SWITCH_LEVEL[SW] = PUSHED;
+    }
+}
+
+
+bool Get_FakeSW_Level(Switch_t SW){
+    return !IsOutOfBounds(SW) && SWITCH_LEVEL[SW];
+}
+
+
 void FakeSW_Destroy(){
     FakeSW_Init(POSTIVE);
     FakeSW_Init(NEGATIVE);
     FakeSW_Init(P);
     Set_FakeSW_PressTime(0);
+    Set_FakeSW_Level(POSTIVE, false);
+    Set_FakeSW_Level(NEGATIVE, false);
+    Set_FakeSW_Level(P, false);
 }
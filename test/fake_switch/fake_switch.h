@@ -46,6 +46,21 @@ void Set_FakeSW_PressTime(unsigned char TIME);
 unsigned char Get_FakeSW_PressTime(void);
 
 
+/** @brief Set Level of Switch pin, Update_Switch() reads it
+ * @param SW Switch_t Which Switch to apply this function on
+ * @param PUSHED bool true if Switch is pushed
+ * @return void
+ */
+void Set_FakeSW_Level(Switch_t SW, bool PUSHED);
+
+
+/** @brief Get Level of Switch pin
+ * @param SW Switch_t Which Switch to apply this function on
+ * @return bool true if Switch is pushed & false if not
+ */
+bool Get_FakeSW_Level(Switch_t SW);
+
+
 /** @brief Initialize everything again
  * @param void
  * @return void
@@ -0,0 +1,40 @@
+/**
+ * @file fuzz.h
+ * @brief Fuzz Targets header file
+ * @details Fuzz Targets are built with clang libFuzzer: <br>
+ * clang -g -O1 -fsanitize=fuzzer,address,undefined -o fuzz_trace test/fuzz/fuzz_trace.c
+ * test/trace_reader/trace_reader.c test/trace_reader/trace_index.c <br>
+ * clang -g -O1 -fsanitize=fuzzer,address,undefined -o fuzz_speed test/fuzz/fuzz_speed.c
+ * source/speedcontrol/speedcontrol.c source/switches/switch.c source/event_ring/event_ring.c source/latency/latency.c source/profile/profile.c
+ * test/fake_switch/fake_switch.c test/reference_model/reference_model.c <br>
+ * then run: ./fuzz_trace -dict=test/fuzz/trace.dict test/fuzz/corpus/trace <br>
+ * Without libFuzzer (gcc, MinGW) add test/fuzz/fuzz_driver.c to the same files, it runs saved inputs
+ * (crash files, corpus) or random inputs
+ */
+
+#ifndef FUZZ_H_INCLUDED
+#define FUZZ_H_INCLUDED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Stop at once if an invariant is broken, libFuzzer saves the input that broke it */
+#define FUZZ_CHECK(COND)                                                            \
+    do{                                                                             \
+        if(!(COND)){                                                                \
+            fprintf(stderr, "%s:%d: invariant failed: %s\n", __FILE__, __LINE__, #COND); \
+            abort();                                                                \
+        }                                                                           \
+    }while(0)
+
+
+/** @brief Fuzz Target entry called by libFuzzer or fuzz_driver.c for every input
+ * @param DATA const uint8_t* Input bytes
+ * @param SIZE size_t Number of Input bytes
+ * @return int Always 0
+ */
+int LLVMFuzzerTestOneInput(const uint8_t* DATA, size_t SIZE);
+
+#endif // FUZZ_H_INCLUDED
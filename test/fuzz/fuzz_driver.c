@@ -0,0 +1,191 @@
+/**
+ * @file fuzz_driver.c
+ * @brief Fuzz Driver for compilers without libFuzzer
+ * @details Here we call a Fuzz Target on saved inputs (crash files from libFuzzer, corpus files)
+ * or on random inputs. Random inputs are random bytes, or corpus files with a few random changes
+ * (byte changed, inserted, removed or input cut) if corpus files are given. <br>
+ * Usage: fuzz_driver FILE... <br>
+ * Usage: fuzz_driver -n RUNS [-s SEED] [-m MAX_SIZE] [CORPUS_FILE...]
+ *
+ */
+
+#include <string.h>
+
+#include"fuzz.h"
+
+
+/** @brief Next random number (xorshift64*)
+ * @param STATE uint64_t* Random generator state, never 0
+ * @return uint64_t Random number
+ */
+static uint64_t Driver_Random(uint64_t* STATE){
+    *STATE ^= *STATE >> 12;
+    *STATE ^= *STATE << 25;
+    *STATE ^= *STATE >> 27;
+    return *STATE * 0x2545F4914F6CDD1DULL;
+}
+
+
+/** @brief One input File */
+typedef struct {
+    uint8_t* Data;
+    size_t Size;
+} DriverInput_t;
+
+
+/** @brief Read an input File
+ * @param PATH const char* Input File
+ * @param INPUT DriverInput_t* File content, free Data after use
+ * @return int 1 if the File is read & 0 if not
+ */
+static int Driver_ReadFile(const char* PATH, DriverInput_t* INPUT){
+    long Size;
+    FILE* File = fopen(PATH, "rb");
+
+    if(!File){
+        return 0;
+    }
+    fseek(File, 0, SEEK_END);
+    Size = ftell(File);
+    fseek(File, 0, SEEK_SET);
+    INPUT->Size = (Size > 0) ? (size_t)Size : 0;
+    INPUT->Data = malloc(INPUT->Size ? INPUT->Size : 1);
+    if(!INPUT->Data || fread(INPUT->Data, 1, INPUT->Size, File) != INPUT->Size){
+        free(INPUT->Data);
+        fclose(File);
+        return 0;
+    }
+    fclose(File);
+    return 1;
+}
+
+
+/** @brief Change a few random bytes of an input
+ * @param DATA uint8_t* Input, MAX_SIZE bytes can be used
+ * @param SIZE size_t Input size
+ * @param MAX_SIZE size_t Largest input size
+ * @param STATE uint64_t* Random generator state
+ * @return size_t New input size
+ */
+static size_t Driver_Mutate(uint8_t* DATA, size_t SIZE, size_t MAX_SIZE, uint64_t* STATE){
+    unsigned int Changes = 1 + (unsigned int)(Driver_Random(STATE) % 8);
+    size_t Pos;
+
+    while(Changes--){
+        Pos = SIZE ? (size_t)(Driver_Random(STATE) % SIZE) : 0;
+        switch(Driver_Random(STATE) % 5){
+        case 0:
+            if(SIZE){
+                DATA[Pos] ^= (uint8_t)(1u << (Driver_Random(STATE) % 8));
+            }
+            break;
+        case 1:
+            if(SIZE){
+                DATA[Pos] = (uint8_t)Driver_Random(STATE);
+            }
+            break;
+        case 2:
+            if(SIZE < MAX_SIZE){
+                memmove(DATA + Pos + 1, DATA + Pos, SIZE - Pos);
+                DATA[Pos] = (uint8_t)Driver_Random(STATE);
+                SIZE++;
+            }
+            break;
+        case 3:
+            if(SIZE){
+                memmove(DATA + Pos, DATA + Pos + 1, SIZE - Pos - 1);
+                SIZE--;
+            }
+            break;
+        default:
+            SIZE = Pos;
+            break;
+        }
+    }
+    return SIZE;
+}
+
+
+/** @brief main function run Fuzz Target on Files or random inputs
+ * @param argc int
+ * @param argv[] char*
+ * @return int 0 if all inputs ran & 1 if there's an error (a broken invariant aborts)
+ */
+int main(int argc, char* argv[])
+{
+    DriverInput_t* Corpus = NULL;
+    DriverInput_t Input;
+    unsigned long Runs = 0, Run;
+    uint64_t State = 1;
+    size_t MaxSize = 4096, Size, i;
+    uint8_t* Data;
+    int Arg, Files = 0;
+
+    if(argc > 1 && strcmp(argv[1], "-n") != 0){
+        for(Arg = 1; Arg < argc; Arg++){
+            if(!Driver_ReadFile(argv[Arg], &Input)){
+                fprintf(stderr, "Failed To read %s\n", argv[Arg]);
+                return 1;
+            }
+            LLVMFuzzerTestOneInput(Input.Data, Input.Size);
+            free(Input.Data);
+        }
+        printf("%d input(s) passed\n", argc - 1);
+        return 0;
+    }
+
+    for(Arg = 1; Arg + 1 < argc; Arg += 2){
+        if(strcmp(argv[Arg], "-n") == 0){
+            Runs = strtoul(argv[Arg + 1], NULL, 10);
+        }else if(strcmp(argv[Arg], "-s") == 0){
+            State = strtoull(argv[Arg + 1], NULL, 10);
+        }else if(strcmp(argv[Arg], "-m") == 0){
+            MaxSize = strtoul(argv[Arg + 1], NULL, 10);
+        }else{
+            break;
+        }
+    }
+    if(Runs == 0 || MaxSize == 0 || (Arg < argc && argv[Arg][0] == '-')){
+        fprintf(stderr, "Usage: %s FILE... | -n RUNS [-s SEED] [-m MAX_SIZE] [CORPUS_FILE...]\n", argv[0]);
+        return 1;
+    }
+    if(State == 0){
+        State = 0x9E3779B97F4A7C15ULL;
+    }
+
+    Corpus = malloc(sizeof(DriverInput_t) * (size_t)(argc - Arg + 1));
+    Data = malloc(MaxSize);
+    if(!Corpus || !Data){
+        return 1;
+    }
+    for(; Arg < argc; Arg++){
+        if(!Driver_ReadFile(argv[Arg], &Corpus[Files])){
+            fprintf(stderr, "Failed To read %s\n", argv[Arg]);
+            return 1;
+        }
+        Files++;
+    }
+
+    for(Run = 0; Run < Runs; Run++){
+        if(Files != 0){
+            Input = Corpus[Driver_Random(&State) % (uint64_t)Files];
+            Size = (Input.Size < MaxSize) ? Input.Size : MaxSize;
+            memcpy(Data, Input.Data, Size);
+            Size = Driver_Mutate(Data, Size, MaxSize, &State);
+        }else{
+            Size = (size_t)(Driver_Random(&State) % (MaxSize + 1));
+            for(i = 0; i < Size; i++){
+                Data[i] = (uint8_t)Driver_Random(&State);
+            }
+        }
+        LLVMFuzzerTestOneInput(Data, Size);
+    }
+
+    while(Files--){
+        free(Corpus[Files].Data);
+    }
+    free(Corpus);
+    free(Data);
+    printf("%lu random input(s) passed\n", Runs);
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file fuzz_speed.c
+ * @brief Speed Update Fuzz Target
+ * @details Here we turn any bytes into a sequence of Switches Inputs, 2 bytes per Speed Update: <br>
+ * byte 0 bits 0-1 +ve State, bits 2-3 -ve State, bits 4-5 P State, bit 6 makes all States unknown values,
+ * bit 7 starts again from default Speed (Speed_Init) <br>
+ * byte 1 P Press Time <br>
+ * Inputs go through the Fake Switches to Speed_Update like the Control Loop. <br>
+ * Invariants: Motor Angle is always 140, 90 or 10 and always the one of the Reference Model
+ *
+ */
+
+#include"fuzz.h"
+
+/*    Include Modules under test    */
+#include"../fake_switch/fake_switch.h"
+#include"../reference_model/reference_model.h"
+#include"../../source/speedcontrol/speedcontrol.h"
+#include"../../source/switches/switch.h"
+
+
+int LLVMFuzzerTestOneInput(const uint8_t* DATA, size_t SIZE){
+    SpeedInput_t Input;
+    unsigned char Speed = REF_SPEED_MED;
+    short Angle;
+    size_t i;
+
+    FakeSW_Destroy();
+    Get_SWState = Get_FakeSW_State;
+    Get_PressTime = Get_FakeSW_PressTime;
+    Speed_Init();
+
+    for(i = 0; i + 1 < SIZE; i += 2){
+        if(DATA[i] & 0x80){
+            Speed_Init();
+            Speed = REF_SPEED_MED;
+        }
+
+        Input.Postive_State = (SwitchState_t)(DATA[i] & 0x03);
+        Input.Negative_State = (SwitchState_t)((DATA[i] >> 2) & 0x03);
+        Input.P_State = (SwitchState_t)((DATA[i] >> 4) & 0x03);
+        if(DATA[i] & 0x40){
+            Input.Postive_State += 4;
+            Input.Negative_State += 4;
+            Input.P_State += 4;
+        }
+        Input.P_PressTime = DATA[i + 1];
+
+        Set_FakeSW_State(POSTIVE, Input.Postive_State);
+        Set_FakeSW_State(NEGATIVE, Input.Negative_State);
+        Set_FakeSW_State(P, Input.P_State);
+        Set_FakeSW_PressTime(Input.P_PressTime);
+
+        Speed_Update();
+        Speed = RefModel_Step(Speed, &Input);
+        Angle = MotAngle_Write();
+
+        FUZZ_CHECK(Angle == 140 || Angle == 90 || Angle == 10);
+        FUZZ_CHECK(Angle == RefModel_Angle(Speed));
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file fuzz_trace.c
+ * @brief Trace Reader Fuzz Target
+ * @details Here we feed any bytes to the Trace Reader as a Text or Binary Trace (Binary if it starts with
+ * the Binary Header), read all Lines, then index it and seek every Test Case. <br>
+ * Input is copied to a buffer of its exact size so reading past it is found by AddressSanitizer. <br>
+ * Invariants: every Data Line has known States, reading moves forward and ends, every indexed Test Case
+ * is found again with the same number of Lines
+ *
+ */
+
+#include <string.h>
+
+#include"fuzz.h"
+
+/*    Include Modules under test    */
+#include"../trace_reader/trace_reader.h"
+#include"../trace_reader/trace_index.h"
+
+
+/** @brief Check State read from a Trace
+ * @param STATE SwitchState_t State
+ * @return int 1 if it is a known State & 0 if not
+ */
+static int Fuzz_KnownState(SwitchState_t STATE){
+    return STATE == PREPRESSED || STATE == PRESSED || STATE == PRERELEASED || STATE == RELEASED;
+}
+
+
+int LLVMFuzzerTestOneInput(const uint8_t* DATA, size_t SIZE){
+    TraceReader_t Reader;
+    TraceIndex_t Index;
+    TraceLine_t Line;
+    TraceStatus_t Status;
+    unsigned long Case, Lines, Reads = 0;
+    size_t Pos;
+    char* Copy = malloc(SIZE ? SIZE : 1);
+
+    if(!Copy){
+        return 0;
+    }
+    memcpy(Copy, DATA, SIZE);
+
+    if(Trace_OpenMemory(&Reader, Copy, SIZE)){
+
+        /* Every Read moves forward, so there are at most SIZE + 1 of them */
+        do{
+            Pos = Reader.Pos;
+            Status = Trace_ReadLine(&Reader, &Line);
+            FUZZ_CHECK(Reader.Pos <= Reader.Size);
+            FUZZ_CHECK(Status == TRACE_END_OF_FILE || Reader.Pos > Pos);
+            if(Status == TRACE_DATA){
+                FUZZ_CHECK(Fuzz_KnownState(Line.Postive_State));
+                FUZZ_CHECK(Fuzz_KnownState(Line.Negative_State));
+                FUZZ_CHECK(Fuzz_KnownState(Line.P_State));
+            }
+            FUZZ_CHECK(++Reads <= SIZE + 1);
+        }while(Status != TRACE_END_OF_FILE);
+
+        /* Every indexed Test Case has the same Lines when read again */
+        if(TraceIndex_Build(&Index, &Reader)){
+            for(Case = 0; Case < Index.Count; Case++){
+                FUZZ_CHECK(TraceIndex_Seek(&Index, &Reader, Case));
+                Lines = 0;
+                while((Status = Trace_ReadLine(&Reader, &Line)) == TRACE_DATA || Status == TRACE_INCORRECT){
+                    Lines++;
+                }
+                FUZZ_CHECK(Lines == Index.Cases[Case].Lines);
+            }
+            FUZZ_CHECK(!TraceIndex_Seek(&Index, &Reader, Index.Count));
+            TraceIndex_Free(&Index);
+        }
+        Trace_Close(&Reader);
+    }
+
+    free(Copy);
+    return 0;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file gateway_test.c
+ * @brief Testing Gateway
+ * @details Here we apply Unit Test using Unity Test-Harness on the Gateway: Units updated by batches of Requests,
+ * Shards against one Shard, bad Requests and Requests split between socket reads
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../../source/gateway/gateway.h"
+
+/** @brief Socket of the tests */
+#define GATEWAY_TEST_SOCKET     "gateway_test.sock"
+
+/** @brief Requests in the Shards test */
+#define GATEWAY_TEST_REQUESTS   50000
+
+/** @brief Gateways used by the tests */
+static Gateway_t GATEWAY;
+static Gateway_t GATEWAY_ONE;
+
+/** @brief Define (GATEWAY) test group */
+TEST_GROUP(GATEWAY);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(GATEWAY){
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(GATEWAY){
+    Gateway_Destroy(&GATEWAY);
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Write a Request
+ * @param REQUEST uint8_t* Request
+ * @param UNIT uint32_t Unit
+ * @param POSTIVE_STATE unsigned char +ve State
+ * @param NEGATIVE_STATE unsigned char -ve State
+ * @param P_STATE unsigned char P State
+ * @param PRESS_TIME unsigned char P Press Time
+ * @return void
+ */
+static void Put_Request(uint8_t* REQUEST, uint32_t UNIT, unsigned char POSTIVE_STATE, unsigned char NEGATIVE_STATE,
+                        unsigned char P_STATE, unsigned char PRESS_TIME){
+    REQUEST[0] = (uint8_t)UNIT;
+    REQUEST[1] = (uint8_t)(UNIT >> 8);
+    REQUEST[2] = (uint8_t)(UNIT >> 16);
+    REQUEST[3] = (uint8_t)(UNIT >> 24);
+    REQUEST[4] = POSTIVE_STATE;
+    REQUEST[5] = NEGATIVE_STATE;
+    REQUEST[6] = P_STATE;
+    REQUEST[7] = PRESS_TIME;
+}
+
+
+/** @brief Motor Angle of a Reply
+ * @param REPLY const uint8_t* Reply
+ * @return unsigned int Angle
+ */
+static unsigned int Reply_Angle(const uint8_t* REPLY){
+    return (unsigned int)REPLY[6] | ((unsigned int)REPLY[7] << 8);
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> Every Unit has its own Speed **/
+TEST(GATEWAY, UnitsAreIndependent){
+    /*!
+		  * @par Given : Gateway of 100 Units on 4 Shards
+		  * @par When  : Unit 5 gets +ve pressed, Unit 6 gets -ve pressed and Unit 7 gets nothing pressed
+		  * @par Then  : Replies are 10, 140 & 90 degrees in Request order
+	*/
+    uint8_t Requests[3 * GATEWAY_REQUEST_SIZE], Replies[3 * GATEWAY_REPLY_SIZE];
+
+    /* Arrange */
+    CHECK(Gateway_Init(&GATEWAY, 100, 4));
+    Put_Request(Requests, 5, PREPRESSED, RELEASED, RELEASED, 0);
+    Put_Request(Requests + 8, 6, RELEASED, PREPRESSED, RELEASED, 0);
+    Put_Request(Requests + 16, 7, RELEASED, RELEASED, RELEASED, 0);
+
+    /* Act */
+    Gateway_Process(&GATEWAY, Requests, 3, Replies);
+
+    /* Assert */
+    LONGS_EQUAL(4, GATEWAY.ShardCount);
+    LONGS_EQUAL(5, Replies[0]);
+    LONGS_EQUAL(MAX, Replies[4]);
+    LONGS_EQUAL(GATEWAY_OK, Replies[5]);
+    LONGS_EQUAL(10, Reply_Angle(Replies));
+    LONGS_EQUAL(6, Replies[8]);
+    LONGS_EQUAL(140, Reply_Angle(Replies + 8));
+    LONGS_EQUAL(7, Replies[16]);
+    LONGS_EQUAL(90, Reply_Angle(Replies + 16));
+}
+
+
+/** <b> Test Description : </b> Shard threads give the same Replies as one Shard **/
+TEST(GATEWAY, ShardsMatchOneShard){
+    /*!
+		  * @par Given : Gateways of 3000 Units on 4 Shards and on 1 Shard
+		  * @par When  : Both get the same 50000 random Requests in batches of 5000 (Shard threads run them)
+		  * @par Then  : All Replies are the same
+	*/
+    uint8_t* Requests = malloc(GATEWAY_TEST_REQUESTS * GATEWAY_REQUEST_SIZE);
+    uint8_t* Replies = malloc(GATEWAY_TEST_REQUESTS * GATEWAY_REPLY_SIZE);
+    uint8_t* Expected = malloc(GATEWAY_TEST_REQUESTS * GATEWAY_REPLY_SIZE);
+    uint32_t Random = 12345;
+    unsigned long i;
+
+    /* Arrange */
+    CHECK(Requests != NULL && Replies != NULL && Expected != NULL);
+    CHECK(Gateway_Init(&GATEWAY, 3000, 4));
+    CHECK(Gateway_Init(&GATEWAY_ONE, 3000, 1));
+    for(i = 0; i < GATEWAY_TEST_REQUESTS; i++){
+        Random = Random * 1103515245u + 12345u;
+        Put_Request(Requests + i * GATEWAY_REQUEST_SIZE, (Random >> 8) % 3000, (Random >> 4) & 3, (Random >> 6) & 3,
+                    (Random >> 2) & 3, (unsigned char)(28 + (Random >> 28)));
+    }
+
+    /* Act */
+    for(i = 0; i < GATEWAY_TEST_REQUESTS; i += 5000){
+        Gateway_Process(&GATEWAY, Requests + i * GATEWAY_REQUEST_SIZE, 5000, Replies + i * GATEWAY_REPLY_SIZE);
+        Gateway_Process(&GATEWAY_ONE, Requests + i * GATEWAY_REQUEST_SIZE, 5000, Expected + i * GATEWAY_REPLY_SIZE);
+    }
+
+    /* Assert */
+    CHECK(memcmp(Expected, Replies, GATEWAY_TEST_REQUESTS * GATEWAY_REPLY_SIZE) == 0);
+    Gateway_Destroy(&GATEWAY_ONE);
+    free(Requests);
+    free(Replies);
+    free(Expected);
+}
+
+
+/** <b> Test Description : </b> Unknown Units & Switch States are refused **/
+TEST(GATEWAY, BadRequestsAreRefused){
+    /*!
+		  * @par Given : Gateway of 100 Units
+		  * @par When  : Unit 100 is sent, then Unit 1 with +ve State 9
+		  * @par Then  : Replies are BAD_UNIT then BAD_INPUT with Unit 1 still at MED
+	*/
+    uint8_t Requests[2 * GATEWAY_REQUEST_SIZE], Replies[2 * GATEWAY_REPLY_SIZE];
+
+    /* Arrange */
+    CHECK(Gateway_Init(&GATEWAY, 100, 2));
+    Put_Request(Requests, 100, PREPRESSED, RELEASED, RELEASED, 0);
+    Put_Request(Requests + 8, 1, 9, RELEASED, RELEASED, 0);
+
+    /* Act */
+    Gateway_Process(&GATEWAY, Requests, 2, Replies);
+
+    /* Assert */
+    LONGS_EQUAL(100, Replies[0]);
+    LONGS_EQUAL(GATEWAY_BAD_UNIT, Replies[5]);
+    LONGS_EQUAL(1, Replies[8]);
+    LONGS_EQUAL(GATEWAY_BAD_INPUT, Replies[13]);
+    LONGS_EQUAL(MED, Replies[12]);
+    LONGS_EQUAL(90, Reply_Angle(Replies + 8));
+}
+
+
+#ifdef __linux__
+/** <b> Test Description : </b> A Request split between two writes is run once it is complete **/
+TEST(GATEWAY, SocketSplitRequest){
+    /*!
+		  * @par Given : Gateway listening and a connected client
+		  * @par When  : Client writes one Request and half of a 2nd, then the rest of the 2nd
+		  * @par Then  : First Reply comes after the first write and the 2nd after the rest
+	*/
+    uint8_t Requests[2 * GATEWAY_REQUEST_SIZE], Replies[2 * GATEWAY_REPLY_SIZE];
+    struct sockaddr_un Address;
+    int Fd;
+
+    /* Arrange */
+    CHECK(Gateway_Init(&GATEWAY, 10, 2));
+    CHECK(Gateway_Listen(&GATEWAY, GATEWAY_TEST_SOCKET));
+    memset(&Address, 0, sizeof(Address));
+    Address.sun_family = AF_UNIX;
+    strcpy(Address.sun_path, GATEWAY_TEST_SOCKET);
+    Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    CHECK(connect(Fd, (struct sockaddr*)&Address, sizeof(Address)) == 0);
+    Gateway_Poll(&GATEWAY, 1000);
+    Put_Request(Requests, 3, RELEASED, PREPRESSED, RELEASED, 0);
+    Put_Request(Requests + 8, 3, RELEASED, PREPRESSED, RELEASED, 0);
+
+    /* Act & Assert */
+    CHECK(write(Fd, Requests, 12) == 12);
+    Gateway_Poll(&GATEWAY, 1000);
+    CHECK(recv(Fd, Replies, sizeof(Replies), MSG_DONTWAIT) == GATEWAY_REPLY_SIZE);
+    LONGS_EQUAL(140, Reply_Angle(Replies));
+
+    CHECK(write(Fd, Requests + 12, 4) == 4);
+    Gateway_Poll(&GATEWAY, 1000);
+    CHECK(recv(Fd, Replies, sizeof(Replies), MSG_DONTWAIT) == GATEWAY_REPLY_SIZE);
+    LONGS_EQUAL(3, Replies[0]);
+    LONGS_EQUAL(MIN, Replies[4]);
+    LONGS_EQUAL(140, Reply_Angle(Replies));
+    LONGS_EQUAL(1, GATEWAY.Stats.Clients);
+    close(Fd);
+}
+#endif
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(GATEWAY){
+    RUN_TEST_CASE(GATEWAY, UnitsAreIndependent);
+    RUN_TEST_CASE(GATEWAY, ShardsMatchOneShard);
+    RUN_TEST_CASE(GATEWAY, BadRequestsAreRefused);
+#ifdef __linux__
+    RUN_TEST_CASE(GATEWAY, SocketSplitRequest);
+#endif
+}
@@ -0,0 +1,275 @@
+/**
+ * @file journal_test.c
+ * @brief Testing State Journal
+ * @details Here we apply Unit Test using Unity Test-Harness on the Controller State Journal: restore of the full
+ * State, torn & bad Records and compaction
+ *
+ */
+
+#include <stdio.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../fake_switch/fake_switch.h"
+#include "../../source/journal/journal.h"
+#include "../../source/scheduler/scheduler.h"
+#include "../../source/speedcontrol/speedcontrol.h"
+#include "../../source/switches/switch.h"
+
+/** @brief Journal File of the tests */
+#define JOURNAL_TEST_FILE   "journal_test.jnl"
+
+/** @brief Journal used by the tests */
+static Journal_t JOURNAL;
+
+/** @brief Define (JOURNAL) test group */
+TEST_GROUP(JOURNAL);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(JOURNAL){
+    remove(JOURNAL_TEST_FILE);
+    SW_Init(POSTIVE);
+    SW_Init(NEGATIVE);
+    SW_Init(P);
+    Speed_Init();
+    FakeSW_Destroy();
+    Sched_Init(NULL, 0);
+    UT_PTR_SET(Get_SWLevel, Get_FakeSW_Level);
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(JOURNAL){
+    Journal_Close(&JOURNAL);
+    remove(JOURNAL_TEST_FILE);
+    FakeSW_Destroy();
+    Speed_Init();
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Run Control Loop ticks as main() does, journaling the State at the end of every tick
+ * @param TICKS unsigned int Number of ticks
+ * @return void
+ */
+static void Run_Ticks(unsigned int TICKS){
+    unsigned int i;
+
+    for(i = 0; i < TICKS; i++){
+        Update_Switch(P);
+        Update_Switch(POSTIVE);
+        Update_Switch(NEGATIVE);
+        Speed_Update();
+        MotAngle_Write();
+        Journal_Update(&JOURNAL);
+        Sched_RunTick();
+    }
+}
+
+
+/** @brief Size of Journal File
+ * @param void
+ * @return long Size in bytes
+ */
+static long Journal_Size(void){
+    FILE* File = fopen(JOURNAL_TEST_FILE, "rb");
+    long Size;
+
+    if(File == NULL){
+        return -1;
+    }
+    fseek(File, 0, SEEK_END);
+    Size = ftell(File);
+    fclose(File);
+    return Size;
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> A new Journal has nothing to restore **/
+TEST(JOURNAL, NewJournalIsEmpty){
+    /*!
+		  * @par Given : No Journal File
+		  * @par When  : Journal is opened
+		  * @par Then  : There's no State to restore
+	*/
+    ControllerState_t State;
+
+    /* Act */
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, JOURNAL_COMPACT_RECORDS));
+
+    /* Assert */
+    CHECK(!Journal_Restore(&JOURNAL, &State));
+    LONGS_EQUAL(0, Journal_Size());
+}
+
+
+/** <b> Test Description : </b> A restarted Controller carries on with the same Speed, Switches, Press Time & tick **/
+TEST(JOURNAL, RestartResumesFullState){
+    /*!
+		  * @par Given : +ve pressed once then P held for 2.5 seconds (Speed MAX, P PRESSED, Press Time 2)
+		  * @par When  : Controller is initialized again and the newest Record is applied
+		  * @par Then  : Speed, Switches States, Press Time accumulators and tick count are the same as before
+	*/
+    ControllerState_t Before, State;
+
+    /* Arrange */
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, JOURNAL_COMPACT_RECORDS));
+    Set_FakeSW_Level(POSTIVE, true);
+    Run_Ticks(3);
+    Set_FakeSW_Level(POSTIVE, false);
+    Set_FakeSW_Level(P, true);
+    Run_Ticks(2 + 2 * SW_TICKS_PER_SECOND + SW_TICKS_PER_SECOND / 2);
+    Journal_Capture(&Before);
+    Journal_Close(&JOURNAL);
+
+    /* Act */
+    SW_Init(POSTIVE);
+    SW_Init(NEGATIVE);
+    SW_Init(P);
+    Speed_Init();
+    Sched_Init(NULL, 0);
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, JOURNAL_COMPACT_RECORDS));
+    CHECK(Journal_Restore(&JOURNAL, &State));
+    CHECK(Journal_Apply(&State));
+
+    /* Assert */
+    LONGS_EQUAL(MAX, Speed_Get());
+    LONGS_EQUAL(PRESSED, Get_RealSW_State(P));
+    LONGS_EQUAL(RELEASED, Get_RealSW_State(POSTIVE));
+    LONGS_EQUAL(2, Get_RealSW_PressTime());
+    LONGS_EQUAL(Before.Switches.PressTicks, State.Switches.PressTicks);
+    LONGS_EQUAL(Before.Ticks, Sched_Ticks());
+}
+
+
+/** <b> Test Description : </b> A torn last Record is dropped and the one before it is restored **/
+TEST(JOURNAL, TornTailIsDropped){
+    /*!
+		  * @par Given : Journal of 3 Records and half of a 4th one
+		  * @par When  : Journal is opened again
+		  * @par Then  : 3rd Record is restored and the Journal is compacted to it
+	*/
+    ControllerState_t State;
+    FILE* File;
+    unsigned int i;
+
+    /* Arrange */
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, JOURNAL_COMPACT_RECORDS));
+    Run_Ticks(3);
+    Journal_Close(&JOURNAL);
+    File = fopen(JOURNAL_TEST_FILE, "ab");
+    for(i = 0; i < JOURNAL_RECORD_SIZE / 2; i++){
+        fputc(JOURNAL_MAGIC, File);
+    }
+    fclose(File);
+
+    /* Act */
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, JOURNAL_COMPACT_RECORDS));
+
+    /* Assert */
+    CHECK(Journal_Restore(&JOURNAL, &State));
+    LONGS_EQUAL(3, State.Ticks);
+    LONGS_EQUAL(3, JOURNAL.Seq);
+    LONGS_EQUAL(JOURNAL_RECORD_SIZE, Journal_Size());
+}
+
+
+/** <b> Test Description : </b> A bad last Record (CRC) is skipped and new Records follow the good one **/
+TEST(JOURNAL, BadRecordIsSkipped){
+    /*!
+		  * @par Given : Journal of 2 Records, one byte of the 2nd is changed
+		  * @par When  : Journal is opened again and a Record is appended
+		  * @par Then  : 1st Record is restored, then the appended Record is the newest with the next Seq
+	*/
+    ControllerState_t State;
+    FILE* File;
+
+    /* Arrange */
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, JOURNAL_COMPACT_RECORDS));
+    Run_Ticks(2);
+    Journal_Close(&JOURNAL);
+    File = fopen(JOURNAL_TEST_FILE, "r+b");
+    fseek(File, JOURNAL_RECORD_SIZE + 17, SEEK_SET);
+    fputc(0x7F, File);
+    fclose(File);
+
+    /* Act & Assert */
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, JOURNAL_COMPACT_RECORDS));
+    CHECK(Journal_Restore(&JOURNAL, &State));
+    LONGS_EQUAL(1, State.Ticks);
+
+    State.Ticks = 7;
+    CHECK(Journal_Append(&JOURNAL, &State));
+    Journal_Close(&JOURNAL);
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, JOURNAL_COMPACT_RECORDS));
+    CHECK(Journal_Restore(&JOURNAL, &State));
+    LONGS_EQUAL(7, State.Ticks);
+    LONGS_EQUAL(2, JOURNAL.Seq);
+    LONGS_EQUAL(2 * JOURNAL_RECORD_SIZE, Journal_Size());
+}
+
+
+/** <b> Test Description : </b> Journal is compacted and never grows over COMPACT_RECORDS **/
+TEST(JOURNAL, JournalIsCompacted){
+    /*!
+		  * @par Given : Journal compacted every 4 Records
+		  * @par When  : 10 ticks are journaled
+		  * @par Then  : Journal is compacted 3 times, has 1 Record and the newest State is restored
+	*/
+    ControllerState_t State;
+
+    /* Arrange */
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, 4));
+
+    /* Act */
+    Run_Ticks(10);
+
+    /* Assert */
+    LONGS_EQUAL(3, JOURNAL.Compactions);
+    LONGS_EQUAL(JOURNAL_RECORD_SIZE, Journal_Size());
+    Journal_Close(&JOURNAL);
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, 4));
+    CHECK(Journal_Restore(&JOURNAL, &State));
+    LONGS_EQUAL(10, State.Ticks);
+    LONGS_EQUAL(10, JOURNAL.Seq);
+}
+
+
+/** <b> Test Description : </b> An invalid State is never applied **/
+TEST(JOURNAL, InvalidStateIsNotApplied){
+    /*!
+		  * @par Given : Controller at MED Speed and a State with P in an unknown Switch State
+		  * @par When  : State is applied or appended
+		  * @par Then  : Both are refused and Controller is not changed
+	*/
+    ControllerState_t State;
+
+    /* Arrange */
+    CHECK(Journal_Open(&JOURNAL, JOURNAL_TEST_FILE, JOURNAL_COMPACT_RECORDS));
+    Journal_Capture(&State);
+    State.Speed = MIN;
+    State.Switches.States[P] = (SwitchState_t)9;
+
+    /* Act & Assert */
+    CHECK(!Journal_Apply(&State));
+    CHECK(!Journal_Append(&JOURNAL, &State));
+    LONGS_EQUAL(MED, Speed_Get());
+    LONGS_EQUAL(RELEASED, Get_RealSW_State(P));
+    LONGS_EQUAL(0, Journal_Size());
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(JOURNAL){
+    RUN_TEST_CASE(JOURNAL, NewJournalIsEmpty);
+    RUN_TEST_CASE(JOURNAL, RestartResumesFullState);
+    RUN_TEST_CASE(JOURNAL, TornTailIsDropped);
+    RUN_TEST_CASE(JOURNAL, BadRecordIsSkipped);
+    RUN_TEST_CASE(JOURNAL, JournalIsCompacted);
+    RUN_TEST_CASE(JOURNAL, InvalidStateIsNotApplied);
+}
@@ -0,0 +1,166 @@
+/**
+ * @file latency_test.c
+ * @brief Testing Latency Histograms
+ * @details Here we apply Unit Test using Unity Test-Harness on Latency Histograms and on the button edge time
+ * carried from Update_Switch() through Speed_Update() to MotAngle_Write()
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../fake_switch/fake_switch.h"
+#include "../../source/latency/latency.h"
+#include "../../source/speedcontrol/speedcontrol.h"
+#include "../../source/switches/switch.h"
+
+/** @brief Histogram read by the tests */
+static LatencyHistogram_t HISTOGRAM;
+
+/** @brief Define (LATENCY) test group */
+TEST_GROUP(LATENCY);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(LATENCY){
+    SW_Init(POSTIVE);
+    SW_Init(NEGATIVE);
+    SW_Init(P);
+    Speed_Init();
+    FakeSW_Destroy();
+    Latency_Reset();
+    UT_PTR_SET(Get_SWLevel, Get_FakeSW_Level);
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(LATENCY){
+    FakeSW_Destroy();
+    Latency_Reset();
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Run Control Loop ticks as main() does
+ * @param TICKS unsigned int Number of ticks
+ * @return void
+ */
+static void Run_Ticks(unsigned int TICKS){
+    unsigned int i;
+
+    for(i = 0; i < TICKS; i++){
+        Update_Switch(P);
+        Update_Switch(POSTIVE);
+        Update_Switch(NEGATIVE);
+        Speed_Update();
+        MotAngle_Write();
+    }
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> Percentiles are read from log2 buckets **/
+TEST(LATENCY, PercentilesAreBucketEnds){
+    /*!
+		  * @par Given : 90 latencies of 100 units and 10 of 5000 units on +ve Switch
+		  * @par When  : Histogram & its percentiles are read
+		  * @par Then  : p50 is the end of 100 bucket (127) and p99 is the Max (5000)
+	*/
+    unsigned int i;
+
+    /* Arrange */
+    for(i = 0; i < 100; i++){
+        Latency_Add(POSTIVE, (i < 90) ? 100 : 5000);
+    }
+
+    /* Act */
+    CHECK(Latency_Get(POSTIVE, &HISTOGRAM));
+
+    /* Assert */
+    LONGS_EQUAL(100, HISTOGRAM.Count);
+    LONGS_EQUAL(100, HISTOGRAM.Min);
+    LONGS_EQUAL(5000, HISTOGRAM.Max);
+    LONGS_EQUAL(90, HISTOGRAM.Buckets[7]);
+    LONGS_EQUAL(10, HISTOGRAM.Buckets[13]);
+    CHECK(Latency_PercentileNs(&HISTOGRAM, 50) == Latency_Ns(127));
+    CHECK(Latency_PercentileNs(&HISTOGRAM, 99) == Latency_Ns(5000));
+    CHECK(!Latency_Get((Switch_t)3, &HISTOGRAM));
+}
+
+
+/** <b> Test Description : </b> +ve edge is measured once, when its Speed change is written **/
+TEST(LATENCY, EdgeIsMeasuredOnce){
+    /*!
+		  * @par Given : Released Switches and Motor at MED Speed
+		  * @par When  : +ve is pushed for 3 ticks
+		  * @par Then  : +ve Histogram has one latency, other Switches have none
+	*/
+
+    /* Arrange */
+    Run_Ticks(1);
+
+    /* Act */
+    Set_FakeSW_Level(POSTIVE, true);
+    Run_Ticks(3);
+
+    /* Assert */
+    CHECK(Latency_Get(POSTIVE, &HISTOGRAM));
+    LONGS_EQUAL(1, HISTOGRAM.Count);
+    CHECK(Latency_LastNs() == Latency_Ns(HISTOGRAM.Last));
+    CHECK(Latency_Get(NEGATIVE, &HISTOGRAM));
+    LONGS_EQUAL(0, HISTOGRAM.Count);
+}
+
+
+/** <b> Test Description : </b> Edge which can't change Speed isn't measured **/
+TEST(LATENCY, ClampedStepIsNotMeasured){
+    /*!
+		  * @par Given : Motor at MAX Speed
+		  * @par When  : +ve is pushed
+		  * @par Then  : +ve Histogram is empty
+	*/
+
+    /* Arrange */
+    Speed_Increase();
+
+    /* Act */
+    Set_FakeSW_Level(POSTIVE, true);
+    Run_Ticks(2);
+
+    /* Assert */
+    CHECK(Latency_Get(POSTIVE, &HISTOGRAM));
+    LONGS_EQUAL(0, HISTOGRAM.Count);
+}
+
+
+/** <b> Test Description : </b> P long press is measured from the press, once **/
+TEST(LATENCY, LongPressIsMeasuredOnce){
+    /*!
+		  * @par Given : Motor at MED Speed
+		  * @par When  : P is held till Press Time is 30 and some more ticks
+		  * @par Then  : Speed goes to MIN but P Histogram has one latency
+	*/
+
+    /* Act */
+    Set_FakeSW_Level(P, true);
+    Run_Ticks(1 + 30 * SW_TICKS_PER_SECOND + 5);
+
+    /* Assert */
+    LONGS_EQUAL(140, MotAngle_Write());
+    CHECK(Latency_Get(P, &HISTOGRAM));
+    LONGS_EQUAL(1, HISTOGRAM.Count);
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(LATENCY){
+    RUN_TEST_CASE(LATENCY, PercentilesAreBucketEnds);
+    RUN_TEST_CASE(LATENCY, EdgeIsMeasuredOnce);
+    RUN_TEST_CASE(LATENCY, ClampedStepIsNotMeasured);
+    RUN_TEST_CASE(LATENCY, LongPressIsMeasuredOnce);
+}
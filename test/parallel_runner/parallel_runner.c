@@ -0,0 +1,336 @@
+/**
+ * @file parallel_runner.c
+ * @brief Parallel Test Runner main file
+ * @details Here we fork a Worker process per Test Group. Worker output goes to a File in its Directory
+ * and its Unity counters to a Result File, Parent waits for Workers, prints their output in Test Group
+ * order and adds their counters to its own Unity state, so the summary looks like a serial run
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+ /*    Include Header    */
+#include"parallel_runner.h"
+
+ /*    Include Unity    */
+#include"../unity/unity_fixture.h"
+#include"../unity/unity_fixture_internals.h"
+
+/** @brief Files a Worker reads from the working Directory */
+static const char* const INPUT_FILES[] = {"switch.txt"};
+
+/** @brief A File one Test Group writes, only its Worker gets it & copies it back */
+typedef struct {
+    const char* File;
+    const char* Group;
+} RunnerOutput_t;
+
+/** @brief Files written by Test Groups, motor.txt keeps Results of UPDATE Test Cases not run */
+static const RunnerOutput_t OUTPUT_FILES[] = {{"motor.txt", "UPDATE"}};
+
+/** @brief Worker Output & Result Files in Worker Directory */
+#define RUNNER_OUTPUT_FILE      "output.txt"
+#define RUNNER_RESULT_FILE      "result.bin"
+
+/** @brief Unity counters of one Worker */
+typedef struct {
+    UNITY_COUNTER_TYPE Tests;
+    UNITY_COUNTER_TYPE Failures;
+    UNITY_COUNTER_TYPE Ignores;
+} RunnerResult_t;
+
+
+/** @brief Check if a Test Group is selected by -g option
+ * @param NAME const char* Test Group name
+ * @return int 1 if selected & 0 if not
+ */
+static int Runner_Selected(const char* NAME){
+    return UnityFixture.GroupFilter == 0 || strstr(NAME, UnityFixture.GroupFilter) != NULL;
+}
+
+
+#ifndef _WIN32
+
+/** @brief One Worker process */
+typedef struct {
+    pid_t Pid;
+    int Status;
+    char Dir[32];
+} RunnerWorker_t;
+
+
+/** @brief Copy a File
+ * @param FROM const char* Source path
+ * @param TO const char* Destination path
+ * @return int 1 if copied & 0 if not (Source missing)
+ */
+static int Runner_Copy(const char* FROM, const char* TO){
+    char Buffer[4096];
+    size_t Len;
+    FILE* In = fopen(FROM, "rb");
+    FILE* Out;
+
+    if(!In){
+        return 0;
+    }
+    Out = fopen(TO, "wb");
+    if(!Out){
+        fclose(In);
+        return 0;
+    }
+    while((Len = fread(Buffer, 1, sizeof(Buffer), In)) != 0){
+        fwrite(Buffer, 1, Len, Out);
+    }
+    fclose(In);
+    return fclose(Out) == 0;
+}
+
+
+/** @brief Remove Worker Directory with its Files
+ * @param DIR_PATH const char* Worker Directory
+ * @return void
+ */
+static void Runner_RemoveDir(const char* DIR_PATH){
+    char Path[300];
+    struct dirent* Entry;
+    DIR* Dir = opendir(DIR_PATH);
+
+    if(Dir){
+        while((Entry = readdir(Dir)) != NULL){
+            if(strcmp(Entry->d_name, ".") != 0 && strcmp(Entry->d_name, "..") != 0){
+                snprintf(Path, sizeof(Path), "%s/%s", DIR_PATH, Entry->d_name);
+                remove(Path);
+            }
+        }
+        closedir(Dir);
+    }
+    rmdir(DIR_PATH);
+}
+
+
+/** @brief Worker process body, it never returns
+ * @param PROGRAM const char* Program name printed by Unity
+ * @param GROUP const RunnerGroup_t* Test Group to run
+ * @param DIR_PATH const char* Worker Directory
+ * @return void
+ */
+static void Runner_Worker(const char* PROGRAM, const RunnerGroup_t* GROUP, const char* DIR_PATH){
+    RunnerResult_t Result;
+    FILE* File;
+    int Output;
+
+    if(chdir(DIR_PATH) != 0){
+        _exit(1);
+    }
+    Output = open(RUNNER_OUTPUT_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(Output < 0 || dup2(Output, STDOUT_FILENO) < 0){
+        _exit(1);
+    }
+    close(Output);
+
+    /* Lines before a crash must reach the Output File */
+    setvbuf(stdout, NULL, _IOLBF, BUFSIZ);
+
+    UnityBegin(PROGRAM);
+    GROUP->Run();
+    fflush(stdout);
+
+    Result.Tests = Unity.NumberOfTests;
+    Result.Failures = Unity.TestFailures;
+    Result.Ignores = Unity.TestIgnores;
+    File = fopen(RUNNER_RESULT_FILE, "wb");
+    if(!File || fwrite(&Result, sizeof(Result), 1, File) != 1 || fclose(File) != 0){
+        _exit(1);
+    }
+    _exit(0);
+}
+
+
+/** @brief Start a Worker for a Test Group
+ * @param PROGRAM const char* Program name printed by Unity
+ * @param GROUP const RunnerGroup_t* Test Group to run
+ * @param WORKER RunnerWorker_t* Started Worker
+ * @return int 1 if started & 0 if not
+ */
+static int Runner_Start(const char* PROGRAM, const RunnerGroup_t* GROUP, RunnerWorker_t* WORKER){
+    char Path[300];
+    unsigned int i;
+
+    strcpy(WORKER->Dir, "runner_XXXXXX");
+    if(!mkdtemp(WORKER->Dir)){
+        return 0;
+    }
+    for(i = 0; i < sizeof(INPUT_FILES) / sizeof(INPUT_FILES[0]); i++){
+        snprintf(Path, sizeof(Path), "%s/%s", WORKER->Dir, INPUT_FILES[i]);
+        Runner_Copy(INPUT_FILES[i], Path);
+    }
+    for(i = 0; i < sizeof(OUTPUT_FILES) / sizeof(OUTPUT_FILES[0]); i++){
+        if(strcmp(OUTPUT_FILES[i].Group, GROUP->Name) == 0){
+            snprintf(Path, sizeof(Path), "%s/%s", WORKER->Dir, OUTPUT_FILES[i].File);
+            Runner_Copy(OUTPUT_FILES[i].File, Path);
+        }
+    }
+
+    /* Unity output still buffered would be printed by parent & child */
+    fflush(stdout);
+    WORKER->Pid = fork();
+    if(WORKER->Pid == 0){
+        Runner_Worker(PROGRAM, GROUP, WORKER->Dir);
+    }
+    if(WORKER->Pid < 0){
+        Runner_RemoveDir(WORKER->Dir);
+        return 0;
+    }
+    return 1;
+}
+
+
+/** @brief Print Worker output, add its Results to Unity & copy its Output Files back
+ * @param GROUP const RunnerGroup_t* Test Group of the Worker
+ * @param WORKER const RunnerWorker_t* Finished Worker
+ * @return void
+ */
+static void Runner_Collect(const RunnerGroup_t* GROUP, const RunnerWorker_t* WORKER){
+    char Path[300];
+    char Buffer[4096];
+    RunnerResult_t Result;
+    size_t Len;
+    unsigned int i;
+    FILE* File;
+    int Ok = 0;
+
+    snprintf(Path, sizeof(Path), "%s/%s", WORKER->Dir, RUNNER_OUTPUT_FILE);
+    File = fopen(Path, "rb");
+    if(File){
+        while((Len = fread(Buffer, 1, sizeof(Buffer), File)) != 0){
+            fwrite(Buffer, 1, Len, stdout);
+        }
+        fclose(File);
+    }
+
+    snprintf(Path, sizeof(Path), "%s/%s", WORKER->Dir, RUNNER_RESULT_FILE);
+    File = fopen(Path, "rb");
+    if(File){
+        Ok = fread(&Result, sizeof(Result), 1, File) == 1;
+        fclose(File);
+    }
+
+    if(Ok && WIFEXITED(WORKER->Status) && WEXITSTATUS(WORKER->Status) == 0){
+        Unity.NumberOfTests += Result.Tests;
+        Unity.TestFailures += Result.Failures;
+        Unity.TestIgnores += Result.Ignores;
+    }else{
+        /* Worker crashed in a test, its Results are lost but the failure isn't */
+        printf("\nTEST GROUP(%s) Worker ", GROUP->Name);
+        if(WIFSIGNALED(WORKER->Status)){
+            printf("killed by signal %d", WTERMSIG(WORKER->Status));
+        }else{
+            printf("exited with %d", WIFEXITED(WORKER->Status) ? WEXITSTATUS(WORKER->Status) : -1);
+        }
+        printf("::FAIL\n");
+        Unity.NumberOfTests++;
+        Unity.TestFailures++;
+    }
+
+    /* Other Workers never had the File, an old copy must not overwrite the Results */
+    for(i = 0; i < sizeof(OUTPUT_FILES) / sizeof(OUTPUT_FILES[0]); i++){
+        if(strcmp(OUTPUT_FILES[i].Group, GROUP->Name) == 0){
+            snprintf(Path, sizeof(Path), "%s/%s", WORKER->Dir, OUTPUT_FILES[i].File);
+            Runner_Copy(Path, OUTPUT_FILES[i].File);
+        }
+    }
+    Runner_RemoveDir(WORKER->Dir);
+}
+
+
+int Runner_Parallel(const char* PROGRAM, const RunnerGroup_t* GROUPS, unsigned int COUNT, unsigned int JOBS){
+    static RunnerWorker_t Workers[RUNNER_MAX_GROUPS];
+    unsigned int Next = 0, Done = 0, Running = 0, i;
+    int Status;
+    long Cpus;
+    pid_t Pid;
+
+    if(JOBS == 0){
+        Cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        JOBS = (Cpus > 0) ? (unsigned int)Cpus : 1;
+    }
+    if(JOBS > RUNNER_MAX_JOBS){
+        JOBS = RUNNER_MAX_JOBS;
+    }
+
+    UnityBegin(PROGRAM);
+    if(COUNT > RUNNER_MAX_GROUPS){
+        printf("Too many Test Groups (%u), at most %d::FAIL\n", COUNT, RUNNER_MAX_GROUPS);
+        Unity.TestFailures++;
+        return (int)UnityEnd();
+    }
+
+    while(Done < COUNT){
+        /* Start Workers till JOBS are running */
+        while(Next < COUNT && Running < JOBS){
+            Workers[Next].Pid = 0;
+            if(Runner_Selected(GROUPS[Next].Name)){
+                if(Runner_Start(PROGRAM, &GROUPS[Next], &Workers[Next])){
+                    Running++;
+                }else{
+                    /* No process left, run it here */
+                    GROUPS[Next].Run();
+                }
+            }
+            Next++;
+        }
+
+        /* Wait any Worker, then print every finished Worker in Test Group order */
+        if(Running != 0){
+            Pid = wait(&Status);
+            for(i = 0; i < Next; i++){
+                if(Workers[i].Pid == Pid && Pid > 0){
+                    Workers[i].Status = Status;
+                    Workers[i].Pid = -1;
+                    Running--;
+                }
+            }
+        }
+        while(Done < Next && Workers[Done].Pid <= 0){
+            if(Workers[Done].Pid < 0){
+                Runner_Collect(&GROUPS[Done], &Workers[Done]);
+            }
+            Done++;
+        }
+    }
+
+    if(!UnityFixture.Verbose){
+        UNITY_PRINT_EOL();
+    }
+    return (int)UnityEnd();
+}
+
+#else
+
+int Runner_Parallel(const char* PROGRAM, const RunnerGroup_t* GROUPS, unsigned int COUNT, unsigned int JOBS){
+    unsigned int i;
+    (void)JOBS;
+
+    UnityBegin(PROGRAM);
+    for(i = 0; i < COUNT; i++){
+        if(Runner_Selected(GROUPS[i].Name)){
+            GROUPS[i].Run();
+        }
+    }
+    if(!UnityFixture.Verbose){
+        UNITY_PRINT_EOL();
+    }
+    return (int)UnityEnd();
+}
+
+#endif
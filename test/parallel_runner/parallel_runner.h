@@ -0,0 +1,42 @@
+/**
+ * @file parallel_runner.h
+ * @brief Parallel Test Runner header file
+ */
+
+#ifndef PARALLEL_RUNNER_H_INCLUDED
+#define PARALLEL_RUNNER_H_INCLUDED
+
+/** @brief Most Worker processes running at the same time */
+#define RUNNER_MAX_JOBS         64
+
+/** @brief Most Test Groups one Runner can run */
+#define RUNNER_MAX_GROUPS       64
+
+/** @brief Declare Runner function of a Test Group made by TEST_GROUP_RUNNER() */
+#define RUNNER_DECLARE_GROUP(group)     void TEST_##group##_GROUP_RUNNER(void)
+
+/** @brief Entry of a Test Group in a RunnerGroup_t table */
+#define RUNNER_GROUP(group)             {#group, TEST_##group##_GROUP_RUNNER}
+
+/** @brief One Test Group */
+typedef struct {
+    const char* Name;
+    void (*Run)(void);
+} RunnerGroup_t;
+
+
+/** @brief Run Test Groups in Worker processes, one process per Test Group and at most JOBS at the same time. <br>
+ * Every Worker runs in its own Directory with a copy of switch.txt, so Speed & Fake Switches globals and
+ * Test Files aren't shared. Output of every Worker is printed in Test Group order, then Unity Results of
+ * all Workers are added and printed as one Unity summary. motor.txt is given to the UPDATE Worker only
+ * and copied back from it. <br>
+ * A Worker which crashes is counted as one failed test. Without fork (Windows) Test Groups run one by one
+ * @param PROGRAM const char* Program name printed by Unity
+ * @param GROUPS const RunnerGroup_t* Test Groups
+ * @param COUNT unsigned int Number of Test Groups
+ * @param JOBS unsigned int Most Workers at the same time, 0 to use all CPUs
+ * @return int Number of failed tests
+ */
+int Runner_Parallel(const char* PROGRAM, const RunnerGroup_t* GROUPS, unsigned int COUNT, unsigned int JOBS);
+
+#endif // PARALLEL_RUNNER_H_INCLUDED
@@ -0,0 +1,141 @@
+/**
+ * @file parallel_runner_test.c
+ * @brief Testing Parallel Test Runner
+ * @details Here we apply Unit Test using Unity Test-Harness on the Parallel Runner: a Runner with fake Test Groups
+ * is run in a child process & Directory, then the Files it leaves in the working Directory are checked
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+#include "../unity/unity_fixture_internals.h"
+
+/*    Include Modules under test    */
+#include "../parallel_runner/parallel_runner.h"
+
+/** @brief Result File as it is before the Runner starts */
+static const char OLD_RESULTS[] = "MotorAngle\n9\n";
+
+/** @brief Define (RUNNER) test group */
+TEST_GROUP(RUNNER);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(RUNNER){
+
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(RUNNER){
+
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Fake UPDATE Test Group, it adds one Result to motor.txt of its Worker */
+static void Fake_Update(void){
+    FILE* File = fopen("motor.txt", "a");
+
+    if(File){
+        fputs("1\n", File);
+        fclose(File);
+    }
+}
+
+/** @brief Fake Test Group which writes no File */
+static void Fake_Other(void){
+
+}
+
+/** @brief Fake Test Groups, the ones after UPDATE are collected after it */
+static const RunnerGroup_t FAKE_GROUPS[] = {
+    {"UPDATE", Fake_Update},
+    {"OTHER", Fake_Other},
+    {"LAST", Fake_Other},
+};
+
+
+/** @brief Read a small File
+ * @param PATH const char* File path
+ * @param TEXT char* Where to read, it ends with '\0'
+ * @param SIZE size_t Size of TEXT
+ * @return void
+ */
+static void Read_File(const char* PATH, char* TEXT, size_t SIZE){
+    FILE* File = fopen(PATH, "rb");
+    size_t Len = 0;
+
+    if(File){
+        Len = fread(TEXT, 1, SIZE - 1, File);
+        fclose(File);
+    }
+    TEXT[Len] = '\0';
+}
+
+
+/*------------------Test Cases------------------*/
+
+#ifdef __linux__
+/** <b> Test Description : </b> With -j only the UPDATE Worker gets motor.txt and copies it back **/
+TEST(RUNNER, ParallelRunKeepsUpdateResults){
+    /*!
+		  * @par Given : motor.txt with one old Result & fake UPDATE, OTHER and LAST Test Groups
+		  * @par When  : They are run by Runner_Parallel() on 4 Workers
+		  * @par Then  : motor.txt has the old Result & the one added by UPDATE, OTHER & LAST don't overwrite it
+	*/
+    char Dir[] = "runner_test_XXXXXX";
+    char Path[64];
+    char Text[64];
+    FILE* File;
+    pid_t Pid;
+    int Status = -1;
+
+    /* Arrange */
+    CHECK(mkdtemp(Dir) != NULL);
+    snprintf(Path, sizeof(Path), "%s/motor.txt", Dir);
+    File = fopen(Path, "wb");
+    CHECK(File != NULL);
+    fputs(OLD_RESULTS, File);
+    fclose(File);
+
+    /* Act */
+    fflush(stdout);
+    Pid = fork();
+    if(Pid == 0){
+        /* Child Runner has its own Unity state, its output isn't part of this test */
+        if(chdir(Dir) != 0 || !freopen("/dev/null", "w", stdout)){
+            _exit(1);
+        }
+        UnityFixture.GroupFilter = 0;
+        UnityFixture.NameFilter = 0;
+        Runner_Parallel("runner_test", FAKE_GROUPS, sizeof(FAKE_GROUPS) / sizeof(FAKE_GROUPS[0]), 4);
+        _exit(0);
+    }
+    CHECK(Pid > 0);
+    waitpid(Pid, &Status, 0);
+    Read_File(Path, Text, sizeof(Text));
+    remove(Path);
+    rmdir(Dir);
+
+    /* Assert */
+    CHECK(WIFEXITED(Status) && WEXITSTATUS(Status) == 0);
+    STRCMP_EQUAL("MotorAngle\n9\n1\n", Text);
+}
+#endif
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(RUNNER){
+#ifdef __linux__
+    RUN_TEST_CASE(RUNNER, ParallelRunKeepsUpdateResults);
+#endif
+}
@@ -0,0 +1,256 @@
+/**
+ * @file persist_test.c
+ * @brief Testing Persistent Speed
+ * @details Here we apply Unit Test using Unity Test-Harness on the non-volatile Speed Store: coalesced writes,
+ * Slot rotation and torn Records
+ *
+ */
+
+#include <stdio.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../../source/persist/persist.h"
+#include "../../source/speedcontrol/speedcontrol.h"
+#include "../../source/switches/switch.h"
+
+/** @brief Store File of the tests */
+#define PERSIST_TEST_FILE   "persist_test.nv"
+
+/** @brief Store used by the tests */
+static PersistStore_t STORE;
+
+/** @brief Define (PERSIST) test group */
+TEST_GROUP(PERSIST);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(PERSIST){
+    remove(PERSIST_TEST_FILE);
+    Speed_Init();
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(PERSIST){
+    Persist_Close(&STORE);
+    remove(PERSIST_TEST_FILE);
+    Speed_Init();
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Give the same Speed to the Store for some ticks, a tick ends once its write is synced
+ * so the tests see every write as if ticks were 20 ms apart
+ * @param SPEED MotorSpeed_t Speed
+ * @param TICKS unsigned int Number of ticks
+ * @return void
+ */
+static void Keep_Speed(MotorSpeed_t SPEED, unsigned int TICKS){
+    unsigned int i;
+
+    for(i = 0; i < TICKS; i++){
+        Persist_Update(&STORE, SPEED);
+        Persist_Wait(&STORE);
+    }
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> A new Store has no Speed **/
+TEST(PERSIST, NewStoreIsEmpty){
+    /*!
+		  * @par Given : No Store File
+		  * @par When  : Store is opened
+		  * @par Then  : There's no saved Speed
+	*/
+    MotorSpeed_t Speed;
+
+    /* Act */
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, PERSIST_STABLE_MS));
+
+    /* Assert */
+    CHECK(!Persist_Load(&STORE, &Speed));
+    LONGS_EQUAL(0, Persist_Writes(&STORE));
+}
+
+
+/** <b> Test Description : </b> A Speed is written once it is kept for the stable time, and is read after reopening **/
+TEST(PERSIST, StableSpeedIsWrittenOnce){
+    /*!
+		  * @par Given : Store with a stable time of 3 ticks
+		  * @par When  : MAX is given for 3 ticks, then one more tick, then 100 more ticks
+		  * @par Then  : Nothing is written in the first 3 ticks, one Record after and MAX is loaded after reopening
+	*/
+    MotorSpeed_t Speed;
+
+    /* Arrange */
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, 3 * SW_TICK_MS));
+
+    /* Act & Assert */
+    Keep_Speed(MAX, 3);
+    LONGS_EQUAL(0, Persist_Writes(&STORE));
+    Keep_Speed(MAX, 1);
+    LONGS_EQUAL(1, Persist_Writes(&STORE));
+    Keep_Speed(MAX, 100);
+    LONGS_EQUAL(1, Persist_Writes(&STORE));
+
+    Persist_Close(&STORE);
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, 3 * SW_TICK_MS));
+    CHECK(Persist_Load(&STORE, &Speed));
+    LONGS_EQUAL(MAX, Speed);
+}
+
+
+/** <b> Test Description : </b> Quick changes are coalesced into one write of the Speed the user stops at **/
+TEST(PERSIST, QuickChangesAreCoalesced){
+    /*!
+		  * @par Given : Store with the default stable time
+		  * @par When  : Speed changes every tick for 1000 ticks then MIN is kept
+		  * @par Then  : Only MIN is written
+	*/
+    MotorSpeed_t Speed;
+    unsigned int i;
+
+    /* Arrange */
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, PERSIST_STABLE_MS));
+
+    /* Act */
+    for(i = 0; i < 1000; i++){
+        Persist_Update(&STORE, (MotorSpeed_t)(i % 3));
+    }
+    Keep_Speed(MIN, PERSIST_STABLE_MS / SW_TICK_MS + 1);
+
+    /* Assert */
+    LONGS_EQUAL(1, Persist_Writes(&STORE));
+    CHECK(Persist_Load(&STORE, &Speed));
+    LONGS_EQUAL(MIN, Speed);
+}
+
+
+/** <b> Test Description : </b> Writes rotate over all Slots and the newest Record wins **/
+TEST(PERSIST, WritesRotateOverSlots){
+    /*!
+		  * @par Given : Store writing every change
+		  * @par When  : Speed changes 3 times more than there are Slots
+		  * @par Then  : Store File holds exactly all Slots and the last Speed is loaded after reopening
+	*/
+    MotorSpeed_t Speed;
+    unsigned int i;
+    long Size;
+
+    /* Arrange */
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, 0));
+
+    /* Act */
+    for(i = 1; i <= 3 * PERSIST_SLOTS; i++){
+        Keep_Speed((MotorSpeed_t)(i % 3), 1);
+    }
+    fseek(STORE.File, 0, SEEK_END);
+    Size = ftell(STORE.File);
+    Persist_Close(&STORE);
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, 0));
+
+    /* Assert */
+    LONGS_EQUAL(3 * PERSIST_SLOTS, i - 1);
+    LONGS_EQUAL(PERSIST_SLOTS * PERSIST_RECORD_SIZE, Size);
+    CHECK(Persist_Load(&STORE, &Speed));
+    LONGS_EQUAL((3 * PERSIST_SLOTS) % 3, Speed);
+}
+
+
+/** <b> Test Description : </b> A torn newest Record is skipped and the Record before it is used **/
+TEST(PERSIST, TornRecordFallsBack){
+    /*!
+		  * @par Given : Store with MAX then MIN written
+		  * @par When  : One byte of the MIN Record is lost
+		  * @par Then  : MAX is loaded after reopening
+	*/
+    MotorSpeed_t Speed;
+
+    /* Arrange */
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, 0));
+    Keep_Speed(MAX, 1);
+    Keep_Speed(MIN, 1);
+    LONGS_EQUAL(2, Persist_Writes(&STORE));
+
+    /* Act */
+    fseek(STORE.File, (long)STORE.Slot * PERSIST_RECORD_SIZE + 5, SEEK_SET);
+    fputc(0x5A, STORE.File);
+    Persist_Close(&STORE);
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, 0));
+
+    /* Assert */
+    CHECK(Persist_Load(&STORE, &Speed));
+    LONGS_EQUAL(MAX, Speed);
+}
+
+
+/** <b> Test Description : </b> Flush writes a Speed before its stable time, and the Controller resumes at it **/
+TEST(PERSIST, FlushThenResume){
+    /*!
+		  * @par Given : Store with the default stable time and Motor Speed set to MIN
+		  * @par When  : Store is flushed after one tick, then Speed_Init() & the saved Speed are applied
+		  * @par Then  : Motor resumes at MIN (140 degrees) instead of MED
+	*/
+    MotorSpeed_t Speed;
+
+    /* Arrange */
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, PERSIST_STABLE_MS));
+    Speed_Set(MIN);
+    Persist_Update(&STORE, Speed_Get());
+
+    /* Act */
+    CHECK(Persist_Flush(&STORE));
+    Persist_Close(&STORE);
+    Speed_Init();
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, PERSIST_STABLE_MS));
+    CHECK(Persist_Load(&STORE, &Speed));
+    Speed_Set(Speed);
+
+    /* Assert */
+    LONGS_EQUAL(MIN, Speed_Get());
+    LONGS_EQUAL(140, MotAngle_Write());
+}
+
+
+/** <b> Test Description : </b> Writes run on the Writer thread and Flush waits for the one in flight **/
+TEST(PERSIST, FlushWaitsForWriter){
+    /*!
+		  * @par Given : Store writing every change with its Writer thread running
+		  * @par When  : MAX is handed to the Writer, MIN is given on the next tick without waiting, then Store is flushed
+		  * @par Then  : Both are written (MIN in the Writer or by Flush) and MIN is loaded after reopening
+	*/
+    MotorSpeed_t Speed;
+
+    /* Arrange */
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, 0));
+    CHECK(STORE.Threaded);
+
+    /* Act */
+    Persist_Update(&STORE, MAX);
+    Persist_Update(&STORE, MIN);
+    CHECK(Persist_Flush(&STORE));
+    LONGS_EQUAL(2, Persist_Writes(&STORE));
+    Persist_Close(&STORE);
+    CHECK(Persist_Open(&STORE, PERSIST_TEST_FILE, 0));
+
+    /* Assert */
+    CHECK(Persist_Load(&STORE, &Speed));
+    LONGS_EQUAL(MIN, Speed);
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(PERSIST){
+    RUN_TEST_CASE(PERSIST, NewStoreIsEmpty);
+    RUN_TEST_CASE(PERSIST, StableSpeedIsWrittenOnce);
+    RUN_TEST_CASE(PERSIST, QuickChangesAreCoalesced);
+    RUN_TEST_CASE(PERSIST, WritesRotateOverSlots);
+    RUN_TEST_CASE(PERSIST, TornRecordFallsBack);
+    RUN_TEST_CASE(PERSIST, FlushThenResume);
+    RUN_TEST_CASE(PERSIST, FlushWaitsForWriter);
+}
@@ -0,0 +1,234 @@
+/**
+ * @file profile_test.c
+ * @brief Testing Speed Profile
+ * @details Here we apply Unit Test using Unity Test-Harness on Speed Profiles: published Angles & long press
+ * threshold, reclaiming replaced Profiles, Profile Files and publishing while the Control Loop runs
+ *
+ */
+
+#include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../../source/profile/profile.h"
+#include "../../source/speedcontrol/speedcontrol.h"
+
+/** @brief Profile File of the tests */
+#define PROFILE_TEST_FILE   "profile_test.txt"
+
+/** @brief Profiles published by the publisher thread */
+#define PROFILE_TEST_PUBLISHES  2000
+
+/** @brief Set by the publisher thread when it is done */
+static atomic_bool PUBLISHED;
+
+/** @brief Define (PROFILE) test group */
+TEST_GROUP(PROFILE);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(PROFILE){
+    Profile_Reset();
+    Speed_Init();
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(PROFILE){
+    Profile_Reset();
+    remove(PROFILE_TEST_FILE);
+    Speed_Init();
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Write a Profile File
+ * @param TEXT const char* File content
+ * @return void
+ */
+static void Write_Profile(const char* TEXT){
+    FILE* File = fopen(PROFILE_TEST_FILE, "w");
+
+    fputs(TEXT, File);
+    fclose(File);
+}
+
+
+/** @brief Publisher thread, it publishes 2 Profiles by turns
+ * @param ARG void* Not used
+ * @return void* NULL
+ */
+static void* Publisher(void* ARG){
+    SpeedProfile_t Profile = {{120, 60, 20}, 30};
+    unsigned int i;
+
+    (void)ARG;
+    for(i = 0; i < PROFILE_TEST_PUBLISHES; i++){
+        Profile.Angles[MED] = (i & 1) ? 60 : 70;
+        Profile_Publish(&Profile);
+    }
+    atomic_store(&PUBLISHED, true);
+    return NULL;
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> Default Profile is the built in Angles & threshold **/
+TEST(PROFILE, DefaultProfile){
+    /*!
+		  * @par Given : No Profile published
+		  * @par When  : Motor Angle is written at every Speed
+		  * @par Then  : Angles are 140, 90 & 10 and long press threshold is 30
+	*/
+
+    /* Act & Assert */
+    LONGS_EQUAL(30, Profile_Current()->LongPress);
+    Speed_Set(MIN);
+    LONGS_EQUAL(140, MotAngle_Write());
+    Speed_Set(MED);
+    LONGS_EQUAL(90, MotAngle_Write());
+    Speed_Set(MAX);
+    LONGS_EQUAL(10, MotAngle_Write());
+}
+
+
+/** <b> Test Description : </b> A published Profile sets Angles and long press threshold **/
+TEST(PROFILE, PublishedProfileIsUsed){
+    /*!
+		  * @par Given : Profile of 150, 100 & 20 degrees and long press at 5 seconds
+		  * @par When  : Profile is published, then P is PRESSED for 5 seconds
+		  * @par Then  : MED Angle is 100 and Speed goes to MIN at 150 degrees
+	*/
+    SpeedProfile_t Profile = {{150, 100, 20}, 5};
+    SpeedController_t Ctl;
+    SpeedInput_t Input = {RELEASED, RELEASED, PRESSED, 4};
+
+    /* Arrange */
+    CHECK(Profile_Publish(&Profile));
+    SpeedCtl_Init(&Ctl);
+
+    /* Act & Assert */
+    LONGS_EQUAL(100, MotAngle_Write());
+    SpeedCtl_Update(&Ctl, &Input);
+    LONGS_EQUAL(MED, Ctl.Speed);
+    Input.P_PressTime = 5;
+    SpeedCtl_Update(&Ctl, &Input);
+    LONGS_EQUAL(MIN, Ctl.Speed);
+    LONGS_EQUAL(150, SpeedCtl_Angle(&Ctl));
+}
+
+
+/** <b> Test Description : </b> Bad Profiles are refused and the Profile in use is kept **/
+TEST(PROFILE, BadProfileIsRefused){
+    /*!
+		  * @par Given : Default Profile
+		  * @par When  : A Profile with a 200 degrees Angle and one with long press at 0 are published
+		  * @par Then  : Both are refused and MED Angle is 90
+	*/
+    SpeedProfile_t Wide = {{200, 90, 10}, 30};
+    SpeedProfile_t NoPress = {{140, 90, 10}, 0};
+
+    /* Act & Assert */
+    CHECK(!Profile_Publish(&Wide));
+    CHECK(!Profile_Publish(&NoPress));
+    LONGS_EQUAL(90, MotAngle_Write());
+    CHECK(Profile_Current() == &PROFILE_DEFAULT);
+}
+
+
+/** <b> Test Description : </b> A replaced Profile is reclaimed after the next tick, not before **/
+TEST(PROFILE, ReplacedProfileIsReclaimedAfterNextTick){
+    /*!
+		  * @par Given : Profile A published
+		  * @par When  : Profile B replaces A, then ticks end
+		  * @par Then  : A is kept at the end of this tick and reclaimed at the end of the next one
+	*/
+    SpeedProfile_t A = {{130, 80, 30}, 30};
+    SpeedProfile_t B = {{120, 70, 20}, 30};
+
+    /* Arrange */
+    CHECK(Profile_Publish(&A));
+    LONGS_EQUAL(0, Profile_Retired());
+
+    /* Act & Assert */
+    CHECK(Profile_Publish(&B));
+    LONGS_EQUAL(1, Profile_Retired());
+    Profile_Tick();
+    LONGS_EQUAL(1, Profile_Retired());
+    Profile_Tick();
+    LONGS_EQUAL(0, Profile_Retired());
+    LONGS_EQUAL(70, MotAngle_Write());
+}
+
+
+/** <b> Test Description : </b> Profile Files set the values they have, bad Files are refused **/
+TEST(PROFILE, ProfileFile){
+    /*!
+		  * @par Given : Profile File with MED Angle, long press threshold & comments
+		  * @par When  : It is loaded, then Files with an unknown key and a 181 degrees Angle are loaded
+		  * @par Then  : MED is 95, long press is 10, other values are default and both bad Files are refused
+	*/
+    SpeedProfile_t Profile;
+
+    /* Act & Assert */
+    Write_Profile("# test floor tuning\nmed 95\n\nlong_press 10   # seconds\n");
+    CHECK(Profile_Load(PROFILE_TEST_FILE, &Profile));
+    LONGS_EQUAL(140, Profile.Angles[MIN]);
+    LONGS_EQUAL(95, Profile.Angles[MED]);
+    LONGS_EQUAL(10, Profile.Angles[MAX]);
+    LONGS_EQUAL(10, Profile.LongPress);
+
+    Write_Profile("fast 5\n");
+    CHECK(!Profile_Load(PROFILE_TEST_FILE, &Profile));
+    Write_Profile("max 181\n");
+    CHECK(!Profile_Load(PROFILE_TEST_FILE, &Profile));
+    CHECK(!Profile_Load("no_such_profile.txt", &Profile));
+}
+
+
+/** <b> Test Description : </b> Profiles published by another thread never stop nor break the Control Loop **/
+TEST(PROFILE, PublishWhileRunning){
+    /*!
+		  * @par Given : Motor at MED Speed
+		  * @par When  : Another thread publishes 2000 Profiles (MED 60 or 70) while ticks run
+		  * @par Then  : Every Motor Angle is 90, 60 or 70 and all replaced Profiles are reclaimed
+	*/
+    pthread_t Thread;
+    short Angle;
+    bool Ok = true;
+
+    /* Arrange */
+    atomic_store(&PUBLISHED, false);
+    CHECK(pthread_create(&Thread, NULL, Publisher, NULL) == 0);
+
+    /* Act */
+    while(!atomic_load(&PUBLISHED)){
+        Angle = MotAngle_Write();
+        Ok = Ok && (Angle == 90 || Angle == 60 || Angle == 70);
+        Profile_Tick();
+    }
+    pthread_join(Thread, NULL);
+    Profile_Tick();
+    Profile_Tick();
+
+    /* Assert */
+    CHECK(Ok);
+    LONGS_EQUAL(0, Profile_Retired());
+    LONGS_EQUAL(60, MotAngle_Write());
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(PROFILE){
+    RUN_TEST_CASE(PROFILE, DefaultProfile);
+    RUN_TEST_CASE(PROFILE, PublishedProfileIsUsed);
+    RUN_TEST_CASE(PROFILE, BadProfileIsRefused);
+    RUN_TEST_CASE(PROFILE, ReplacedProfileIsReclaimedAfterNextTick);
+    RUN_TEST_CASE(PROFILE, ProfileFile);
+    RUN_TEST_CASE(PROFILE, PublishWhileRunning);
+}
@@ -0,0 +1,59 @@
+/**
+ * @file reference_model.c
+ * @brief Reference Model main file
+ * @details Here we write the Specifications again as simple arithmetic on Speed numbers:
+ * every rule moves Speed one step and Speed is kept between minimum and maximum after every rule.
+ * Rules are applied in priority order: P switch, then -ve switch, then +ve switch
+ *
+ */
+
+ /*    Include Header    */
+#include"reference_model.h"
+
+/** @brief Motor Angles Specifications indexed by Speed */
+static const short REF_ANGLES[] = {140, 90, 10};
+
+
+/** @brief Move Speed one step and keep it between minimum and maximum
+ * @param SPEED int Current Speed
+ * @param STEP int +1 to increase & -1 to decrease
+ * @return int Next Speed
+ */
+static int RefModel_Move(int SPEED, int STEP){
+    int Next = SPEED + STEP;
+
+    if(Next < REF_SPEED_MIN){
+        return REF_SPEED_MIN;
+    }
+    if(Next > REF_SPEED_MAX){
+        return REF_SPEED_MAX;
+    }
+    return Next;
+}
+
+
+unsigned char RefModel_Step(unsigned char SPEED, const SpeedInput_t* INPUT){
+    int Speed = SPEED;
+
+    /* "p" switch pressed for 30 seconds */
+    if(INPUT->P_State == PRESSED && INPUT->P_PressTime >= REF_LONG_PRESS){
+        Speed = RefModel_Move(Speed, -1);
+    }
+
+    /* "-ve" switch pre pressed */
+    if(INPUT->Negative_State == PREPRESSED){
+        Speed = RefModel_Move(Speed, -1);
+    }
+
+    /* "+ve" switch pre pressed */
+    if(INPUT->Postive_State == PREPRESSED){
+        Speed = RefModel_Move(Speed, +1);
+    }
+
+    return (unsigned char)Speed;
+}
+
+
+short RefModel_Angle(unsigned char SPEED){
+    return REF_ANGLES[SPEED];
+}
@@ -0,0 +1,35 @@
+/**
+ * @file reference_model.h
+ * @brief Reference Model header file
+ */
+
+#ifndef REFERENCE_MODEL_H_INCLUDED
+#define REFERENCE_MODEL_H_INCLUDED
+
+#include"../../source/speedcontrol/speedcontrol.h"
+
+/** @brief Reference Speeds are numbers, 0 is minimum & 2 is maximum */
+#define REF_SPEED_MIN       0
+#define REF_SPEED_MED       1
+#define REF_SPEED_MAX       2
+
+/** @brief P Switch must be pressed at least this Press Time to decrease Speed */
+#define REF_LONG_PRESS      30
+
+
+/** @brief Next Speed after one Speed Update, written from the Specifications only
+ * (not from speedcontrol.c) so both can be compared
+ * @param SPEED unsigned char Current Speed from REF_SPEED_MIN to REF_SPEED_MAX
+ * @param INPUT const SpeedInput_t* Switches States & P Press Time
+ * @return unsigned char Next Speed
+ */
+unsigned char RefModel_Step(unsigned char SPEED, const SpeedInput_t* INPUT);
+
+
+/** @brief Motor Angle of a Speed from the Specifications
+ * @param SPEED unsigned char Speed from REF_SPEED_MIN to REF_SPEED_MAX
+ * @return short Motor Angle
+ */
+short RefModel_Angle(unsigned char SPEED);
+
+#endif // REFERENCE_MODEL_H_INCLUDED
@@ -0,0 +1,176 @@
+/**
+ * @file replay.c
+ * @brief Replay Engine main file
+ * @details Every Test Case starts from default Speed, so Test Cases don't depend on each other.
+ * Here we share them between Worker Threads, every Worker has its own Reader & Controller,
+ * then Results are written in the Trace order
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+ /*    Include Header    */
+#include"replay.h"
+
+  /*    Include Modules    */
+#include"../result_sink/result_sink.h"
+
+/** @brief Work shared by all Workers of one Replay */
+typedef struct {
+    const TraceReader_t* Trace;
+    const TraceIndex_t* Index;
+    unsigned char* Angles;
+    unsigned long Batch;
+    atomic_ulong NextCase;
+    atomic_bool Failed;
+} ReplayJob_t;
+
+
+bool Replay_Case(TraceReader_t* READER, const TraceIndex_t* INDEX, unsigned long CASE, SpeedController_t* CTL){
+    TraceLine_t Line;
+    TraceStatus_t Status;
+    SpeedInput_t Input;
+    unsigned long Lines = 0;
+
+    SpeedCtl_Init(CTL);
+    if(!TraceIndex_Seek(INDEX, READER, CASE)){
+        return false;
+    }
+
+    while((Status = Trace_ReadLine(READER, &Line)) != TRACE_END_OF_CASE && Status != TRACE_END_OF_FILE){
+        Lines++;
+        if(Status == TRACE_DATA){
+            Input.Postive_State = Line.Postive_State;
+            Input.Negative_State = Line.Negative_State;
+            Input.P_State = Line.P_State;
+            Input.P_PressTime = Line.P_PressTime;
+            SpeedCtl_Update(CTL, &Input);
+        }
+    }
+    return Lines == INDEX->Cases[CASE].Lines;
+}
+
+
+/** @brief Worker Thread, it replays batches of Test Cases till all are taken, a failed Test Case sets Failed
+ * @param ARG void* ReplayJob_t shared by Workers
+ * @return void* NULL
+ */
+static void* Replay_Worker(void* ARG){
+    ReplayJob_t* Job = ARG;
+    TraceReader_t Reader;
+    SpeedController_t Controller;
+    unsigned long First, Case, Last;
+
+    /* Own Reader over the same mapped bytes, it must not unmap them */
+    Reader = *Job->Trace;
+    Reader.Mapped = false;
+
+    for(;;){
+        First = atomic_fetch_add_explicit(&Job->NextCase, Job->Batch, memory_order_relaxed);
+        if(First >= Job->Index->Count){
+            break;
+        }
+        Last = (First + Job->Batch < Job->Index->Count) ? First + Job->Batch : Job->Index->Count;
+
+        for(Case = First; Case < Last; Case++){
+            if(!Replay_Case(&Reader, Job->Index, Case, &Controller)){
+                atomic_store_explicit(&Job->Failed, true, memory_order_relaxed);
+            }
+            Job->Angles[Case] = (unsigned char)SpeedCtl_Angle(&Controller);
+        }
+    }
+    return NULL;
+}
+
+
+/** @brief Number of Worker Threads to use when it is not given
+ * @param void
+ * @return unsigned int Number of online CPUs
+ */
+static unsigned int Replay_DefaultThreads(void){
+#ifdef _SC_NPROCESSORS_ONLN
+    long Cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return (Cpus > 0) ? (unsigned int)Cpus : 1;
+#else
+    return 1;
+#endif
+}
+
+
+bool Replay_Run(const char* TRACE_PATH, const char* RESULT_PATH, unsigned int THREADS, unsigned int BATCH){
+    TraceReader_t Trace;
+    TraceIndex_t Index;
+    ReplayJob_t Job;
+    ResultSink_t Results;
+    pthread_t Workers[REPLAY_MAX_THREADS];
+    unsigned int Started = 0, i;
+    unsigned long Case;
+    bool Ok = true;
+
+    if(!Trace_Open(&Trace, TRACE_PATH)){
+        return false;
+    }
+    if(!TraceIndex_Load(&Index, TRACE_PATH, &Trace)){
+        Trace_Close(&Trace);
+        return false;
+    }
+
+    Job.Trace = &Trace;
+    Job.Index = &Index;
+    Job.Angles = malloc(Index.Count ? Index.Count : 1);
+    Job.Batch = (BATCH != 0) ? BATCH : REPLAY_BATCH;
+    atomic_init(&Job.NextCase, 0);
+    atomic_init(&Job.Failed, false);
+    if(!Job.Angles){
+        TraceIndex_Free(&Index);
+        Trace_Close(&Trace);
+        return false;
+    }
+
+    if(THREADS == 0){
+        THREADS = Replay_DefaultThreads();
+    }
+    if(THREADS > REPLAY_MAX_THREADS){
+        THREADS = REPLAY_MAX_THREADS;
+    }
+
+    /* No need for more Workers than batches */
+    for(i = 0; i < THREADS && (unsigned long)i * Job.Batch < Index.Count; i++){
+        if(pthread_create(&Workers[i], NULL, Replay_Worker, &Job) != 0){
+            break;
+        }
+        Started++;
+    }
+
+    /* If no thread could start, this thread does the work */
+    if(Started == 0){
+        Replay_Worker(&Job);
+    }
+    for(i = 0; i < Started; i++){
+        pthread_join(Workers[i], NULL);
+    }
+
+    /* Joined Workers, all their stores are seen here */
+    if(atomic_load_explicit(&Job.Failed, memory_order_relaxed)){
+        Ok = false;
+    }else if(ResultSink_Open(&Results, RESULT_PATH)){
+        for(Case = 0; Case < Index.Count && Ok; Case++){
+            Ok = ResultSink_Write(&Results, Job.Angles[Case]);
+        }
+        Ok = ResultSink_Close(&Results) && Ok;
+    }else{
+        Ok = false;
+    }
+
+    free(Job.Angles);
+    TraceIndex_Free(&Index);
+    Trace_Close(&Trace);
+    return Ok;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file replay.h
+ * @brief Replay Engine header file
+ */
+
+#ifndef REPLAY_H_INCLUDED
+#define REPLAY_H_INCLUDED
+
+#include <stdbool.h>
+
+#include"../trace_reader/trace_reader.h"
+#include"../trace_reader/trace_index.h"
+#include"../../source/speedcontrol/speedcontrol.h"
+
+/** @brief Most Worker Threads one Replay can use */
+#define REPLAY_MAX_THREADS      64
+
+/** @brief Number of Test Cases a Worker takes every time by default, so Workers rarely touch the shared counter */
+#define REPLAY_BATCH            256
+
+
+/** @brief Replay one Test Case on its own Controller, the Controller starts from default Speed
+ * @param READER TraceReader_t* Reader of the Trace, every thread needs its own Reader
+ * @param INDEX const TraceIndex_t* Index of the Trace
+ * @param CASE unsigned long Test Case number starting from 0
+ * @param CTL SpeedController_t* Controller to replay on
+ * @return bool true if Test Case is replayed & false if it doesn't exist or the Trace doesn't have the Lines
+ * the Index gives it (stale Index)
+ */
+bool Replay_Case(TraceReader_t* READER, const TraceIndex_t* INDEX, unsigned long CASE, SpeedController_t* CTL);
+
+
+/** @brief Replay all Test Cases of a Trace on THREADS Worker Threads and write
+ * Motor Angle of every Test Case to Result File (motor.txt Format) in the Trace order
+ * @param TRACE_PATH const char* Trace File (Text or Binary)
+ * @param RESULT_PATH const char* Result File
+ * @param THREADS unsigned int Number of Worker Threads, 0 uses one per CPU. No more Workers than batches are started
+ * @param BATCH unsigned int Number of Test Cases a Worker takes every time, 0 uses REPLAY_BATCH
+ * @return bool true if all Test Cases are replayed & written & false if not, no Result File is written
+ * if a Test Case fails
+ */
+bool Replay_Run(const char* TRACE_PATH, const char* RESULT_PATH, unsigned int THREADS, unsigned int BATCH);
+
+#endif // REPLAY_H_INCLUDED
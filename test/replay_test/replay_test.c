@@ -0,0 +1,169 @@
+/**
+ * @file replay_test.c
+ * @brief Testing Parallel Replay process
+ * @details Here we apply Unit Test using Unity Test-Harness on Replay Engine which replay switch.txt Test Cases on many threads
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../replay/replay.h"
+
+/** @brief Results of switch.txt Test Cases as written by UPDATE tests */
+static const char EXPECTED_RESULTS[] = "MotorAngle\n90\n10\n10\n140\n90\n140\n10\n140\n90\n";
+
+/** @brief Define (REPLAY) test group */
+TEST_GROUP(REPLAY);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(REPLAY){
+
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(REPLAY){
+    remove("replay_test.txt");
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief  Replay switch.txt and check Result File
+ * @param THREADS unsigned int Number of Worker Threads
+ * @param BATCH unsigned int Test Cases a Worker takes every time
+ * @return void
+ */
+static void ReplayMatchesExpected(unsigned int THREADS, unsigned int BATCH){
+    char Results[sizeof(EXPECTED_RESULTS) + 16];
+    size_t Len;
+    FILE* File;
+
+    /* Act */
+    CHECK(Replay_Run("switch.txt", "replay_test.txt", THREADS, BATCH));
+
+    /* Assert */
+    File = fopen("replay_test.txt", "r");
+    CHECK(File != NULL);
+    Len = fread(Results, 1, sizeof(Results) - 1, File);
+    fclose(File);
+    Results[Len] = '\0';
+    STRCMP_EQUAL(EXPECTED_RESULTS, Results);
+}
+
+
+/** @brief Write a small Trace File
+ * @param PATH const char* Trace File path
+ * @param TEXT const char* Trace Lines
+ * @return void
+ */
+static void Write_Trace(const char* PATH, const char* TEXT){
+    FILE* File = fopen(PATH, "wb");
+
+    CHECK(File != NULL);
+    fputs(TEXT, File);
+    fclose(File);
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> Replay on one thread gives the same Results as UPDATE tests **/
+TEST(REPLAY, SerialReplayMatchesExpectedAngles){
+    /*!
+		  * @par Given : switch.txt with 9 Test Cases
+		  * @par When  : Replay_Run() is called with 1 thread
+		  * @par Then  : Motor Angles of the 9 Test Cases are written in order
+	*/
+    ReplayMatchesExpected(1, 0);
+}
+
+
+/** <b> Test Description : </b> Replay on many threads keeps Results in Trace order **/
+TEST(REPLAY, ParallelReplayKeepsTraceOrder){
+    /*!
+		  * @par Given : switch.txt with 9 Test Cases
+		  * @par When  : Replay_Run() is called with 8 threads taking 1 Test Case every time, so all 8 threads run
+		  * @par Then  : Motor Angles of the 9 Test Cases are written in order
+	*/
+    ReplayMatchesExpected(8, 1);
+}
+
+
+/** <b> Test Description : </b> A Test Case failing on any Worker fails the whole Replay **/
+TEST(REPLAY, FailedCaseFailsReplay){
+    /*!
+		  * @par Given : Trace with 3 Test Cases & its Sidecar Index, then the Sidecar gives the last one 5 Lines
+		  * @par When  : Replay_Run() is called with 3 threads taking 1 Test Case every time
+		  * @par Then  : First Replay succeeds, the Replay with the stale Index fails & writes no Result File
+	*/
+    static const char* const TRACE_PATH = "replay_stale_test.txt";
+    static const char* const SIDECAR_PATH = "replay_stale_test.txt" TRACE_INDEX_SUFFIX;
+    uint64_t Lines = 5;
+    bool First, Second;
+    FILE* File;
+
+    /* Arrange */
+    Write_Trace(TRACE_PATH, "RELEASED RELEASED RELEASED 0\n- - - -\nPRE_PRESSED RELEASED RELEASED 0\n- - - -\n"
+                            "RELEASED PRE_PRESSED RELEASED 0\n- - - -\n");
+    First = Replay_Run(TRACE_PATH, "replay_test.txt", 3, 1);
+    remove("replay_test.txt");
+
+    /* Lines of the last Sidecar Entry {Offset, Lines} are the last bytes */
+    File = fopen(SIDECAR_PATH, "r+b");
+    CHECK(File != NULL);
+    fseek(File, -(long)sizeof(Lines), SEEK_END);
+    fwrite(&Lines, sizeof(Lines), 1, File);
+    fclose(File);
+
+    /* Act */
+    Second = Replay_Run(TRACE_PATH, "replay_test.txt", 3, 1);
+    File = fopen("replay_test.txt", "r");
+    remove(TRACE_PATH);
+    remove(SIDECAR_PATH);
+
+    /* Assert */
+    CHECK(First);
+    CHECK(!Second);
+    CHECK(File == NULL);
+    if(File){
+        fclose(File);
+    }
+}
+
+
+/** <b> Test Description : </b> Controllers don't share Speed **/
+TEST(REPLAY, ControllersAreIndependent){
+    /*!
+		  * @par Given : Two Controllers at default Speed
+		  * @par When  : First one is Increased
+		  * @par Then  : Second one is still MED (Motor Angle is 90)
+	*/
+    SpeedController_t First, Second;
+
+    /* Arrange */
+    SpeedCtl_Init(&First);
+    SpeedCtl_Init(&Second);
+
+    /* Act */
+    SpeedCtl_Increase(&First);
+
+    /* Assert */
+    LONGS_EQUAL(10, SpeedCtl_Angle(&First));
+    LONGS_EQUAL(90, SpeedCtl_Angle(&Second));
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(REPLAY){
+    RUN_TEST_CASE(REPLAY, SerialReplayMatchesExpectedAngles);
+    RUN_TEST_CASE(REPLAY, ParallelReplayKeepsTraceOrder);
+    RUN_TEST_CASE(REPLAY, FailedCaseFailsReplay);
+    RUN_TEST_CASE(REPLAY, ControllersAreIndependent);
+}
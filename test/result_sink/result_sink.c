@@ -0,0 +1,139 @@
+/**
+ * @file result_sink.c
+ * @brief Result Sink main file
+ * @details Here we open motor.txt once, collect Test Results in a buffer and append them,
+ * the disk is synced only on Flush or Close
+ *
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+ /*    Include Header    */
+#include"result_sink.h"
+
+
+/** @brief Write buffered bytes into Result File
+ * @param SINK ResultSink_t* Opened Sink
+ * @return bool true if bytes are written & false if not
+ */
+static bool ResultSink_Drain(ResultSink_t* SINK){
+    if(SINK->Used != 0 && fwrite(SINK->Buffer, 1, SINK->Used, SINK->File) != SINK->Used){
+        SINK->Failed = true;
+    }
+    SINK->Used = 0;
+    return !SINK->Failed;
+}
+
+
+bool ResultSink_Open(ResultSink_t* SINK, const char* PATH){
+    SINK->Used = 0;
+    SINK->Failed = false;
+    SINK->File = fopen(PATH, "w");
+    if(!SINK->File){
+        return false;
+    }
+
+    /* We have our own buffer */
+    setvbuf(SINK->File, NULL, _IONBF, 0);
+
+    memcpy(SINK->Buffer, RESULT_SINK_HEADER "\n", sizeof(RESULT_SINK_HEADER));
+    SINK->Used = sizeof(RESULT_SINK_HEADER);
+    return true;
+}
+
+
+bool ResultSink_IsOpen(const ResultSink_t* SINK){
+    return SINK->File != NULL;
+}
+
+
+bool ResultSink_Write(ResultSink_t* SINK, unsigned char MotorAngle){
+    char Line[4];
+    size_t Len = 0;
+
+    /* Same Line as "%hhu\n" */
+    if(MotorAngle >= 100){
+        Line[Len++] = (char)('0' + MotorAngle / 100);
+    }
+    if(MotorAngle >= 10){
+        Line[Len++] = (char)('0' + (MotorAngle / 10) % 10);
+    }
+    Line[Len++] = (char)('0' + MotorAngle % 10);
+    Line[Len++] = '\n';
+
+    if(SINK->Used + Len > RESULT_SINK_BUFFER){
+        ResultSink_Drain(SINK);
+    }
+    memcpy(SINK->Buffer + SINK->Used, Line, Len);
+    SINK->Used += Len;
+
+    return !SINK->Failed;
+}
+
+
+bool ResultSink_WriteEmpty(ResultSink_t* SINK){
+    if(SINK->Used + 1 > RESULT_SINK_BUFFER){
+        ResultSink_Drain(SINK);
+    }
+    SINK->Buffer[SINK->Used++] = '\n';
+
+    return !SINK->Failed;
+}
+
+
+unsigned int ResultSink_Read(const char* PATH, short* ANGLES, unsigned int MAX){
+    FILE* File = fopen(PATH, "r");
+    char Line[16];
+    char* End;
+    unsigned long Angle;
+    unsigned int Count = 0;
+
+    if(!File){
+        return 0;
+    }
+
+    /* Header Line first */
+    if(fgets(Line, sizeof(Line), File)){
+        while(Count < MAX && fgets(Line, sizeof(Line), File)){
+            Angle = strtoul(Line, &End, 10);
+            ANGLES[Count++] = (End != Line && (*End == '\n' || *End == '\r' || *End == '\0') && Angle <= 255) ? (short)Angle : -1;
+        }
+    }
+    fclose(File);
+    return Count;
+}
+
+
+bool ResultSink_Flush(ResultSink_t* SINK){
+    if(!ResultSink_Drain(SINK)){
+        return false;
+    }
+#ifdef _WIN32
+    if(_commit(_fileno(SINK->File)) != 0){
+#else
+    if(fsync(fileno(SINK->File)) != 0){
+#endif
+        SINK->Failed = true;
+    }
+    return !SINK->Failed;
+}
+
+
+bool ResultSink_Close(ResultSink_t* SINK){
+    bool Ok;
+
+    if(!SINK->File){
+        return false;
+    }
+    Ok = ResultSink_Flush(SINK);
+    Ok = (fclose(SINK->File) == 0) && Ok;
+    SINK->File = NULL;
+    return Ok;
+}
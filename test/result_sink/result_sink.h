@@ -0,0 +1,81 @@
+/**
+ * @file result_sink.h
+ * @brief Result Sink header file
+ */
+
+#ifndef RESULT_SINK_H_INCLUDED
+#define RESULT_SINK_H_INCLUDED
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/** @brief First Line of motor.txt */
+#define RESULT_SINK_HEADER      "MotorAngle"
+
+/** @brief Number of bytes collected before they are written to the Result File */
+#define RESULT_SINK_BUFFER      4096
+
+
+/** @brief A Result File opened once for appending Test Results */
+typedef struct {
+    FILE* File;
+    char Buffer[RESULT_SINK_BUFFER];
+    size_t Used;
+    bool Failed;
+} ResultSink_t;
+
+
+/** @brief Create Result File (motor.txt Format) and write its Header
+ * @param SINK ResultSink_t* Sink to open
+ * @param PATH const char* Result File path
+ * @return bool true if Result File is created & false if not
+ */
+bool ResultSink_Open(ResultSink_t* SINK, const char* PATH);
+
+
+/** @brief Check Whether Sink is opened or not
+ * @param SINK const ResultSink_t* Sink to check
+ * @return bool true if Sink is opened & false if not
+ */
+bool ResultSink_IsOpen(const ResultSink_t* SINK);
+
+
+/** @brief Append one Test Result (Motor Angle) Line, it is buffered until Flush or Close
+ * @param SINK ResultSink_t* Opened Sink
+ * @param MotorAngle unsigned char Motor Angle Result
+ * @return bool true if Result is accepted & false if an earlier write failed
+ */
+bool ResultSink_Write(ResultSink_t* SINK, unsigned char MotorAngle);
+
+
+/** @brief Write buffered Results and sync them to the disk
+ * @param SINK ResultSink_t* Opened Sink
+ * @return bool true if all Results are on the disk & false if not
+ */
+bool ResultSink_Flush(ResultSink_t* SINK);
+
+
+/** @brief Append an empty Line, for a Test Case which has no Result
+ * @param SINK ResultSink_t* Opened Sink
+ * @return bool true if Line is accepted & false if an earlier write failed
+ */
+bool ResultSink_WriteEmpty(ResultSink_t* SINK);
+
+
+/** @brief Read Test Results of an existing Result File (motor.txt Format)
+ * @param PATH const char* Result File path
+ * @param ANGLES short* Where to read Motor Angles, a Line which isn't a Motor Angle is read as -1
+ * @param MAX unsigned int Most Results to read
+ * @return unsigned int Number of Result Lines read, 0 if there's no Result File
+ */
+unsigned int ResultSink_Read(const char* PATH, short* ANGLES, unsigned int MAX);
+
+
+/** @brief Flush and close Result File
+ * @param SINK ResultSink_t* Sink to close
+ * @return bool true if all Results are on the disk & false if not
+ */
+bool ResultSink_Close(ResultSink_t* SINK);
+
+#endif // RESULT_SINK_H_INCLUDED
@@ -0,0 +1,171 @@
+/**
+ * @file scheduler_test.c
+ * @brief Testing Scheduler
+ * @details Here we apply Unit Test using Unity Test-Harness on Scheduler which runs the Control Loop Tasks every tick
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../../source/scheduler/scheduler.h"
+
+/** @brief Tasks run so far, in order */
+static char RAN[16];
+static unsigned int RAN_COUNT;
+
+/** @brief Times given to the hooks */
+static unsigned int HOOK_TASKS;
+static unsigned long HOOK_TICK;
+static uint64_t TICK_START, TICK_END;
+static bool TASK_TIMES_OK;
+
+/** @brief Define (SCHED) test group */
+TEST_GROUP(SCHED);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(SCHED){
+    RAN_COUNT = 0;
+    HOOK_TASKS = 0;
+    HOOK_TICK = 99;
+    TASK_TIMES_OK = true;
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(SCHED){
+    Sched_Init(NULL, 0);
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Test Tasks, they write their name */
+static void Task_A(void){
+    RAN[RAN_COUNT++] = 'A';
+}
+
+static void Task_B(void){
+    RAN[RAN_COUNT++] = 'B';
+}
+
+/** @brief Task longer than one tick */
+static void Task_Late(void){
+    struct timespec Start, Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+    do{
+        clock_gettime(CLOCK_MONOTONIC, &Now);
+    }while((uint64_t)(Now.tv_sec - Start.tv_sec) * 1000000000u + (uint64_t)Now.tv_nsec - (uint64_t)Start.tv_nsec < SCHED_TICK_NS * 3 / 2);
+}
+
+/** @brief Test hooks, they keep the times */
+static void Hook_Task(unsigned int TASK, uint64_t START, uint64_t END){
+    TASK_TIMES_OK = TASK_TIMES_OK && START <= END;
+    HOOK_TASKS |= 1u << TASK;
+}
+
+static void Hook_Tick(unsigned long TICK, uint64_t START, uint64_t END){
+    HOOK_TICK = TICK;
+    TICK_START = START;
+    TICK_END = END;
+}
+
+static const SchedTask_t TASKS[] = {{"A", Task_A}, {"B", Task_B}};
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> Every Task runs once a tick in order **/
+TEST(SCHED, TasksRunInOrderEveryTick){
+    /*!
+		  * @par Given : Scheduler with Tasks A & B
+		  * @par When  : Two ticks are run
+		  * @par Then  : A, B, A, B ran and two ticks are counted
+	*/
+
+    /* Arrange */
+    CHECK(Sched_Init(TASKS, 2));
+
+    /* Act */
+    Sched_RunTick();
+    Sched_RunTick();
+
+    /* Assert */
+    LONGS_EQUAL(4, RAN_COUNT);
+    CHECK(memcmp(RAN, "ABAB", 4) == 0);
+    LONGS_EQUAL(2, Sched_Ticks());
+    STRCMP_EQUAL("B", Sched_Task(1)->Name);
+    CHECK(Sched_Task(2) == NULL);
+}
+
+
+/** <b> Test Description : </b> Hooks get Task & tick times **/
+TEST(SCHED, HooksGetTimes){
+    /*!
+		  * @par Given : Scheduler with Tasks A & B and both hooks set
+		  * @par When  : One tick is run
+		  * @par Then  : Task hook is called for both Tasks and tick hook for tick 0, times are in order
+	*/
+
+    /* Arrange */
+    CHECK(Sched_Init(TASKS, 2));
+    UT_PTR_SET(Sched_OnTask, Hook_Task);
+    UT_PTR_SET(Sched_OnTick, Hook_Tick);
+
+    /* Act */
+    Sched_RunTick();
+
+    /* Assert */
+    LONGS_EQUAL(3, HOOK_TASKS);
+    CHECK(TASK_TIMES_OK);
+    LONGS_EQUAL(0, HOOK_TICK);
+    CHECK(TICK_START <= TICK_END);
+}
+
+
+/** <b> Test Description : </b> Too many Tasks are refused **/
+TEST(SCHED, TooManyTasksAreRefused){
+    /*!
+		  * @par Given : More than SCHED_MAX_TASKS Tasks
+		  * @par When  : Sched_Init() is called
+		  * @par Then  : It fails
+	*/
+    CHECK(!Sched_Init(TASKS, SCHED_MAX_TASKS + 1));
+}
+
+
+/** <b> Test Description : </b> A tick longer than the tick period is an overrun **/
+TEST(SCHED, LateTickIsCountedAsOverrun){
+    /*!
+		  * @par Given : A Task running one and a half ticks
+		  * @par When  : It runs once then the Scheduler waits for the next tick twice
+		  * @par Then  : First wait is an overrun, second one is in time
+	*/
+    static const SchedTask_t Late[] = {{"Late", Task_Late}};
+
+    /* Arrange */
+    CHECK(Sched_Init(Late, 1));
+
+    /* Act */
+    Sched_RunTick();
+
+    /* Assert */
+    CHECK(!Sched_WaitNextTick());
+    CHECK(Sched_WaitNextTick());
+    LONGS_EQUAL(1, Sched_Overruns());
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(SCHED){
+    RUN_TEST_CASE(SCHED, TasksRunInOrderEveryTick);
+    RUN_TEST_CASE(SCHED, HooksGetTimes);
+    RUN_TEST_CASE(SCHED, TooManyTasksAreRefused);
+    RUN_TEST_CASE(SCHED, LateTickIsCountedAsOverrun);
+}
@@ -0,0 +1,142 @@
+/**
+ * @file state_explorer.c
+ * @brief State Space Explorer main file
+ * @details Here we check Speed Update on every Speed, every Switches States combination and every
+ * P Press Time class, then on every sequence of those Inputs up to a given length. <br>
+ * Sequences are explored depth first: the Controller after a prefix is kept, so each sequence
+ * adds one Speed Update only. Lengths are explored from 1 up, so the first failed sequence is a shortest one. Reached Speed transitions & pairs of consecutive transitions are
+ * counted to show State transition coverage (0-switch & 1-switch)
+ *
+ */
+
+ /*    Include Header    */
+#include"state_explorer.h"
+
+#include <string.h>
+
+#include"../reference_model/reference_model.h"
+
+/** @brief P Press Time of every class */
+static const unsigned char PRESS_TIMES[EXPLORER_TIME_CLASSES] = {0, 29, 30, 31, 254, 255};
+
+/** @brief One exploration */
+typedef struct {
+    ExplorerStep_t Step;
+    unsigned int Depth;
+    SpeedInput_t Inputs[EXPLORER_INPUTS];
+    unsigned char Next[EXPLORER_SPEEDS][EXPLORER_INPUTS];
+    unsigned int Path[EXPLORER_MAX_DEPTH];
+    bool Reached[EXPLORER_SPEEDS * EXPLORER_SPEEDS];
+    bool ReachedPairs[EXPLORER_SPEEDS * EXPLORER_SPEEDS][EXPLORER_SPEEDS * EXPLORER_SPEEDS];
+    ExplorerReport_t* Report;
+} Explorer_t;
+
+
+void Explorer_Input(unsigned int NUMBER, SpeedInput_t* INPUT){
+    INPUT->P_PressTime = PRESS_TIMES[NUMBER % EXPLORER_TIME_CLASSES];
+    NUMBER /= EXPLORER_TIME_CLASSES;
+    INPUT->Postive_State = (SwitchState_t)(NUMBER % 4);
+    NUMBER /= 4;
+    INPUT->Negative_State = (SwitchState_t)(NUMBER % 4);
+    INPUT->P_State = (SwitchState_t)(NUMBER / 4);
+}
+
+
+/** @brief Explore every Input after a prefix
+ * @param EX Explorer_t* Exploration
+ * @param CTL const SpeedController_t* Controller after the prefix
+ * @param SPEED unsigned char Reference Speed after the prefix
+ * @param PREV int Last Speed transition of the prefix or -1 if prefix is empty
+ * @param LEVEL unsigned int Prefix length
+ * @return bool true if all sequences match & false if not
+ */
+static bool Explorer_Visit(Explorer_t* EX, const SpeedController_t* CTL, unsigned char SPEED, int PREV, unsigned int LEVEL){
+    ExplorerReport_t* Report = EX->Report;
+    SpeedController_t Ctl;
+    unsigned char Next;
+    unsigned int Input;
+    int Transition;
+
+    for(Input = 0; Input < EXPLORER_INPUTS; Input++){
+        Ctl = *CTL;
+        EX->Step(&Ctl, &EX->Inputs[Input]);
+        Next = EX->Next[SPEED][Input];
+        EX->Path[LEVEL] = Input;
+        Report->Steps++;
+
+        if(SpeedCtl_Angle(&Ctl) != RefModel_Angle(Next)){
+            Report->Failed = true;
+            Report->Length = LEVEL + 1;
+            Report->Expected = RefModel_Angle(Next);
+            Report->Actual = SpeedCtl_Angle(&Ctl);
+            for(Input = 0; Input < Report->Length; Input++){
+                Report->Inputs[Input] = EX->Inputs[EX->Path[Input]];
+            }
+            return false;
+        }
+
+        Transition = SPEED * EXPLORER_SPEEDS + Next;
+        EX->Reached[Transition] = true;
+        if(PREV >= 0){
+            EX->ReachedPairs[PREV][Transition] = true;
+        }
+
+        if(LEVEL + 1 < EX->Depth){
+            if(!Explorer_Visit(EX, &Ctl, Next, Transition, LEVEL + 1)){
+                return false;
+            }
+        }else{
+            Report->Sequences++;
+        }
+    }
+    return true;
+}
+
+
+bool Explorer_Run(ExplorerStep_t STEP, unsigned int DEPTH, ExplorerReport_t* REPORT){
+    static Explorer_t EX;
+    SpeedController_t Ctl;
+    unsigned int Input, i, j;
+    unsigned char Speed;
+    bool Ok = true;
+
+    memset(REPORT, 0, sizeof(*REPORT));
+    if(DEPTH < 1 || DEPTH > EXPLORER_MAX_DEPTH){
+        return false;
+    }
+
+    memset(&EX, 0, sizeof(EX));
+    EX.Step = STEP;
+    EX.Report = REPORT;
+
+    /* Transition table of the Reference Model */
+    for(Input = 0; Input < EXPLORER_INPUTS; Input++){
+        Explorer_Input(Input, &EX.Inputs[Input]);
+        for(Speed = 0; Speed < EXPLORER_SPEEDS; Speed++){
+            EX.Next[Speed][Input] = RefModel_Step(Speed, &EX.Inputs[Input]);
+        }
+    }
+
+    /* Controller is moved to every Speed through Increase & Decrease only,
+       shorter sequences cost 1/384 of the longest so exploring them again is cheap */
+    for(EX.Depth = 1; EX.Depth <= DEPTH && Ok; EX.Depth++){
+        REPORT->Sequences = 0;
+        for(Speed = 0; Speed < EXPLORER_SPEEDS && Ok; Speed++){
+            SpeedCtl_Init(&Ctl);
+            SpeedCtl_Decrease(&Ctl);
+            for(i = 0; i < Speed; i++){
+                SpeedCtl_Increase(&Ctl);
+            }
+            REPORT->StartSpeed = Speed;
+            Ok = Explorer_Visit(&EX, &Ctl, Speed, -1, 0);
+        }
+    }
+
+    for(i = 0; i < EXPLORER_SPEEDS * EXPLORER_SPEEDS; i++){
+        REPORT->Transitions += EX.Reached[i];
+        for(j = 0; j < EXPLORER_SPEEDS * EXPLORER_SPEEDS; j++){
+            REPORT->TransitionPairs += EX.ReachedPairs[i][j];
+        }
+    }
+    return Ok;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file state_explorer.h
+ * @brief State Space Explorer header file
+ */
+
+#ifndef STATE_EXPLORER_H_INCLUDED
+#define STATE_EXPLORER_H_INCLUDED
+
+#include <stdbool.h>
+
+#include"../../source/speedcontrol/speedcontrol.h"
+
+/** @brief P Press Time classes: 0 & 29 (< 30), 30, 31 (> 30), 254 & 255 (near wrap) */
+#define EXPLORER_TIME_CLASSES       6
+
+/** @brief Inputs of one Speed Update: 4 x 4 x 4 Switches States times Press Time classes */
+#define EXPLORER_INPUTS             (4 * 4 * 4 * EXPLORER_TIME_CLASSES)
+
+/** @brief Number of Speeds */
+#define EXPLORER_SPEEDS             3
+
+/** @brief Longest Input sequence explored */
+#define EXPLORER_MAX_DEPTH          8
+
+/** @brief Speed Update under test, SpeedCtl_Update() or a replacement, its return is not used */
+typedef unsigned int (*ExplorerStep_t)(SpeedController_t* CTL, const SpeedInput_t* INPUT);
+
+/** @brief What the Explorer checked and the first Input sequence that failed */
+typedef struct {
+    unsigned long long Steps;
+    unsigned long long Sequences;
+    unsigned int Transitions;
+    unsigned int TransitionPairs;
+    bool Failed;
+    unsigned char StartSpeed;
+    unsigned int Length;
+    SpeedInput_t Inputs[EXPLORER_MAX_DEPTH];
+    short Expected;
+    short Actual;
+} ExplorerReport_t;
+
+
+/** @brief Get Input of an Input number
+ * @param NUMBER unsigned int Input number from 0 to EXPLORER_INPUTS - 1
+ * @param INPUT SpeedInput_t* Switches States & P Press Time
+ * @return void
+ */
+void Explorer_Input(unsigned int NUMBER, SpeedInput_t* INPUT);
+
+
+/** @brief Run every Input sequence of length 1 to DEPTH from every Speed and compare
+ * Motor Angle after every Speed Update with the Reference Model. <br>
+ * Reference Model is run once per Speed & Input into a transition table, so every explored
+ * Input costs one Speed Update under test and one table lookup
+ * @param STEP ExplorerStep_t Speed Update under test
+ * @param DEPTH unsigned int Longest Input sequence, from 1 to EXPLORER_MAX_DEPTH
+ * @param REPORT ExplorerReport_t* Counts, reached Speed transitions & a shortest failed sequence
+ * @return bool true if all sequences match the Reference Model & false if not
+ */
+bool Explorer_Run(ExplorerStep_t STEP, unsigned int DEPTH, ExplorerReport_t* REPORT);
+
+#endif // STATE_EXPLORER_H_INCLUDED
@@ -0,0 +1,193 @@
+/**
+ * @file switch_test.c
+ * @brief Testing Switch Debounce
+ * @details Here we apply Unit Test using Unity Test-Harness on Update_Switch(): Switch levels read through the
+ * Get_SWLevel seam move States with debounce, edges are stamped & recorded and P Press Time counts seconds
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../fake_switch/fake_switch.h"
+#include "../../source/event_ring/event_ring.h"
+#include "../../source/switches/switch.h"
+
+/** @brief Define (SWITCH) test group */
+TEST_GROUP(SWITCH);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(SWITCH){
+    SW_Init(POSTIVE);
+    SW_Init(NEGATIVE);
+    SW_Init(P);
+    FakeSW_Destroy();
+    EventRing_Reset();
+    UT_PTR_SET(Get_SWLevel, Get_FakeSW_Level);
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(SWITCH){
+    FakeSW_Destroy();
+    EventRing_Reset();
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Set a Switch level and run one tick of it
+ * @param SW Switch_t Which Switch
+ * @param PUSHED bool Level of the tick
+ * @return SwitchState_t State after the tick
+ */
+static SwitchState_t Tick(Switch_t SW, bool PUSHED){
+    Set_FakeSW_Level(SW, PUSHED);
+    Update_Switch(SW);
+    return Get_RealSW_State(SW);
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> A Switch is PRESSED & RELEASED only after two ticks at the same level **/
+TEST(SWITCH, TwoTicksDebounce){
+    /*!
+		  * @par Given : +ve Switch RELEASED
+		  * @par When  : It is pushed for 3 ticks then not pushed for 2 ticks
+		  * @par Then  : States are PRE_PRESSED, PRESSED, PRESSED, PRE_RELEASED, RELEASED
+	*/
+
+    /* Act & Assert */
+    LONGS_EQUAL(PREPRESSED, Tick(POSTIVE, true));
+    LONGS_EQUAL(PRESSED, Tick(POSTIVE, true));
+    LONGS_EQUAL(PRESSED, Tick(POSTIVE, true));
+    LONGS_EQUAL(PRERELEASED, Tick(POSTIVE, false));
+    LONGS_EQUAL(RELEASED, Tick(POSTIVE, false));
+}
+
+
+/** <b> Test Description : </b> A one tick glitch never makes a Switch PRESSED or RELEASED **/
+TEST(SWITCH, GlitchIsFiltered){
+    /*!
+		  * @par Given : -ve Switch RELEASED
+		  * @par When  : It is pushed for one tick, then released, then pushed until PRESSED & released for one tick
+		  * @par Then  : The first glitch goes back to RELEASED, the second one goes back to PRE_PRESSED, not RELEASED
+	*/
+
+    /* Act & Assert */
+    LONGS_EQUAL(PREPRESSED, Tick(NEGATIVE, true));
+    LONGS_EQUAL(PRERELEASED, Tick(NEGATIVE, false));
+    LONGS_EQUAL(RELEASED, Tick(NEGATIVE, false));
+
+    LONGS_EQUAL(PREPRESSED, Tick(NEGATIVE, true));
+    LONGS_EQUAL(PRESSED, Tick(NEGATIVE, true));
+    LONGS_EQUAL(PRERELEASED, Tick(NEGATIVE, false));
+    LONGS_EQUAL(PREPRESSED, Tick(NEGATIVE, true));
+}
+
+
+/** <b> Test Description : </b> Levels are read only through Get_SWLevel and Switches are independent **/
+TEST(SWITCH, LevelSeam){
+    /*!
+		  * @par Given : All Switches RELEASED, only P pushed
+		  * @par When  : All Switches are updated 2 ticks, then Get_SWLevel is set back to the real pins by SW_Init()
+		  * @par Then  : Only P is PRESSED, with real pins (never pushed on PC) P goes RELEASED
+	*/
+
+    /* Act */
+    Set_FakeSW_Level(P, true);
+    Update_Switch(P);
+    Update_Switch(POSTIVE);
+    Update_Switch(NEGATIVE);
+    Update_Switch(P);
+    Update_Switch(POSTIVE);
+    Update_Switch(NEGATIVE);
+
+    /* Assert */
+    LONGS_EQUAL(PRESSED, Get_RealSW_State(P));
+    LONGS_EQUAL(RELEASED, Get_RealSW_State(POSTIVE));
+    LONGS_EQUAL(RELEASED, Get_RealSW_State(NEGATIVE));
+
+    SW_Init(POSTIVE);
+    CHECK(Get_SWLevel == Get_RealSW_Level);
+    Update_Switch(P);
+    Update_Switch(P);
+    LONGS_EQUAL(RELEASED, Get_RealSW_State(P));
+}
+
+
+/** <b> Test Description : </b> P Press Time counts whole seconds of SW_TICK_MS ticks and starts again on a press **/
+TEST(SWITCH, PressTimeCountsSeconds){
+    /*!
+		  * @par Given : P Switch RELEASED
+		  * @par When  : P is pushed 1 + 3 seconds of ticks, released & pushed again
+		  * @par Then  : Press Time is 2 one tick before the 3rd second, 3 at it & 0 on the new press
+	*/
+    unsigned int i;
+
+    /* Act & Assert */
+    LONGS_EQUAL(PREPRESSED, Tick(P, true));
+    for(i = 1; i < 3 * SW_TICKS_PER_SECOND; i++){
+        LONGS_EQUAL(PRESSED, Tick(P, true));
+    }
+    LONGS_EQUAL(2, Get_RealSW_PressTime());
+    Tick(P, true);
+    LONGS_EQUAL(3, Get_RealSW_PressTime());
+
+    Tick(P, false);
+    LONGS_EQUAL(3, Get_RealSW_PressTime());
+    LONGS_EQUAL(PREPRESSED, Tick(P, true));
+    LONGS_EQUAL(0, Get_RealSW_PressTime());
+}
+
+
+/** <b> Test Description : </b> Edges are stamped and every State change is recorded in the Event Ring **/
+TEST(SWITCH, EdgesAreStampedAndRecorded){
+    /*!
+		  * @par Given : +ve Switch RELEASED & Event Ring time set to 1000
+		  * @par When  : It is pushed for 3 ticks (2 State changes), then time is 2000 and it is released for 2 ticks
+		  * @par Then  : Edge time is read while the push is seen & the Ring has 4 Switch Records with the new States
+	*/
+    static const SwitchState_t STATES[] = {PREPRESSED, PRESSED, PRERELEASED, RELEASED};
+    EventRecord_t Records[8];
+    uint32_t Cursor = 0;
+    uint64_t Before, After;
+    unsigned int Count, i;
+
+    /* Act */
+    EventRing_SetTime(1000);
+    Before = EventRing_Now();
+    Tick(POSTIVE, true);
+    After = EventRing_Now();
+    Tick(POSTIVE, true);
+    Tick(POSTIVE, true);
+    EventRing_SetTime(2000);
+    Tick(POSTIVE, false);
+    Tick(POSTIVE, false);
+    Count = EventRing_ReadFrom(&Cursor, Records, 8);
+
+    /* Assert */
+    CHECK(Get_SWEdgeTime(POSTIVE) >= Before && Get_SWEdgeTime(POSTIVE) <= After);
+    LONGS_EQUAL(4, Count);
+    for(i = 0; i < Count; i++){
+        LONGS_EQUAL(EVENT_SWITCH_STATE, Records[i].Id);
+        LONGS_EQUAL(POSTIVE, Records[i].Arg);
+        LONGS_EQUAL(STATES[i], Records[i].Payload & 0xFF);
+        CHECK(Records[i].Time == (i < 2 ? 1000 : 2000));
+    }
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(SWITCH){
+    RUN_TEST_CASE(SWITCH, TwoTicksDebounce);
+    RUN_TEST_CASE(SWITCH, GlitchIsFiltered);
+    RUN_TEST_CASE(SWITCH, LevelSeam);
+    RUN_TEST_CASE(SWITCH, PressTimeCountsSeconds);
+    RUN_TEST_CASE(SWITCH, EdgesAreStampedAndRecorded);
+}
@@ -0,0 +1,217 @@
+/**
+ * @file telemetry_test.c
+ * @brief Testing Telemetry
+ * @details Here we apply Unit Test using Unity Test-Harness on Telemetry shared memory Counters and their seqlock
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../fake_switch/fake_switch.h"
+#include "../../source/telemetry/telemetry.h"
+#include "../../source/speedcontrol/speedcontrol.h"
+#include "../../source/switches/switch.h"
+
+/** @brief Counters published by the writer thread */
+#define PUBLISHES       200000
+
+/** @brief Segment name of this test process */
+static char NAME[64];
+
+/** @brief Controller side & monitor side of the Segment */
+static Telemetry_t WRITER;
+static Telemetry_t READER;
+
+/** @brief Define (TELEM) test group */
+TEST_GROUP(TELEM);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(TELEM){
+    snprintf(NAME, sizeof(NAME), "/speedcontrol_test_%ld", (long)getpid());
+    memset(&WRITER, 0, sizeof(WRITER));
+    memset(&READER, 0, sizeof(READER));
+    SW_Init(POSTIVE);
+    SW_Init(NEGATIVE);
+    SW_Init(P);
+    Speed_Init();
+    FakeSW_Destroy();
+    UT_PTR_SET(Get_SWLevel, Get_FakeSW_Level);
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(TELEM){
+    Telemetry_Close(&READER);
+    Telemetry_Close(&WRITER);
+    Telemetry_Remove(NAME);
+    FakeSW_Destroy();
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Counters with every field set to one value
+ * @param VALUE uint64_t Value
+ * @param COUNTERS TelemetryCounters_t* Counters
+ * @return void
+ */
+static void Fill_Counters(uint64_t VALUE, TelemetryCounters_t* COUNTERS){
+    COUNTERS->Ticks = VALUE;
+    COUNTERS->Overruns = VALUE;
+    COUNTERS->Transitions = VALUE;
+    COUNTERS->Presses[0] = VALUE;
+    COUNTERS->Presses[1] = VALUE;
+    COUNTERS->Presses[2] = VALUE;
+    COUNTERS->LastEdgeLatencyNs = VALUE;
+    COUNTERS->Speed = (uint32_t)VALUE;
+    COUNTERS->Angle = (uint32_t)VALUE;
+}
+
+
+/** @brief Writer thread, publishes 1 to PUBLISHES in every field of Controller 1
+ * @param ARG void* Not used
+ * @return void* NULL
+ */
+static void* Publish_Thread(void* ARG){
+    TelemetryCounters_t Counters;
+    uint64_t i;
+    (void)ARG;
+
+    for(i = 1; i <= PUBLISHES; i++){
+        Fill_Counters(i, &Counters);
+        Telemetry_Publish(&WRITER, 1, &Counters);
+    }
+    return NULL;
+}
+
+
+/** @brief One Control Loop tick of +ve Switch
+ * @param PUSHED bool Level of +ve Switch
+ * @return void
+ */
+static void Tick_Postive(bool PUSHED){
+    Set_FakeSW_Level(POSTIVE, PUSHED);
+    Update_Switch(POSTIVE);
+    Speed_Update();
+    MotAngle_Write();
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> Another process reads published Counters **/
+TEST(TELEM, PublishedCountersAreRead){
+    /*!
+		  * @par Given : Segment of 2 Controllers created and attached
+		  * @par When  : Counters of Controller 1 are published
+		  * @par Then  : Reader sees them, Controller 0 is still 0 and Controller 2 doesn't exist
+	*/
+    TelemetryCounters_t Published, Read;
+
+    /* Arrange */
+    CHECK(Telemetry_Create(&WRITER, NAME, 2));
+    CHECK(Telemetry_Attach(&READER, NAME));
+    Fill_Counters(7, &Published);
+
+    /* Act */
+    Telemetry_Publish(&WRITER, 1, &Published);
+
+    /* Assert */
+    LONGS_EQUAL(2, Telemetry_Controllers(&READER));
+    CHECK(Telemetry_Read(&READER, 1, &Read));
+    CHECK(memcmp(&Published, &Read, sizeof(Read)) == 0);
+    CHECK(Telemetry_Read(&READER, 0, &Read));
+    LONGS_EQUAL(0, Read.Ticks);
+    CHECK(!Telemetry_Read(&READER, 2, &Read));
+}
+
+
+/** <b> Test Description : </b> Missing Segment can't be attached **/
+TEST(TELEM, MissingSegmentIsRefused){
+    /*!
+		  * @par Given : No Segment
+		  * @par When  : Telemetry_Attach() is called
+		  * @par Then  : It fails
+	*/
+    CHECK(!Telemetry_Attach(&READER, NAME));
+    CHECK(!Telemetry_Create(&WRITER, NAME, 0));
+}
+
+
+/** <b> Test Description : </b> Reader never sees half published Counters **/
+TEST(TELEM, ReaderNeverSeesTornCounters){
+    /*!
+		  * @par Given : Writer thread publishing the same value in every field, 200,000 times
+		  * @par When  : Reader reads at the same time
+		  * @par Then  : Every read Snapshot has one value in every field, and values never go back
+	*/
+    TelemetryCounters_t Read, Expected;
+    pthread_t Writer;
+    uint64_t Last = 0;
+    bool Consistent = true;
+
+    /* Arrange */
+    CHECK(Telemetry_Create(&WRITER, NAME, 2));
+    CHECK(Telemetry_Attach(&READER, NAME));
+
+    /* Act */
+    CHECK(pthread_create(&Writer, NULL, Publish_Thread, NULL) == 0);
+    while(Last != PUBLISHES && Consistent){
+        if(Telemetry_Read(&READER, 1, &Read)){
+            Fill_Counters(Read.Ticks, &Expected);
+            Consistent = memcmp(&Expected, &Read, sizeof(Read)) == 0 && Read.Ticks >= Last;
+            Last = Read.Ticks;
+        }
+    }
+    pthread_join(Writer, NULL);
+
+    /* Assert */
+    CHECK(Consistent);
+}
+
+
+/** <b> Test Description : </b> Counters are collected from the Control Loop Events **/
+TEST(TELEM, ControlLoopIsCounted){
+    /*!
+		  * @par Given : Created Segment and Motor at MED Speed
+		  * @par When  : +ve is pushed for 2 ticks and Telemetry is updated
+		  * @par Then  : One press, one transition, MAX Speed, 10 degrees and the edge latency are published
+	*/
+    TelemetryCounters_t Before, After;
+
+    /* Arrange */
+    CHECK(Telemetry_Create(&WRITER, NAME, 1));
+    CHECK(Telemetry_Attach(&READER, NAME));
+    Tick_Postive(false);
+    Telemetry_Update(&WRITER);
+    CHECK(Telemetry_Read(&READER, 0, &Before));
+
+    /* Act */
+    Tick_Postive(true);
+    Tick_Postive(true);
+    Telemetry_Update(&WRITER);
+
+    /* Assert */
+    CHECK(Telemetry_Read(&READER, 0, &After));
+    LONGS_EQUAL(1, After.Presses[POSTIVE] - Before.Presses[POSTIVE]);
+    LONGS_EQUAL(1, After.Transitions - Before.Transitions);
+    LONGS_EQUAL(MAX, After.Speed);
+    LONGS_EQUAL(10, After.Angle);
+    CHECK(After.LastEdgeLatencyNs > 0);
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(TELEM){
+    RUN_TEST_CASE(TELEM, PublishedCountersAreRead);
+    RUN_TEST_CASE(TELEM, MissingSegmentIsRefused);
+    RUN_TEST_CASE(TELEM, ReaderNeverSeesTornCounters);
+    RUN_TEST_CASE(TELEM, ControlLoopIsCounted);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_main.c
+ * @author Omar Hesham
+ * @brief The Tests main file
+ * @details Here we call unity test harness to do all tests, the Controller itself is in source/main.c <br>
+ * Run with -j JOBS to run every Test Group in its own process, JOBS at the same time (0 for all CPUs),
+ * and with -t FILE to write wall & CPU time of every test to FILE. Other options go to Unity, -g GROUP & -n NAME
+ * select tests with or without -j
+ *
+ */
+
+/*    Include Standard Libraries of input-output stream    */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*    Include Unity    */
+#include "unity/unity_fixture.h"
+#include "parallel_runner/parallel_runner.h"
+#define MAKE_UNITY_VERBOSE	UnityArgv[UnityArgc++] = "-v"
+
+/*    Declare Test Groups    */
+RUNNER_DECLARE_GROUP(SET);
+RUNNER_DECLARE_GROUP(INIT);
+RUNNER_DECLARE_GROUP(UPDATE);
+RUNNER_DECLARE_GROUP(TRACE);
+RUNNER_DECLARE_GROUP(REPLAY);
+RUNNER_DECLARE_GROUP(EXPLORER);
+RUNNER_DECLARE_GROUP(ALLOC);
+RUNNER_DECLARE_GROUP(EVENT);
+RUNNER_DECLARE_GROUP(SCHED);
+RUNNER_DECLARE_GROUP(CHROME);
+RUNNER_DECLARE_GROUP(TELEM);
+RUNNER_DECLARE_GROUP(LATENCY);
+RUNNER_DECLARE_GROUP(PERSIST);
+RUNNER_DECLARE_GROUP(JOURNAL);
+RUNNER_DECLARE_GROUP(COMMAND);
+RUNNER_DECLARE_GROUP(GATEWAY);
+RUNNER_DECLARE_GROUP(PROFILE);
+RUNNER_DECLARE_GROUP(RUNNER);
+RUNNER_DECLARE_GROUP(SWITCH);
+
+/** @brief All Test Groups in running order */
+static const RunnerGroup_t TEST_GROUPS[] = {
+    RUNNER_GROUP(SET),
+    RUNNER_GROUP(INIT),
+    RUNNER_GROUP(UPDATE),
+    RUNNER_GROUP(TRACE),
+    RUNNER_GROUP(REPLAY),
+    RUNNER_GROUP(EXPLORER),
+    RUNNER_GROUP(ALLOC),
+    RUNNER_GROUP(EVENT),
+    RUNNER_GROUP(SCHED),
+    RUNNER_GROUP(CHROME),
+    RUNNER_GROUP(TELEM),
+    RUNNER_GROUP(LATENCY),
+    RUNNER_GROUP(PERSIST),
+    RUNNER_GROUP(JOURNAL),
+    RUNNER_GROUP(COMMAND),
+    RUNNER_GROUP(GATEWAY),
+    RUNNER_GROUP(PROFILE),
+    RUNNER_GROUP(RUNNER),
+    RUNNER_GROUP(SWITCH),
+};
+
+#define TEST_GROUPS_COUNT   (sizeof(TEST_GROUPS) / sizeof(TEST_GROUPS[0]))
+
+/** @brief Test Groups Runner */
+static void RunAllTests(void){
+    unsigned int i;
+
+    for(i = 0; i < TEST_GROUPS_COUNT; i++){
+        TEST_GROUPS[i].Run();
+    }
+}
+
+/** @brief main function run all Test Groups
+ *
+ * @param argc int
+ * @param argv[] char*
+ * @return int Number of failed tests
+ */
+int main(int argc, char * argv[])
+{
+    const char** UnityArgv;
+    int UnityArgc = 1;
+    int Jobs = -1;
+    int Arg, Result;
+
+    /* Every argument but -j JOBS is given to Unity, plus -v */
+    UnityArgv = malloc(((size_t)argc + 1) * sizeof(UnityArgv[0]));
+    if(UnityArgv == NULL){
+        return 1;
+    }
+    UnityArgv[0] = argv[0];
+
+    for(Arg = 1; Arg < argc; Arg++){
+        if(strcmp(argv[Arg], "-j") == 0 && Arg + 1 < argc){
+            Jobs = atoi(argv[++Arg]);
+        }else{
+            UnityArgv[UnityArgc++] = argv[Arg];
+        }
+    }
+
+    /*    Make Unity verbose rather than using Command Line    */
+    MAKE_UNITY_VERBOSE;
+
+    /*    Call Unity Main, or Parallel Runner with the same options    */
+    if(Jobs < 0){
+        Result = UnityMain(UnityArgc, UnityArgv, RunAllTests);
+    }else if(UnityGetCommandLineOptions(UnityArgc, UnityArgv) != 0){
+        Result = 1;
+    }else{
+        Result = Runner_Parallel(argv[0], TEST_GROUPS, TEST_GROUPS_COUNT, (unsigned int)Jobs);
+    }
+    free(UnityArgv);
+    return Result;
+}
@@ -0,0 +1,31 @@
+/**
+ * @file trace_format.h
+ * @brief Binary Trace Format definitions
+ * @details Binary Trace is a Header then one Record per Test Line: <br>
+ * Header : "SWTB" | version (1 byte) | switch count (1 byte) | 2 reserved bytes <br>
+ * Record : 1 byte, bits 0-1 +ve State, bits 2-3 -ve State, bits 4-5 P State,
+ * bit 7 set if P Press Time changed then the change follows as zigzag varint <br>
+ * End of Test Case : 1 byte equal to TRACE_BIN_END_OF_CASE, it resets Press Time to 0
+ */
+
+#ifndef TRACE_FORMAT_H_INCLUDED
+#define TRACE_FORMAT_H_INCLUDED
+
+/** @brief A variable can assign the supported Trace Formats */
+typedef enum {TRACE_TEXT, TRACE_BINARY} TraceFormat_t;
+
+/** @brief Binary Trace Header */
+#define TRACE_BIN_MAGIC             "SWTB"
+#define TRACE_BIN_MAGIC_SIZE        4
+#define TRACE_BIN_VERSION           1
+#define TRACE_BIN_SWITCHES          3
+#define TRACE_BIN_HEADER_SIZE       8
+
+/** @brief Binary Trace Record bits */
+#define TRACE_BIN_STATE_BITS        2
+#define TRACE_BIN_STATE_MASK        0x03
+#define TRACE_BIN_STATES_MASK       0x3F
+#define TRACE_BIN_END_OF_CASE       0x40
+#define TRACE_BIN_TIME_CHANGED      0x80
+
+#endif // TRACE_FORMAT_H_INCLUDED
@@ -0,0 +1,304 @@
+/**
+ * @file trace_index.c
+ * @brief Trace Index main file
+ * @details Here we find where every Test Case starts in a Trace once and keep it in a Sidecar File
+ * (switch.txt.idx), so any Test Case is reached by one seek instead of reading all Test Cases before it
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+ /*    Include Header    */
+#include"trace_index.h"
+
+/** @brief Sidecar Header, Index is valid only for the same Trace size, mtime & checksum of its edges */
+typedef struct {
+    char Magic[4];
+    uint32_t Version;
+    uint64_t TraceSize;
+    int64_t TraceMtime;
+    uint64_t EdgeChecksum;
+    uint64_t Count;
+} TraceIndexHeader_t;
+
+/** @brief Trace key kept in the Sidecar Header */
+typedef struct {
+    uint64_t Size;
+    int64_t Mtime;
+    uint64_t EdgeChecksum;
+} TraceIndexKey_t;
+
+/** @brief Sidecar Entry for one Test Case */
+typedef struct {
+    uint64_t Offset;
+    uint64_t Lines;
+} TraceIndexEntry_t;
+
+#define TRACE_INDEX_MAGIC       "SWTI"
+#define TRACE_INDEX_VERSION     3
+
+/** @brief Bytes checked at the start & at the end of the Trace */
+#define TRACE_INDEX_EDGE        4096
+
+
+/** @brief FNV-1a over some bytes
+ * @param HASH uint64_t Hash so far
+ * @param DATA const unsigned char* Bytes
+ * @param SIZE size_t Number of bytes
+ * @return uint64_t Hash
+ */
+static uint64_t TraceIndex_Hash(uint64_t HASH, const unsigned char* DATA, size_t SIZE){
+    size_t i;
+
+    for(i = 0; i < SIZE; i++){
+        HASH = (HASH ^ DATA[i]) * 0x100000001B3u;
+    }
+    return HASH;
+}
+
+
+/** @brief Key of the Trace: size, mtime (ns where stat has it) & checksum of its first & last TRACE_INDEX_EDGE bytes.
+ * mtime misses two edits of the same size in one clock tick, the edges catch the ones changing the Trace header
+ * or the Test Cases written last. Only the edges are read so a big Trace is never read whole to load its Index
+ * @param INFO const struct stat* Trace File info
+ * @param READER const TraceReader_t* Opened Reader
+ * @return TraceIndexKey_t Key
+ */
+static TraceIndexKey_t TraceIndex_Key(const struct stat* INFO, const TraceReader_t* READER){
+    const unsigned char* Data = (const unsigned char*)READER->Data;
+    TraceIndexKey_t Key;
+    size_t Head = (READER->Size < TRACE_INDEX_EDGE) ? READER->Size : TRACE_INDEX_EDGE;
+    size_t Tail = (READER->Size - Head < TRACE_INDEX_EDGE) ? READER->Size - Head : TRACE_INDEX_EDGE;
+
+    Key.Size = (uint64_t)READER->Size;
+#ifdef __linux__
+    Key.Mtime = (int64_t)INFO->st_mtim.tv_sec * 1000000000 + INFO->st_mtim.tv_nsec;
+#else
+    Key.Mtime = (int64_t)INFO->st_mtime;
+#endif
+    Key.EdgeChecksum = TraceIndex_Hash(0xCBF29CE484222325u, Data, Head);
+    Key.EdgeChecksum = TraceIndex_Hash(Key.EdgeChecksum, Data + READER->Size - Tail, Tail);
+    return Key;
+}
+
+
+/** @brief Add Test Case to Index
+ * @param INDEX TraceIndex_t* Index to grow
+ * @param Capacity unsigned long* Number of Test Cases Index can hold now
+ * @param OFFSET size_t First Test Line Offset
+ * @param LINES unsigned long Number of Test Lines
+ * @return bool true if Test Case is added & false if no memory
+ */
+static bool TraceIndex_Add(TraceIndex_t* INDEX, unsigned long* Capacity, size_t OFFSET, unsigned long LINES){
+    TraceCase_t* Cases;
+
+    if(INDEX->Count == *Capacity){
+        *Capacity = (*Capacity == 0) ? 64 : *Capacity * 2;
+        Cases = realloc(INDEX->Cases, *Capacity * sizeof(TraceCase_t));
+        if(!Cases){
+            return false;
+        }
+        INDEX->Cases = Cases;
+    }
+    INDEX->Cases[INDEX->Count].Offset = OFFSET;
+    INDEX->Cases[INDEX->Count].Lines = LINES;
+    INDEX->Count++;
+    return true;
+}
+
+
+bool TraceIndex_Build(TraceIndex_t* INDEX, TraceReader_t* READER){
+    TraceLine_t Line;
+    TraceStatus_t Status;
+    unsigned long Capacity = 0, Lines = 0;
+    size_t Start, CaseStart = 0;
+    bool Ok = true;
+
+    INDEX->Cases = NULL;
+    INDEX->Count = 0;
+    Trace_Rewind(READER);
+
+    do{
+        Start = READER->Pos;
+        Status = Trace_ReadLine(READER, &Line);
+
+        switch(Status){
+        case TRACE_DATA:
+        case TRACE_INCORRECT:
+            if(Lines == 0){
+                CaseStart = Start;
+            }
+            Lines++;
+            break;
+
+        /* Every (-) Line ends a Test Case even if it has no Test Lines */
+        case TRACE_END_OF_CASE:
+            Ok = TraceIndex_Add(INDEX, &Capacity, (Lines == 0) ? Start : CaseStart, Lines);
+            Lines = 0;
+            break;
+
+        /* Last Test Case may miss its (-) Line */
+        default:
+            if(Lines != 0){
+                Ok = TraceIndex_Add(INDEX, &Capacity, CaseStart, Lines);
+            }
+            break;
+        }
+    }while(Ok && Status != TRACE_END_OF_FILE);
+
+    Trace_Rewind(READER);
+    if(!Ok){
+        TraceIndex_Free(INDEX);
+    }
+    return Ok;
+}
+
+
+/** @brief Read Sidecar Index if it belongs to this Trace
+ * @param INDEX TraceIndex_t* Index to fill
+ * @param SIDECAR const char* Sidecar File path
+ * @param KEY const TraceIndexKey_t* Trace key
+ * @return bool true if Index is read & false if Sidecar is missing or stale
+ */
+static bool TraceIndex_Read(TraceIndex_t* INDEX, const char* SIDECAR, const TraceIndexKey_t* KEY){
+    TraceIndexHeader_t Header;
+    TraceIndexEntry_t Entry;
+    unsigned long i;
+    FILE* File = fopen(SIDECAR, "rb");
+
+    if(!File){
+        return false;
+    }
+
+    if(fread(&Header, sizeof(Header), 1, File) != 1 ||
+       memcmp(Header.Magic, TRACE_INDEX_MAGIC, sizeof(Header.Magic)) != 0 ||
+       Header.Version != TRACE_INDEX_VERSION ||
+       Header.TraceSize != KEY->Size ||
+       Header.TraceMtime != KEY->Mtime ||
+       Header.EdgeChecksum != KEY->EdgeChecksum ||
+       Header.Count > KEY->Size + 1){
+        fclose(File);
+        return false;
+    }
+
+    INDEX->Count = (unsigned long)Header.Count;
+    INDEX->Cases = malloc((INDEX->Count ? INDEX->Count : 1) * sizeof(TraceCase_t));
+    if(!INDEX->Cases){
+        fclose(File);
+        return false;
+    }
+
+    for(i = 0; i < INDEX->Count; i++){
+        if(fread(&Entry, sizeof(Entry), 1, File) != 1 || Entry.Offset > Header.TraceSize){
+            fclose(File);
+            TraceIndex_Free(INDEX);
+            return false;
+        }
+        INDEX->Cases[i].Offset = (size_t)Entry.Offset;
+        INDEX->Cases[i].Lines = (unsigned long)Entry.Lines;
+    }
+
+    fclose(File);
+    return true;
+}
+
+
+/** @brief Write Sidecar Index, it is written to a temporary File first
+ * so a reader never sees half of it
+ * @param INDEX const TraceIndex_t* Index to save
+ * @param SIDECAR const char* Sidecar File path
+ * @param KEY const TraceIndexKey_t* Trace key
+ * @return void
+ */
+static void TraceIndex_Write(const TraceIndex_t* INDEX, const char* SIDECAR, const TraceIndexKey_t* KEY){
+    TraceIndexHeader_t Header;
+    TraceIndexEntry_t Entry;
+    unsigned long i;
+    bool Ok;
+    char Temp[FILENAME_MAX];
+    FILE* File;
+
+    if(snprintf(Temp, sizeof(Temp), "%s.tmp", SIDECAR) >= (int)sizeof(Temp)){
+        return;
+    }
+    File = fopen(Temp, "wb");
+    if(!File){
+        return;
+    }
+
+    memset(&Header, 0, sizeof(Header));
+    memcpy(Header.Magic, TRACE_INDEX_MAGIC, sizeof(Header.Magic));
+    Header.Version = TRACE_INDEX_VERSION;
+    Header.TraceSize = KEY->Size;
+    Header.TraceMtime = KEY->Mtime;
+    Header.EdgeChecksum = KEY->EdgeChecksum;
+    Header.Count = INDEX->Count;
+
+    Ok = fwrite(&Header, sizeof(Header), 1, File) == 1;
+    for(i = 0; Ok && i < INDEX->Count; i++){
+        Entry.Offset = INDEX->Cases[i].Offset;
+        Entry.Lines = INDEX->Cases[i].Lines;
+        Ok = fwrite(&Entry, sizeof(Entry), 1, File) == 1;
+    }
+    Ok = (fclose(File) == 0) && Ok;
+
+    /* Sidecar is only a cache, if it can not be saved the Trace is indexed again next time */
+    if(Ok){
+#ifdef _WIN32
+        remove(SIDECAR);
+#endif
+        Ok = rename(Temp, SIDECAR) == 0;
+    }
+    if(!Ok){
+        remove(Temp);
+    }
+}
+
+
+bool TraceIndex_Load(TraceIndex_t* INDEX, const char* PATH, TraceReader_t* READER){
+    struct stat Info;
+    char Sidecar[FILENAME_MAX];
+    TraceIndexKey_t Key;
+
+    INDEX->Cases = NULL;
+    INDEX->Count = 0;
+
+    if(stat(PATH, &Info) != 0 || (size_t)Info.st_size != READER->Size ||
+       snprintf(Sidecar, sizeof(Sidecar), "%s" TRACE_INDEX_SUFFIX, PATH) >= (int)sizeof(Sidecar)){
+        return TraceIndex_Build(INDEX, READER);
+    }
+
+    Key = TraceIndex_Key(&Info, READER);
+    if(TraceIndex_Read(INDEX, Sidecar, &Key)){
+        return true;
+    }
+
+    if(!TraceIndex_Build(INDEX, READER)){
+        return false;
+    }
+    TraceIndex_Write(INDEX, Sidecar, &Key);
+    return true;
+}
+
+
+bool TraceIndex_Seek(const TraceIndex_t* INDEX, TraceReader_t* READER, unsigned long CASE){
+    if(CASE >= INDEX->Count){
+        return false;
+    }
+
+    /* Binary Press Time starts from 0 in every Test Case */
+    READER->Pos = INDEX->Cases[CASE].Offset;
+    READER->LastPressTime = 0;
+    return true;
+}
+
+
+void TraceIndex_Free(TraceIndex_t* INDEX){
+    free(INDEX->Cases);
+    INDEX->Cases = NULL;
+    INDEX->Count = 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file trace_index.h
+ * @brief Trace Index header file
+ */
+
+#ifndef TRACE_INDEX_H_INCLUDED
+#define TRACE_INDEX_H_INCLUDED
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include"trace_reader.h"
+
+/** @brief Sidecar Index File is the Trace File path with this suffix */
+#define TRACE_INDEX_SUFFIX      ".idx"
+
+
+/** @brief Where one Test Case starts in the Trace and how many Test Lines it has */
+typedef struct {
+    size_t Offset;
+    unsigned long Lines;
+} TraceCase_t;
+
+
+/** @brief Test Cases boundaries of one Trace */
+typedef struct {
+    TraceCase_t* Cases;
+    unsigned long Count;
+} TraceIndex_t;
+
+
+/** @brief Load Sidecar Index of Trace File, if it is missing or the Trace changed
+ * (another size, mtime or checksum of its first & last bytes) the Index is built from the Trace and Sidecar is written again
+ * @param INDEX TraceIndex_t* Index to fill
+ * @param PATH const char* Trace File path
+ * @param READER TraceReader_t* Reader opened on the same Trace File
+ * @return bool true if Index is ready & false if not
+ */
+bool TraceIndex_Load(TraceIndex_t* INDEX, const char* PATH, TraceReader_t* READER);
+
+
+/** @brief Build Index by scanning all Trace Lines once, no Sidecar is used
+ * @param INDEX TraceIndex_t* Index to fill
+ * @param READER TraceReader_t* Opened Reader, it is rewound after building
+ * @return bool true if Index is built & false if not
+ */
+bool TraceIndex_Build(TraceIndex_t* INDEX, TraceReader_t* READER);
+
+
+/** @brief Move Reader to first Test Line of a Test Case
+ * @param INDEX const TraceIndex_t* Index of the Trace
+ * @param READER TraceReader_t* Reader opened on the same Trace
+ * @param CASE unsigned long Test Case number starting from 0
+ * @return bool true if Test Case exists & false if not
+ */
+bool TraceIndex_Seek(const TraceIndex_t* INDEX, TraceReader_t* READER, unsigned long CASE);
+
+
+/** @brief Release Index memory
+ * @param INDEX TraceIndex_t* Index to release
+ * @return void
+ */
+void TraceIndex_Free(TraceIndex_t* INDEX);
+
+#endif // TRACE_INDEX_H_INCLUDED
@@ -0,0 +1,313 @@
+/**
+ * @file trace_reader.c
+ * @brief Trace Reader main file
+ * @details Here we map switch.txt into memory and tokenize every Trace Line in place,
+ * so no Field is copied into a buffer before it is decoded. Binary Traces (trace_format.h)
+ * are decoded from the same mapping
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+ /*    Include Header    */
+#include"trace_reader.h"
+
+/** @brief Number of Fields in every Trace Line */
+#define TRACE_FIELDS    4
+
+/** @brief One Field of Trace Line, it points into the Trace bytes */
+typedef struct {
+    const char* Start;
+    size_t Len;
+} TraceToken_t;
+
+
+/** @brief Switch State Keywords, their lengths are all different so the length is a perfect hash:
+ * Keyword is found by its length then checked by one fixed size compare */
+typedef struct {
+    const char* Keyword;
+    SwitchState_t State;
+} TraceKeyword_t;
+
+static const TraceKeyword_t KEYWORDS[TRACE_KEYWORD_MAX_LEN + 1] = {
+    [7]  = {"PRESSED", PRESSED},
+    [8]  = {"RELEASED", RELEASED},
+    [11] = {"PRE_PRESSED", PREPRESSED},
+    [12] = {"PRE_RELEASED", PRERELEASED},
+};
+
+
+bool Trace_DecodeState(const char* TOKEN, size_t LEN, SwitchState_t* STATE){
+    const TraceKeyword_t* Entry;
+
+    if(LEN > TRACE_KEYWORD_MAX_LEN){
+        return false;
+    }
+    Entry = &KEYWORDS[LEN];
+    if(!Entry->Keyword || memcmp(TOKEN, Entry->Keyword, LEN) != 0){
+        return false;
+    }
+    *STATE = Entry->State;
+    return true;
+}
+
+
+/** @brief Decode Press Time Token, it must be a number from 0 to 255
+ * @param TOKEN const TraceToken_t* Token to decode
+ * @param TIME unsigned char* Decoded Press Time
+ * @return bool true if Token is a Press Time & false if not
+ */
+static bool Token_DecodeTime(const TraceToken_t* TOKEN, unsigned char* TIME){
+    unsigned int Value = 0;
+    size_t i;
+
+    if(TOKEN->Len == 0 || TOKEN->Len > 3){
+        return false;
+    }
+
+    for(i = 0; i < TOKEN->Len; i++){
+        if(TOKEN->Start[i] < '0' || TOKEN->Start[i] > '9'){
+            return false;
+        }
+        Value = Value * 10 + (unsigned int)(TOKEN->Start[i] - '0');
+    }
+
+    if(Value > 255){
+        return false;
+    }
+    *TIME = (unsigned char)Value;
+    return true;
+}
+
+
+bool Trace_Open(TraceReader_t* READER, const char* PATH){
+#ifdef _WIN32
+    /* No mmap here, so read the whole Trace once */
+    FILE* Data = fopen(PATH, "rb");
+    long Size;
+    char* Bytes;
+
+    if(!Data){
+        return false;
+    }
+    fseek(Data, 0, SEEK_END);
+    Size = ftell(Data);
+    fseek(Data, 0, SEEK_SET);
+
+    Bytes = malloc(Size > 0 ? (size_t)Size : 1);
+    if(!Bytes || fread(Bytes, 1, (size_t)Size, Data) != (size_t)Size){
+        free(Bytes);
+        fclose(Data);
+        return false;
+    }
+    fclose(Data);
+
+    if(!Trace_OpenMemory(READER, Bytes, (size_t)Size)){
+        free(Bytes);
+        return false;
+    }
+    READER->Mapped = true;
+    return true;
+#else
+    struct stat Info;
+    void* Bytes;
+    int Fd = open(PATH, O_RDONLY);
+
+    if(Fd < 0){
+        return false;
+    }
+    if(fstat(Fd, &Info) != 0){
+        close(Fd);
+        return false;
+    }
+
+    /* mmap refuses empty files, an empty Trace simply has no Lines */
+    if(Info.st_size == 0){
+        close(Fd);
+        Trace_OpenMemory(READER, "", 0);
+        return true;
+    }
+
+    Bytes = mmap(NULL, (size_t)Info.st_size, PROT_READ, MAP_PRIVATE, Fd, 0);
+    close(Fd);
+    if(Bytes == MAP_FAILED){
+        return false;
+    }
+    madvise(Bytes, (size_t)Info.st_size, MADV_SEQUENTIAL);
+
+    if(!Trace_OpenMemory(READER, Bytes, (size_t)Info.st_size)){
+        munmap(Bytes, (size_t)Info.st_size);
+        return false;
+    }
+    READER->Mapped = true;
+    return true;
+#endif
+}
+
+
+bool Trace_OpenMemory(TraceReader_t* READER, const void* DATA, size_t SIZE){
+    const unsigned char* Header = DATA;
+
+    READER->Data = DATA;
+    READER->Size = SIZE;
+    READER->Pos = 0;
+    READER->Mapped = false;
+    READER->Format = TRACE_TEXT;
+    READER->LastPressTime = 0;
+
+    if(SIZE >= TRACE_BIN_MAGIC_SIZE && memcmp(Header, TRACE_BIN_MAGIC, TRACE_BIN_MAGIC_SIZE) == 0){
+        if(SIZE < TRACE_BIN_HEADER_SIZE ||
+           Header[TRACE_BIN_MAGIC_SIZE] != TRACE_BIN_VERSION ||
+           Header[TRACE_BIN_MAGIC_SIZE + 1] != TRACE_BIN_SWITCHES){
+            return false;
+        }
+        READER->Format = TRACE_BINARY;
+        READER->Pos = TRACE_BIN_HEADER_SIZE;
+    }
+    return true;
+}
+
+
+/** @brief Read next Binary Record
+ * @param READER TraceReader_t* Opened Reader
+ * @param LINE TraceLine_t* Line Data, valid only if TRACE_DATA returned
+ * @return TraceStatus_t Same as Trace_ReadLine()
+ */
+static TraceStatus_t Trace_ReadRecord(TraceReader_t* READER, TraceLine_t* LINE){
+    const unsigned char* Bytes = (const unsigned char*)READER->Data;
+    unsigned char Record;
+    unsigned int ZigZag = 0, Shift = 0;
+    int Time;
+
+    if(READER->Pos >= READER->Size){
+        return TRACE_END_OF_FILE;
+    }
+    Record = Bytes[READER->Pos++];
+
+    if(Record == TRACE_BIN_END_OF_CASE){
+        READER->LastPressTime = 0;
+        return TRACE_END_OF_CASE;
+    }
+    if(Record & TRACE_BIN_END_OF_CASE){
+        return TRACE_INCORRECT;
+    }
+
+    LINE->Postive_State = (SwitchState_t)(Record & TRACE_BIN_STATE_MASK);
+    LINE->Negative_State = (SwitchState_t)((Record >> TRACE_BIN_STATE_BITS) & TRACE_BIN_STATE_MASK);
+    LINE->P_State = (SwitchState_t)((Record >> (2 * TRACE_BIN_STATE_BITS)) & TRACE_BIN_STATE_MASK);
+
+    if(Record & TRACE_BIN_TIME_CHANGED){
+        /* Press Time change is a zigzag varint, it never needs more than 2 bytes */
+        do{
+            if(READER->Pos >= READER->Size || Shift > 7){
+                READER->Pos = READER->Size;
+                return TRACE_INCORRECT;
+            }
+            ZigZag |= (unsigned int)(Bytes[READER->Pos] & 0x7F) << Shift;
+            Shift += 7;
+        }while(Bytes[READER->Pos++] & 0x80);
+
+        Time = READER->LastPressTime + ((ZigZag & 1) ? -(int)((ZigZag + 1) >> 1) : (int)(ZigZag >> 1));
+        if(Time < 0 || Time > 255){
+            return TRACE_INCORRECT;
+        }
+        READER->LastPressTime = (unsigned char)Time;
+    }
+    LINE->P_PressTime = READER->LastPressTime;
+
+    return TRACE_DATA;
+}
+
+
+TraceStatus_t Trace_ReadLine(TraceReader_t* READER, TraceLine_t* LINE){
+    TraceToken_t Tokens[TRACE_FIELDS];
+    size_t Count;
+    bool TooMany;
+    const char* p;
+    const char* End = READER->Data + READER->Size;
+
+    if(READER->Format == TRACE_BINARY){
+        return Trace_ReadRecord(READER, LINE);
+    }
+
+    do{
+        p = READER->Data + READER->Pos;
+        if(p >= End){
+            return TRACE_END_OF_FILE;
+        }
+
+        /* Split Line into Tokens, spaces, tabs & \r are separators */
+        Count = 0;
+        TooMany = false;
+        while(p < End && *p != '\n'){
+            if(*p == ' ' || *p == '\t' || *p == '\r'){
+                p++;
+                continue;
+            }
+            if(Count < TRACE_FIELDS){
+                Tokens[Count].Start = p;
+            }else{
+                TooMany = true;
+            }
+            while(p < End && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n'){
+                p++;
+            }
+            if(Count < TRACE_FIELDS){
+                Tokens[Count].Len = (size_t)(p - Tokens[Count].Start);
+                Count++;
+            }
+        }
+
+        /* Skip the new line too */
+        READER->Pos = (size_t)(p - READER->Data) + (p < End ? 1 : 0);
+
+    /* Empty Lines are not Test Lines */
+    }while(Count == 0);
+
+    if(Tokens[0].Len == 1 && Tokens[0].Start[0] == '-'){
+        return TRACE_END_OF_CASE;
+    }
+
+    if(Count != TRACE_FIELDS || TooMany){
+        return TRACE_INCORRECT;
+    }
+
+    if(!Trace_DecodeState(Tokens[0].Start, Tokens[0].Len, &LINE->Postive_State) ||
+       !Trace_DecodeState(Tokens[1].Start, Tokens[1].Len, &LINE->Negative_State) ||
+       !Trace_DecodeState(Tokens[2].Start, Tokens[2].Len, &LINE->P_State) ||
+       !Token_DecodeTime(&Tokens[3], &LINE->P_PressTime)){
+        return TRACE_INCORRECT;
+    }
+
+    return TRACE_DATA;
+}
+
+
+void Trace_Rewind(TraceReader_t* READER){
+    READER->Pos = (READER->Format == TRACE_BINARY) ? TRACE_BIN_HEADER_SIZE : 0;
+    READER->LastPressTime = 0;
+}
+
+
+void Trace_Close(TraceReader_t* READER){
+    if(READER->Mapped){
+#ifdef _WIN32
+        free((void*)READER->Data);
+#else
+        munmap((void*)READER->Data, READER->Size);
+#endif
+    }
+    READER->Data = NULL;
+    READER->Size = 0;
+    READER->Pos = 0;
+    READER->Mapped = false;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file trace_reader.h
+ * @brief Trace Reader header file
+ */
+
+#ifndef TRACE_READER_H_INCLUDED
+#define TRACE_READER_H_INCLUDED
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include"../../source/switches/switch.h"
+#include"trace_format.h"
+
+
+/** @brief Longest Switch State Keyword (PRE_RELEASED) */
+#define TRACE_KEYWORD_MAX_LEN   12
+
+
+/** @brief A variable can assign the Results of reading one Trace Line */
+typedef enum {TRACE_DATA, TRACE_INCORRECT, TRACE_END_OF_CASE, TRACE_END_OF_FILE} TraceStatus_t;
+
+
+/** @brief One Trace Line (Switches States & P Press Time) */
+typedef struct {
+    SwitchState_t Postive_State;
+    SwitchState_t Negative_State;
+    SwitchState_t P_State;
+    unsigned char P_PressTime;
+} TraceLine_t;
+
+
+/** @brief A Trace opened for reading, the Trace bytes are mapped not copied */
+typedef struct {
+    const char* Data;
+    size_t Size;
+    size_t Pos;
+    bool Mapped;
+    TraceFormat_t Format;
+    unsigned char LastPressTime;
+} TraceReader_t;
+
+
+/** @brief Open Trace File and map it into memory, Text or Binary Format is detected from its Header
+ * @param READER TraceReader_t* Reader to open
+ * @param PATH const char* Trace File path
+ * @return bool true if Trace File is opened & false if not
+ */
+bool Trace_Open(TraceReader_t* READER, const char* PATH);
+
+
+/** @brief Open Trace which is already in memory, the bytes must live until Trace_Close()
+ * @param READER TraceReader_t* Reader to open
+ * @param DATA const void* Trace bytes
+ * @param SIZE size_t Number of Trace bytes
+ * @return bool true if Trace is opened & false if Binary Header is not supported
+ */
+bool Trace_OpenMemory(TraceReader_t* READER, const void* DATA, size_t SIZE);
+
+
+/** @brief Read next Trace Line, tokens are parsed in place over the mapped bytes
+ * @param READER TraceReader_t* Opened Reader
+ * @param LINE TraceLine_t* Line Data, valid only if TRACE_DATA returned
+ * @return TraceStatus_t TRACE_DATA if Data is Correct, TRACE_END_OF_CASE at (-) Line,
+ * TRACE_INCORRECT if Data is incorrect & TRACE_END_OF_FILE if no more Lines
+ */
+TraceStatus_t Trace_ReadLine(TraceReader_t* READER, TraceLine_t* LINE);
+
+
+/** @brief Decode Switch State Keyword (PRE_PRESSED, PRESSED, PRE_RELEASED or RELEASED),
+ * every Text Trace reader uses it
+ * @param TOKEN const char* Keyword, it does not need to end with '\0'
+ * @param LEN size_t Keyword length
+ * @param STATE SwitchState_t* Decoded State
+ * @return bool true if Token is a Switch State & false if not
+ */
+bool Trace_DecodeState(const char* TOKEN, size_t LEN, SwitchState_t* STATE);
+
+
+/** @brief Start reading again from the first Trace Line
+ * @param READER TraceReader_t* Opened Reader
+ * @return void
+ */
+void Trace_Rewind(TraceReader_t* READER);
+
+
+/** @brief Unmap Trace File
+ * @param READER TraceReader_t* Reader to close
+ * @return void
+ */
+void Trace_Close(TraceReader_t* READER);
+
+#endif // TRACE_READER_H_INCLUDED
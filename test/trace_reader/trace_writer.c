@@ -0,0 +1,101 @@
+/**
+ * @file trace_writer.c
+ * @brief Trace Writer main file
+ * @details Here we write Test Lines in switch.txt Text Format or in the packed Binary Format
+ *
+ */
+
+#include <string.h>
+
+ /*    Include Header    */
+#include"trace_writer.h"
+
+/** @brief Switch State Names as written in switch.txt */
+static const char* const STATE_NAMES[] = {"PRE_PRESSED", "PRESSED", "PRE_RELEASED", "RELEASED"};
+
+
+/** @brief Write one switch.txt Column, short Names need one more tab to keep Columns aligned
+ * @param TRACE FILE* Trace File
+ * @param NAME const char* Column value
+ * @return bool true if Column is written & false if not
+ */
+static bool Write_Column(FILE* TRACE, const char* NAME){
+    return fprintf(TRACE, strlen(NAME) < 8 ? "%s\t\t\t" : "%s\t\t", NAME) > 0;
+}
+
+
+bool Trace_WriterOpen(TraceWriter_t* WRITER, const char* PATH, TraceFormat_t FORMAT){
+    static const unsigned char HEADER[TRACE_BIN_HEADER_SIZE] = {
+        'S', 'W', 'T', 'B', TRACE_BIN_VERSION, TRACE_BIN_SWITCHES, 0, 0
+    };
+
+    WRITER->Format = FORMAT;
+    WRITER->LastPressTime = 0;
+    WRITER->File = fopen(PATH, (FORMAT == TRACE_BINARY) ? "wb" : "w");
+    if(!WRITER->File){
+        return false;
+    }
+
+    if(FORMAT == TRACE_BINARY && fwrite(HEADER, 1, sizeof(HEADER), WRITER->File) != sizeof(HEADER)){
+        fclose(WRITER->File);
+        WRITER->File = NULL;
+        return false;
+    }
+    return true;
+}
+
+
+bool Trace_WriteLine(TraceWriter_t* WRITER, const TraceLine_t* LINE){
+    unsigned char Record[3];
+    size_t Len = 1;
+    int Delta;
+    unsigned int ZigZag;
+
+    if(WRITER->Format == TRACE_TEXT){
+        return Write_Column(WRITER->File, STATE_NAMES[LINE->Postive_State]) &&
+               Write_Column(WRITER->File, STATE_NAMES[LINE->Negative_State]) &&
+               Write_Column(WRITER->File, STATE_NAMES[LINE->P_State]) &&
+               fprintf(WRITER->File, "%hhu\n", LINE->P_PressTime) > 0;
+    }
+
+    Record[0] = (unsigned char)((LINE->Postive_State & TRACE_BIN_STATE_MASK) |
+                ((LINE->Negative_State & TRACE_BIN_STATE_MASK) << TRACE_BIN_STATE_BITS) |
+                ((LINE->P_State & TRACE_BIN_STATE_MASK) << (2 * TRACE_BIN_STATE_BITS)));
+
+    Delta = (int)LINE->P_PressTime - (int)WRITER->LastPressTime;
+    if(Delta != 0){
+        Record[0] |= TRACE_BIN_TIME_CHANGED;
+        ZigZag = (Delta < 0) ? (unsigned int)(-Delta) * 2 - 1 : (unsigned int)Delta * 2;
+        while(ZigZag >= 0x80){
+            Record[Len++] = (unsigned char)(ZigZag | 0x80);
+            ZigZag >>= 7;
+        }
+        Record[Len++] = (unsigned char)ZigZag;
+        WRITER->LastPressTime = LINE->P_PressTime;
+    }
+
+    return fwrite(Record, 1, Len, WRITER->File) == Len;
+}
+
+
+bool Trace_WriteEndOfCase(TraceWriter_t* WRITER){
+    WRITER->LastPressTime = 0;
+
+    if(WRITER->Format == TRACE_TEXT){
+        return fputs("-\t\t\t-\t\t\t-\t\t\t-\n", WRITER->File) >= 0;
+    }
+    return fputc(TRACE_BIN_END_OF_CASE, WRITER->File) != EOF;
+}
+
+
+bool Trace_WriterClose(TraceWriter_t* WRITER){
+    bool Ok;
+
+    if(!WRITER->File){
+        return false;
+    }
+    Ok = (ferror(WRITER->File) == 0);
+    Ok = (fclose(WRITER->File) == 0) && Ok;
+    WRITER->File = NULL;
+    return Ok;
+}
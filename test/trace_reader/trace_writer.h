@@ -0,0 +1,53 @@
+/**
+ * @file trace_writer.h
+ * @brief Trace Writer header file
+ */
+
+#ifndef TRACE_WRITER_H_INCLUDED
+#define TRACE_WRITER_H_INCLUDED
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include"trace_reader.h"
+
+
+/** @brief A Trace opened for writing */
+typedef struct {
+    FILE* File;
+    TraceFormat_t Format;
+    unsigned char LastPressTime;
+} TraceWriter_t;
+
+
+/** @brief Create Trace File, Binary Header is written at once
+ * @param WRITER TraceWriter_t* Writer to open
+ * @param PATH const char* Trace File path
+ * @param FORMAT TraceFormat_t TRACE_TEXT (switch.txt Format) or TRACE_BINARY
+ * @return bool true if Trace File is created & false if not
+ */
+bool Trace_WriterOpen(TraceWriter_t* WRITER, const char* PATH, TraceFormat_t FORMAT);
+
+
+/** @brief Write one Test Line
+ * @param WRITER TraceWriter_t* Opened Writer
+ * @param LINE const TraceLine_t* Line Data
+ * @return bool true if Line is written & false if not
+ */
+bool Trace_WriteLine(TraceWriter_t* WRITER, const TraceLine_t* LINE);
+
+
+/** @brief Write End of Test Case (-) Line
+ * @param WRITER TraceWriter_t* Opened Writer
+ * @return bool true if Line is written & false if not
+ */
+bool Trace_WriteEndOfCase(TraceWriter_t* WRITER);
+
+
+/** @brief Flush and close Trace File
+ * @param WRITER TraceWriter_t* Writer to close
+ * @return bool true if all Lines reached the File & false if not
+ */
+bool Trace_WriterClose(TraceWriter_t* WRITER);
+
+#endif // TRACE_WRITER_H_INCLUDED
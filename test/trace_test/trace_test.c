@@ -0,0 +1,316 @@
+/**
+ * @file trace_test.c
+ * @brief Testing Trace Reader process
+ * @details Here we apply Unit Test using Unity Test-Harness on Trace Reader which parse switch.txt Lines
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+ /*    Include Unity    */
+#include "../unity/unity_fixture.h"
+
+/*    Include Modules under test    */
+#include "../trace_reader/trace_reader.h"
+#include "../trace_reader/trace_writer.h"
+#include "../trace_reader/trace_index.h"
+
+/* Helper Variables shared by all Tests */
+static TraceReader_t Reader;
+static TraceLine_t Line;
+
+/** @brief Define (TRACE) test group */
+TEST_GROUP(TRACE);
+
+/** @brief Steps are executed before each test */
+TEST_SETUP(TRACE){
+    memset(&Line, 0, sizeof(Line));
+}
+
+/** @brief Steps are executed after each test */
+TEST_TEAR_DOWN(TRACE){
+    Trace_Close(&Reader);
+}
+
+
+/*----------------Helper Functions---------------*/
+
+
+/** @brief Open Reader over a Trace text
+ * @param TEXT const char* Trace text
+ * @return void
+ */
+static void OpenText(const char* TEXT){
+    Trace_OpenMemory(&Reader, TEXT, strlen(TEXT));
+}
+
+
+/*------------------Test Cases------------------*/
+
+/** <b> Test Description : </b> Read Trace Line with all Switch States in switch.txt format <br>
+ *  <b> Test Technique: </b> Equivalence partitioning */
+TEST(TRACE, ReadLineWithAllStates){
+    /*!
+		  * @par Given : Trace Line "PRE_PRESSED PRE_RELEASED PRESSED 30" & Line "RELEASED ..."
+		  * @par When  : Trace_ReadLine() is called twice
+		  * @par Then  : States & Press Time are decoded for both Lines
+	*/
+    OpenText("PRE_PRESSED\t\tPRE_RELEASED\t\tPRESSED\t\t\t30\r\nRELEASED\tRELEASED\tRELEASED\t0\r\n");
+
+    LONGS_EQUAL(TRACE_DATA, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(PREPRESSED, Line.Postive_State);
+    LONGS_EQUAL(PRERELEASED, Line.Negative_State);
+    LONGS_EQUAL(PRESSED, Line.P_State);
+    LONGS_EQUAL(30, Line.P_PressTime);
+
+    LONGS_EQUAL(TRACE_DATA, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(RELEASED, Line.Postive_State);
+    LONGS_EQUAL(RELEASED, Line.Negative_State);
+    LONGS_EQUAL(RELEASED, Line.P_State);
+    LONGS_EQUAL(0, Line.P_PressTime);
+
+    LONGS_EQUAL(TRACE_END_OF_FILE, Trace_ReadLine(&Reader, &Line));
+}
+
+
+/** <b> Test Description : </b> (-) Line ends Test Case even without new line at end of file **/
+TEST(TRACE, DashLineEndsTestCase){
+    /*!
+		  * @par Given : Trace "- - - -" without new line
+		  * @par When  : Trace_ReadLine() is called
+		  * @par Then  : TRACE_END_OF_CASE then TRACE_END_OF_FILE
+	*/
+    OpenText("-\t\t\t-\t\t\t-\t\t\t-");
+
+    LONGS_EQUAL(TRACE_END_OF_CASE, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(TRACE_END_OF_FILE, Trace_ReadLine(&Reader, &Line));
+}
+
+
+/** <b> Test Description : </b> Unknown State, missing Field & non numeric Press Time are incorrect <br>
+ *  <b> Test Technique: </b> Equivalence partitioning */
+TEST(TRACE, IncorrectLinesAreReportedAndSkipped){
+    /*!
+		  * @par Given : Three incorrect Lines then a correct one
+		  * @par When  : Trace_ReadLine() is called
+		  * @par Then  : TRACE_INCORRECT three times then TRACE_DATA
+	*/
+    OpenText("PUSHED RELEASED RELEASED 0\nRELEASED RELEASED 0\nRELEASED RELEASED RELEASED x\nRELEASED RELEASED PRESSED 5\n");
+
+    LONGS_EQUAL(TRACE_INCORRECT, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(TRACE_INCORRECT, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(TRACE_INCORRECT, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(TRACE_DATA, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(5, Line.P_PressTime);
+}
+
+
+/** <b> Test Description : </b> Press Time accepted up to 255 and rejected at 256 <br>
+ *  <b> Test Technique: </b> Boundary Value Analysis */
+TEST(TRACE, PressTimeBoundaries){
+    /*!
+		  * @par Given : Lines with Press Time 255 & 256
+		  * @par When  : Trace_ReadLine() is called
+		  * @par Then  : 255 is decoded and 256 is incorrect
+	*/
+    OpenText("RELEASED RELEASED PRESSED 255\nRELEASED RELEASED PRESSED 256\n");
+
+    LONGS_EQUAL(TRACE_DATA, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(255, Line.P_PressTime);
+    LONGS_EQUAL(TRACE_INCORRECT, Trace_ReadLine(&Reader, &Line));
+}
+
+
+/** <b> Test Description : </b> Trace File is mapped and read like switch.txt **/
+TEST(TRACE, OpenTraceFile){
+    /*!
+		  * @par Given : switch.txt exists
+		  * @par When  : Trace_Open() is called
+		  * @par Then  : First Line is decoded
+	*/
+    CHECK(Trace_Open(&Reader, "switch.txt"));
+
+    LONGS_EQUAL(TRACE_DATA, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(PREPRESSED, Line.Postive_State);
+}
+
+
+/** <b> Test Description : </b> Lines written as Binary Trace are read back the same <br>
+ *  <b> Test Technique: </b> Boundary Value Analysis */
+TEST(TRACE, BinaryTraceRoundTrip){
+    /*!
+		  * @par Given : Lines with Press Time 0, 255, 255, 30 then (-) then Press Time 30
+		  * @par When  : Lines are written in Binary Format and read again
+		  * @par Then  : Same Lines, Test Cases & Press Times are read
+	*/
+    static const TraceLine_t Lines[] = {
+        {PREPRESSED, PRERELEASED, PRERELEASED, 0},
+        {RELEASED, RELEASED, PRESSED, 255},
+        {PRESSED, PREPRESSED, PRESSED, 255},
+        {RELEASED, RELEASED, PRESSED, 30},
+    };
+    TraceWriter_t Writer;
+    unsigned char i;
+
+    /* Arrange */
+    CHECK(Trace_WriterOpen(&Writer, "trace_test.bin", TRACE_BINARY));
+    for(i = 0; i < 4; i++){
+        CHECK(Trace_WriteLine(&Writer, &Lines[i]));
+    }
+    CHECK(Trace_WriteEndOfCase(&Writer));
+    CHECK(Trace_WriteLine(&Writer, &Lines[3]));
+    CHECK(Trace_WriterClose(&Writer));
+
+    /* Act & Assert */
+    CHECK(Trace_Open(&Reader, "trace_test.bin"));
+    LONGS_EQUAL(TRACE_BINARY, Reader.Format);
+    for(i = 0; i < 4; i++){
+        LONGS_EQUAL(TRACE_DATA, Trace_ReadLine(&Reader, &Line));
+        LONGS_EQUAL(Lines[i].Postive_State, Line.Postive_State);
+        LONGS_EQUAL(Lines[i].Negative_State, Line.Negative_State);
+        LONGS_EQUAL(Lines[i].P_State, Line.P_State);
+        LONGS_EQUAL(Lines[i].P_PressTime, Line.P_PressTime);
+    }
+    LONGS_EQUAL(TRACE_END_OF_CASE, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(TRACE_DATA, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(30, Line.P_PressTime);
+    LONGS_EQUAL(TRACE_END_OF_FILE, Trace_ReadLine(&Reader, &Line));
+
+    remove("trace_test.bin");
+}
+
+
+/** <b> Test Description : </b> Binary Trace with unknown version is refused **/
+TEST(TRACE, BinaryTraceUnknownVersionIsRefused){
+    /*!
+		  * @par Given : Binary Header with version 2
+		  * @par When  : Trace_OpenMemory() is called
+		  * @par Then  : Trace is not opened
+	*/
+    static const char Header[] = {'S', 'W', 'T', 'B', 2, 3, 0, 0};
+
+    CHECK(!Trace_OpenMemory(&Reader, Header, sizeof(Header)));
+}
+
+
+/** <b> Test Description : </b> Index finds every Test Case, also empty one & last one without (-) Line **/
+TEST(TRACE, IndexSeeksToTestCase){
+    /*!
+		  * @par Given : Trace with 2 Lines Test Case, empty Test Case and 1 Line Test Case without (-)
+		  * @par When  : Trace is indexed & Reader seeks to each Test Case
+		  * @par Then  : 3 Test Cases are found and first Line of each is read
+	*/
+    TraceIndex_t Index;
+
+    /* Arrange */
+    OpenText("RELEASED RELEASED RELEASED 0\nPRE_PRESSED RELEASED RELEASED 0\n- - - -\n- - - -\nRELEASED PRE_PRESSED RELEASED 7\n");
+
+    /* Act */
+    CHECK(TraceIndex_Build(&Index, &Reader));
+
+    /* Assert */
+    LONGS_EQUAL(3, Index.Count);
+    LONGS_EQUAL(2, Index.Cases[0].Lines);
+    LONGS_EQUAL(0, Index.Cases[1].Lines);
+    LONGS_EQUAL(1, Index.Cases[2].Lines);
+
+    CHECK(TraceIndex_Seek(&Index, &Reader, 2));
+    LONGS_EQUAL(TRACE_DATA, Trace_ReadLine(&Reader, &Line));
+    LONGS_EQUAL(PREPRESSED, Line.Negative_State);
+    LONGS_EQUAL(7, Line.P_PressTime);
+
+    CHECK(TraceIndex_Seek(&Index, &Reader, 1));
+    LONGS_EQUAL(TRACE_END_OF_CASE, Trace_ReadLine(&Reader, &Line));
+
+    CHECK(!TraceIndex_Seek(&Index, &Reader, 3));
+
+    TraceIndex_Free(&Index);
+}
+
+
+/** <b> Test Description : </b> Sidecar Index isn't used after the Trace is changed, even with the same size **/
+TEST(TRACE, SidecarIndexFollowsTraceChanges){
+    /*!
+		  * @par Given : Trace File with 2 Test Cases, indexed so its Sidecar is written
+		  * @par When  : Trace is written again at once with 3 Test Cases of the same size & indexed again
+		  * @par Then  : 3 Test Cases are found
+	*/
+    static const char* const TRACE_PATH = "trace_index_test.txt";
+    static const char FIRST[] = "RELEASED RELEASED RELEASED 0\n- - - -\nRELEASED RELEASED RELEASED 100\n";
+    static const char SECOND[] = "PRESSED PRESSED PRESSED 0\n- - - -\n- - - -\nPRESSED PRESSED PRESSED 1\n";
+    TraceIndex_t Index;
+    FILE* File;
+    unsigned int i;
+    const char* Texts[2] = {FIRST, SECOND};
+    unsigned long Counts[2];
+
+    LONGS_EQUAL(sizeof(FIRST), sizeof(SECOND));
+    for(i = 0; i < 2; i++){
+        /* Arrange */
+        File = fopen(TRACE_PATH, "wb");
+        CHECK(File != NULL);
+        fwrite(Texts[i], 1, sizeof(FIRST) - 1, File);
+        fclose(File);
+
+        /* Act */
+        CHECK(Trace_Open(&Reader, TRACE_PATH));
+        CHECK(TraceIndex_Load(&Index, TRACE_PATH, &Reader));
+        Counts[i] = Index.Count;
+        TraceIndex_Free(&Index);
+        Trace_Close(&Reader);
+    }
+    remove(TRACE_PATH);
+    remove("trace_index_test.txt" TRACE_INDEX_SUFFIX);
+
+    /* Assert */
+    LONGS_EQUAL(2, Counts[0]);
+    LONGS_EQUAL(3, Counts[1]);
+}
+
+
+/** <b> Test Description : </b> Keywords are decoded only if length & all characters match <br>
+ *  <b> Test Technique: </b> Equivalence partitioning */
+TEST(TRACE, DecodeStateKeywords){
+    /*!
+		  * @par Given : The four Keywords, Keywords with one wrong character, empty & too long Tokens
+		  * @par When  : Trace_DecodeState() is called
+		  * @par Then  : Only the four Keywords are decoded
+	*/
+    SwitchState_t State = RELEASED;
+
+    CHECK(Trace_DecodeState("PRE_PRESSED", 11, &State));
+    LONGS_EQUAL(PREPRESSED, State);
+    CHECK(Trace_DecodeState("PRESSED", 7, &State));
+    LONGS_EQUAL(PRESSED, State);
+    CHECK(Trace_DecodeState("PRE_RELEASED", 12, &State));
+    LONGS_EQUAL(PRERELEASED, State);
+    CHECK(Trace_DecodeState("RELEASED", 8, &State));
+    LONGS_EQUAL(RELEASED, State);
+
+    /* Only first LEN characters are part of the Token */
+    CHECK(Trace_DecodeState("PRESSED\t\t30", 7, &State));
+    LONGS_EQUAL(PRESSED, State);
+
+    CHECK(!Trace_DecodeState("PRESSEX", 7, &State));
+    CHECK(!Trace_DecodeState("RELEASEd", 8, &State));
+    CHECK(!Trace_DecodeState("PRE_RELEASEX", 12, &State));
+    CHECK(!Trace_DecodeState("", 0, &State));
+    CHECK(!Trace_DecodeState("-", 1, &State));
+    CHECK(!Trace_DecodeState("PRE_RELEASED_", 13, &State));
+}
+
+
+/** @brief Tests Runner */
+TEST_GROUP_RUNNER(TRACE){
+    RUN_TEST_CASE(TRACE, ReadLineWithAllStates);
+    RUN_TEST_CASE(TRACE, DashLineEndsTestCase);
+    RUN_TEST_CASE(TRACE, IncorrectLinesAreReportedAndSkipped);
+    RUN_TEST_CASE(TRACE, PressTimeBoundaries);
+    RUN_TEST_CASE(TRACE, OpenTraceFile);
+    RUN_TEST_CASE(TRACE, BinaryTraceRoundTrip);
+    RUN_TEST_CASE(TRACE, BinaryTraceUnknownVersionIsRefused);
+    RUN_TEST_CASE(TRACE, IndexSeeksToTestCase);
+    RUN_TEST_CASE(TRACE, SidecarIndexFollowsTraceChanges);
+    RUN_TEST_CASE(TRACE, DecodeStateKeywords);
+}
@@ -6,7 +6,6 @@
  */
 
 #include <stdio.h>
-#include <string.h>
 
  /*    Include Unity    */
 #include "../unity/unity_fixture.h"
@@ -15,15 +14,30 @@
 #include "../fake_switch/fake_switch.h"
 #include "../../source/speedcontrol/speedcontrol.h"
 #include "../../source/switches/switch.h"
-
-/* Helper function to read TestData */
-static unsigned char Get_TestData(SwitchState_t* Postive_State, SwitchState_t* Negative_State, SwitchState_t* P_State, unsigned char* P_PressTime, unsigned char TestLine);
+#include "../trace_reader/trace_reader.h"
+#include "../trace_reader/trace_index.h"
+#include "../result_sink/result_sink.h"
 
 static void Arrange_TestData(SwitchState_t Postive_State, SwitchState_t Negative_State, SwitchState_t P_State, unsigned char P_PressTime);
 
 static void Write_TestResult(unsigned char MotorAngle, unsigned char TestNum);
 
-static void Check_TestCase(unsigned char TestCaseNum, unsigned char TestLine, unsigned char* TestsCounter);
+static void Save_TestResults(void);
+
+static void Check_TestCase(unsigned char TestCaseNum);
+
+/* switch.txt is opened & indexed by first Check_TestCase() and closed after all UPDATE tests */
+static TraceReader_t Trace;
+static TraceIndex_t Index;
+static bool TraceReady;
+
+/** @brief Number of Test Cases with a Result in motor.txt */
+#define UPDATE_RESULTS  9
+
+/* Results by Test Case, motor.txt is read by first Write_TestResult() and written after all UPDATE tests */
+static short Results[UPDATE_RESULTS];
+static unsigned int ResultsCount;
+static bool ResultsRead;
 
 /** @brief Define (UPDATE) test group */
 TEST_GROUP(UPDATE);
@@ -147,11 +161,7 @@ TEST(UPDATE, SpeedChangeFromMedToMaxRemainMaxThenToMed){
 	unsigned char TestCase_Num = 1;
 
 	/* Arrange & Act */
-	unsigned char TestLine = 1, TestsCounter = 0;
-	while(TestsCounter != TestCase_Num){
-        Check_TestCase(TestCase_Num, TestLine, &TestsCounter);
-        TestLine++;
-	}
+	Check_TestCase(TestCase_Num);
 
     /* Motor Angle */
     unsigned char Expected_Angle = 90; /* Speed: MED */
@@ -177,11 +187,7 @@ TEST(UPDATE, SpeedChangeFromMedToMaxThenRemainMaxDue){
 	unsigned char TestCase_Num = 2;
 
 	/* Arrange & Act */
-	unsigned char TestLine = 1, TestsCounter = 0;
-	while(TestsCounter != TestCase_Num){
-        Check_TestCase(TestCase_Num, TestLine, &TestsCounter);
-        TestLine++;
-	}
+	Check_TestCase(TestCase_Num);
 
     /* Motor Angle */
     unsigned char Expected_Angle = 10; /* Speed: MAX */
@@ -206,11 +212,7 @@ TEST(UPDATE, SpeedChangeFromMedToMaxReturnMedThenMax){
 	unsigned char TestCase_Num = 3;
 
 	/* Arrange & Act */
-	unsigned char TestLine = 1, TestsCounter = 0;
-	while(TestsCounter != TestCase_Num){
-        Check_TestCase(TestCase_Num, TestLine, &TestsCounter);
-        TestLine++;
-	}
+	Check_TestCase(TestCase_Num);
 
     /* Motor Angle */
     unsigned char Expected_Angle = 10; /* Speed: MAX */
@@ -236,11 +238,7 @@ TEST(UPDATE, SpeedChangeFromMedToMaxReturnMedThenMin){
 	unsigned char TestCase_Num = 4;
 
 	/* Arrange & Act */
-	unsigned char TestLine = 1, TestsCounter = 0;
-	while(TestsCounter != TestCase_Num){
-        Check_TestCase(TestCase_Num, TestLine, &TestsCounter);
-        TestLine++;
-	}
+	Check_TestCase(TestCase_Num);
 
     /* Motor Angle */
     unsigned char Expected_Angle = 140; /* Speed: MIN */
@@ -266,11 +264,7 @@ TEST(UPDATE, SpeedChangeFromMedToMinRemainMinThenMed){
 	unsigned char TestCase_Num = 5;
 
 	/* Arrange & Act */
-	unsigned char TestLine = 1, TestsCounter = 0;
-	while(TestsCounter != TestCase_Num){
-        Check_TestCase(TestCase_Num, TestLine, &TestsCounter);
-        TestLine++;
-	}
+	Check_TestCase(TestCase_Num);
 
     /* Motor Angle */
     unsigned char Expected_Angle = 90; /* Speed: MED */
@@ -296,11 +290,7 @@ TEST(UPDATE, SpeedChangeFromMedToMinRemainMinDue){
 	unsigned char TestCase_Num = 6;
 
 	/* Arrange & Act */
-	unsigned char TestLine = 1, TestsCounter = 0;
-	while(TestsCounter != TestCase_Num){
-        Check_TestCase(TestCase_Num, TestLine, &TestsCounter);
-        TestLine++;
-	}
+	Check_TestCase(TestCase_Num);
 
     /* Motor Angle */
     unsigned char Expected_Angle = 140; /* Speed: MIN */
@@ -326,11 +316,7 @@ TEST(UPDATE, SpeedChangeFromMedToMinReturnMedThenMax){
 	unsigned char TestCase_Num = 7;
 
 	/* Arrange & Act */
-	unsigned char TestLine = 1, TestsCounter = 0;
-	while(TestsCounter != TestCase_Num){
-        Check_TestCase(TestCase_Num, TestLine, &TestsCounter);
-        TestLine++;
-	}
+	Check_TestCase(TestCase_Num);
 
     /* Motor Angle */
     unsigned char Expected_Angle = 10; /* Speed: MAX */
@@ -356,11 +342,7 @@ TEST(UPDATE, SpeedChangeFromMedToMinReturnMedThenMin){
 	unsigned char TestCase_Num = 8;
 
 	/* Arrange & Act */
-	unsigned char TestLine = 1, TestsCounter = 0;
-	while(TestsCounter != TestCase_Num){
-        Check_TestCase(TestCase_Num, TestLine, &TestsCounter);
-        TestLine++;
-	}
+	Check_TestCase(TestCase_Num);
 
     /* Motor Angle */
     unsigned char Expected_Angle = 140; /* Speed: MIN */
@@ -386,11 +368,7 @@ TEST(UPDATE, SpeedChangeFromMinToMaxInOneStepIsInvalid){
 	unsigned char TestCase_Num = 9;
 
 	/* Arrange & Act */
-	unsigned char TestLine = 1, TestsCounter = 0;
-	while(TestsCounter != TestCase_Num){
-        Check_TestCase(TestCase_Num, TestLine, &TestsCounter);
-        TestLine++;
-	}
+	Check_TestCase(TestCase_Num);
 
     /* Motor Angle */
     unsigned char Expected_Angle = 90; /* Speed: MED */
@@ -423,152 +401,62 @@ TEST_GROUP_RUNNER(UPDATE){
     RUN_TEST_CASE(UPDATE, SpeedChangeFromMedToMinReturnMedThenMin);
     RUN_TEST_CASE(UPDATE, SpeedChangeFromMinToMaxInOneStepIsInvalid);
 
-}
-
-
-/** @brief This function has multi tasks: it get Required Test Case by count how many test cases has finished
- * Return Speed to default before every Test Case and Get and Arrange each Test Line.
- * @param TestCaseNum unsigned char Number of current Test Case
- * @param TestLine unsigned char Number of Test Line to Get and Arrange
- * @param TestsCounter unsigned char* how many test case had read
- * @return void
- */
-static void Check_TestCase(unsigned char TestCaseNum, unsigned char TestLine, unsigned char* TestsCounter){
-    //Test Data
-	SwitchState_t Postive_State, Negative_State, P_State;
-	unsigned char P_PressTime;
-
-    /* End of Test Case */
-    if(Get_TestData(&Postive_State, &Negative_State, &P_State, &P_PressTime, TestLine) == 2){
-
-        *TestsCounter += 1;
-
-        /* Check if there are other test cases (Srart from default) or it is what we want */
-        if(*TestsCounter != TestCaseNum){
-            Speed_Init();
-        }else{
-
-        }
-
-    /* Correct Data */
-    }else if(Get_TestData(&Postive_State, &Negative_State, &P_State, &P_PressTime, TestLine) == 0){
-            Arrange_TestData(Postive_State,Negative_State, P_State, P_PressTime);
-
-    }else{
-
+    if(TraceReady){
+        TraceIndex_Free(&Index);
+        Trace_Close(&Trace);
+        TraceReady = false;
     }
 
+    /* All Results are collected, now write & sync motor.txt */
+    if(ResultsRead){
+        Save_TestResults();
+        ResultsRead = false;
+    }
 }
 
 
-/** @brief Get TestData from switch.txt file to use it in Tests
- * @param Postive_State SwitchState_t* Current +ve Switch State
- * @param Negative_State SwitchState_t* +ve Switch State
- * @param P_State SwitchState_t* Current p Switch State
- * @param P_PressTime unsigned char* Current P Press Time
- * @param TestLine unsigned char Number of current Test Line
- * @return unsigned char 0 if Data is Correct, 2 implies End of Test Case and 1 if Data is incorrect
+/** @brief Seek to Required Test Case using switch.txt Index then Arrange each Test Line
+ * till the end of this Test Case. Speed is default before every Test Case (TEST_SETUP).
+ * @param TestCaseNum unsigned char Number of Test Case to replay starting from 1
+ * @return void
  */
-static unsigned char Get_TestData(SwitchState_t* Postive_State, SwitchState_t* Negative_State, SwitchState_t* P_State, unsigned char* P_PressTime, unsigned char TestLine){
-    FILE* data = fopen("switch.txt", "r+");
-//
-    char str1[20];
-    char str2[20];
-    char str3[20];
-    char str4[10];
-    unsigned char time;
-    if(data){
-
-        // Get Data
-        unsigned char i;
-        for(i = 0; i < TestLine; i++){
-
-            memset(str1,0,20);
-            memset(str2,0,20);
-            memset(str3,0,20);
-            memset(str4,0,10);
-
-            fscanf(data, "%s\t%s\t%s\t%s\n",str1, str2, str3, str4);
-
-            time = atoi(str4);
-        }
-
-        // Check if Data is Correct or not
-        if(strcmp(str1, "PRE_PRESSED") == 0){
-            *Postive_State = PREPRESSED;
-
-        }else if(strcmp(str1, "PRESSED") == 0){
-            *Postive_State = PRESSED;
-
-        }else if(strcmp(str1, "PRE_RELEASED") == 0){
-            *Postive_State = PRERELEASED;
-
-        }else if(strcmp(str1, "RELEASED") == 0){
-            *Postive_State = RELEASED;
-
-        }else if(strcmp(str1, "-") == 0){
-            return 2;
+static void Check_TestCase(unsigned char TestCaseNum){
+    //Test Data
+    TraceLine_t Line;
+    TraceStatus_t Status;
 
-        }else{
-            printf("Incorrect TestData\n");
-            return 1;
+    if(!TraceReady){
+        if(!Trace_Open(&Trace, "switch.txt")){
+            printf("Failed To open TestData file\n");
+            return;
         }
-
-        if(strcmp(str2, "PRE_PRESSED") == 0){
-            *Negative_State = PREPRESSED;
-
-        }else if(strcmp(str2, "PRESSED") == 0){
-            *Negative_State = PRESSED;
-
-        }else if(strcmp(str2, "PRE_RELEASED") == 0){
-            *Negative_State = PRERELEASED;
-
-        }else if(strcmp(str2, "RELEASED") == 0){
-            *Negative_State = RELEASED;
-
-        }else{
-            printf("Incorrect TestData\n");
-            return 1;
+        if(!TraceIndex_Load(&Index, "switch.txt", &Trace)){
+            printf("Failed To index TestData file\n");
+            Trace_Close(&Trace);
+            return;
         }
+        TraceReady = true;
+    }
 
-        if(strcmp(str3, "PRE_PRESSED") == 0){
-            *P_State = PREPRESSED;
-
-        }else if(strcmp(str3, "PRESSED") == 0){
-            *P_State = PRESSED;
-
-        }else if(strcmp(str3, "PRE_RELEASED") == 0){
-            *P_State = PRERELEASED;
-
-        }else if(strcmp(str3, "RELEASED") == 0){
-            *P_State = RELEASED;
-
-        }else{
-            printf("Incorrect TestData\n");
-            return 1;
-        }
+    if(!TraceIndex_Seek(&Index, &Trace, TestCaseNum - 1)){
+        printf("Test Case not found\n");
+        return;
+    }
 
+    while((Status = Trace_ReadLine(&Trace, &Line)) != TRACE_END_OF_CASE && Status != TRACE_END_OF_FILE){
 
-        if(time >= 0){
-            *P_PressTime = time;
+        /* Correct Data */
+        if(Status == TRACE_DATA){
+            Arrange_TestData(Line.Postive_State, Line.Negative_State, Line.P_State, Line.P_PressTime);
 
         }else{
             printf("Incorrect TestData\n");
-            return 1;
         }
-
-        fclose(data);
-
-    }else{
-
-        printf("Failed To open TestData file\n");
-        return 1;
     }
-    return 0;
 }
 
 
-/** @brief Arrange Data from Get_TestData() and apply it into Fake Switch module to see result
+/** @brief Arrange Data from Trace_ReadLine() and apply it into Fake Switch module to see result
  * @param Postive_State SwitchState_t +ve Switch State
  * @param Negative_State SwitchState_t -ve Switch State
  * @param P_State SwitchState_t P Switch State
@@ -589,38 +477,53 @@ static void Arrange_TestData(SwitchState_t Postive_State, SwitchState_t Negative
 }
 
 
-/** @brief Write Test Data Result (Motor Angle) in motor.txt
+/** @brief Keep Test Data Result (Motor Angle) for the Line of its Test Case in motor.txt,
+ * Results of Test Cases which don't run (filtered or stopped) are kept from the last motor.txt
  * @param MotorAngle unsigned char Motor Angle Result from Test Data
  * @param TestNum Number of current Test Case
  * @return void
  */
 static void Write_TestResult(unsigned char MotorAngle, unsigned char TestNum){
-    FILE* result = fopen("motor.txt", "r");
-    FILE* Temp = fopen("Temp.tmp", "w");
-
-    char str[12];
-
-    if(result && Temp){
-        unsigned char i;
-
-        for(i = 1; i <= TestNum; i++){
-            memset(str, 0, 12);
-            fscanf(result, "%s\n", str);
-            fprintf(Temp, "%s\n", str);
+    unsigned int i;
 
+    if(!ResultsRead){
+        ResultsCount = ResultSink_Read("motor.txt", Results, UPDATE_RESULTS);
+        for(i = ResultsCount; i < UPDATE_RESULTS; i++){
+            Results[i] = -1;
         }
+        ResultsRead = true;
+    }
 
-        fprintf(Temp, "%hhu\n", MotorAngle);
-    }else{
-        printf("Failed To open Result file\n");
-
+    if(TestNum == 0 || TestNum > UPDATE_RESULTS){
+        printf("Test Case has no Result Line\n");
+        return;
     }
+    Results[TestNum - 1] = MotorAngle;
+    if(ResultsCount < TestNum){
+        ResultsCount = TestNum;
+    }
+}
 
 
-    fclose(result);
-    fclose(Temp);
+/** @brief Write all Results to motor.txt, one Line per Test Case in order, and sync it
+ * @param void
+ * @return void
+ */
+static void Save_TestResults(void){
+    ResultSink_t Sink;
+    unsigned int i;
+    bool Ok;
 
-    remove("motor.txt");
+    if(!ResultSink_Open(&Sink, "motor.txt")){
+        printf("Failed To open Result file\n");
+        return;
+    }
 
-    rename("Temp.tmp", "motor.txt");
+    Ok = true;
+    for(i = 0; i < ResultsCount; i++){
+        Ok = ((Results[i] < 0) ? ResultSink_WriteEmpty(&Sink) : ResultSink_Write(&Sink, (unsigned char)Results[i])) && Ok;
+    }
+    if(!ResultSink_Close(&Sink) || !Ok){
+        printf("Failed To write Result file\n");
+    }
 }
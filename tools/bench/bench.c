@@ -0,0 +1,335 @@
+/**
+ * @file bench.c
+ * @brief Speed Control Benchmarks
+ * @details Here we measure ns/op and cycles/op of the hot path: Speed_Update for every class of
+ * Switches Inputs, MotAngle_Write, Speed_Increase, Speed_Decrease, Update_Switch, EventRing_Record and Trace parsing. <br>
+ * Usage: bench [-r REPETITIONS] [-w WARMUP_MS] [-t REPETITION_MS] [-f FILTER] [-j JSON_FILE]
+ * [-b BASELINE_FILE] [-T THRESHOLD_PCT] [-k NOISE_MADS] [-c CONFIRM_RUNS] <br>
+ * With -b Results are compared with the Baseline File (tools/bench/baseline.json) and bench
+ * returns 2 if any Benchmark regressed more than THRESHOLD_PCT (default 10) beyond the noise.
+ * A regressed Benchmark is run again CONFIRM_RUNS times (default 2) and fails only if it
+ * regressed in every run, one noisy run on a busy machine doesn't fail the gate
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/*    Include Modules    */
+#include "bench_harness.h"
+#include "../../source/switches/switch.h"
+#include "../../source/speedcontrol/speedcontrol.h"
+#include "../../source/event_ring/event_ring.h"
+#include "../../test/fake_switch/fake_switch.h"
+#include "../../test/trace_reader/trace_reader.h"
+
+/** @brief Results are added here so the compiler can't remove the measured work */
+static volatile long BENCH_SINK;
+
+/** @brief Switches Inputs of one Speed_Update class */
+typedef struct {
+    SwitchState_t Postive_State;
+    SwitchState_t Negative_State;
+    SwitchState_t P_State;
+    unsigned char P_PressTime;
+} BenchInput_t;
+
+/** @brief Speed_Update Input classes */
+static BenchInput_t IDLE           = {RELEASED, RELEASED, RELEASED, 0};
+static BenchInput_t POSTIVE_EDGE   = {PREPRESSED, RELEASED, RELEASED, 0};
+static BenchInput_t NEGATIVE_EDGE  = {RELEASED, PREPRESSED, RELEASED, 0};
+static BenchInput_t P_SHORT_PRESS  = {RELEASED, RELEASED, PRESSED, 29};
+static BenchInput_t P_LONG_PRESS   = {RELEASED, RELEASED, PRESSED, 30};
+static BenchInput_t ALL_RULES      = {PREPRESSED, PREPRESSED, PRESSED, 255};
+
+/** @brief In memory Traces for parsing Benchmarks */
+static TraceReader_t TEXT_TRACE;
+static TraceReader_t BINARY_TRACE;
+
+
+/*----------------Benchmarks---------------*/
+
+
+/** @brief Speed_Init then Speed_Update with one Input class, Speed starts from MED every time
+ * so the class is measured and not a saturated Speed */
+static void Bench_SpeedUpdate(void* ARG, unsigned long ITERS){
+    const BenchInput_t* Input = ARG;
+    unsigned long i;
+
+    Set_FakeSW_State(POSTIVE, Input->Postive_State);
+    Set_FakeSW_State(NEGATIVE, Input->Negative_State);
+    Set_FakeSW_State(P, Input->P_State);
+    Set_FakeSW_PressTime(Input->P_PressTime);
+
+    for(i = 0; i < ITERS; i++){
+        Speed_Init();
+        Speed_Update();
+        BENCH_SINK += MotAngle_Write();
+    }
+}
+
+/** @brief Speed_Init & MotAngle_Write only, subtract it from Speed_Update classes */
+static void Bench_SpeedInit(void* ARG, unsigned long ITERS){
+    unsigned long i;
+    (void)ARG;
+
+    for(i = 0; i < ITERS; i++){
+        Speed_Init();
+        BENCH_SINK += MotAngle_Write();
+    }
+}
+
+/** @brief MotAngle_Write at MED Speed */
+static void Bench_MotAngleWrite(void* ARG, unsigned long ITERS){
+    unsigned long i;
+    (void)ARG;
+
+    Speed_Init();
+    for(i = 0; i < ITERS; i++){
+        BENCH_SINK += MotAngle_Write();
+    }
+}
+
+/** @brief Speed_Increase from MIN to MAX and back by Speed_Decrease, both clamped & applied steps */
+static void Bench_SpeedIncrease(void* ARG, unsigned long ITERS){
+    unsigned long i;
+    (void)ARG;
+
+    for(i = 0; i < ITERS; i++){
+        if((i & 3) == 0){
+            Speed_Init();
+            Speed_Decrease();
+        }
+        Speed_Increase();
+    }
+    BENCH_SINK += MotAngle_Write();
+}
+
+/** @brief Speed_Decrease from MAX to MIN and back by Speed_Increase, both clamped & applied steps */
+static void Bench_SpeedDecrease(void* ARG, unsigned long ITERS){
+    unsigned long i;
+    (void)ARG;
+
+    for(i = 0; i < ITERS; i++){
+        if((i & 3) == 0){
+            Speed_Init();
+            Speed_Increase();
+        }
+        Speed_Decrease();
+    }
+    BENCH_SINK += MotAngle_Write();
+}
+
+/** @brief Update_Switch of the three Switches, one scheduler tick */
+static void Bench_UpdateSwitch(void* ARG, unsigned long ITERS){
+    unsigned long i;
+    (void)ARG;
+
+    for(i = 0; i < ITERS; i++){
+        Update_Switch(P);
+        Update_Switch(POSTIVE);
+        Update_Switch(NEGATIVE);
+    }
+}
+
+/** @brief Add one Event Record, the Ring is full after the first repetition so oldest Records are overwritten */
+static void Bench_EventRecord(void* ARG, unsigned long ITERS){
+    unsigned long i;
+    (void)ARG;
+
+    for(i = 0; i < ITERS; i++){
+        EventRing_Record(EVENT_MOTOR_ANGLE, MED, i);
+    }
+}
+
+/** @brief Read one Trace Line, Trace is read again from the start at its end */
+static void Bench_TraceReadLine(void* ARG, unsigned long ITERS){
+    TraceReader_t* Reader = ARG;
+    TraceLine_t Line;
+    TraceStatus_t Status;
+    unsigned long i;
+
+    for(i = 0; i < ITERS; i++){
+        Status = Trace_ReadLine(Reader, &Line);
+        if(Status == TRACE_END_OF_FILE){
+            Trace_Rewind(Reader);
+        }
+        BENCH_SINK += Status;
+    }
+}
+
+
+/*----------------Setup---------------*/
+
+
+/** @brief Text & Binary Traces of switch.txt Test Cases repeated, so parsing is measured
+ * on the same Lines as the UPDATE tests */
+static void Bench_MakeTraces(void){
+    static const char CASES[] =
+        "PRE_PRESSED\t\tPRE_RELEASED\t\tPRE_RELEASED\t\t0\r\n"
+        "PRE_PRESSED\t\tRELEASED\t\tRELEASED\t\t0\r\n"
+        "RELEASED\t\tRELEASED\t\tPRESSED\t\t\t30\r\n"
+        "-\t\t\t-\t\t\t-\t\t\t-\r\n"
+        "PRE_RELEASED\t\tPRE_PRESSED\t\tPRE_RELEASED\t\t0\r\n"
+        "RELEASED\t\tPRE_PRESSED\t\tRELEASED\t\t0\r\n"
+        "-\t\t\t-\t\t\t-\t\t\t-\r\n";
+    static const unsigned char RECORDS[] = {
+        'S', 'W', 'T', 'B', TRACE_BIN_VERSION, TRACE_BIN_SWITCHES, 0, 0,
+        0x28, 0x3C, 0x9F, 0x3C, TRACE_BIN_END_OF_CASE, 0x22, 0x33, TRACE_BIN_END_OF_CASE
+    };
+    enum {REPEAT = 512};
+    static char Text[sizeof(CASES) * REPEAT];
+    static unsigned char Binary[sizeof(RECORDS) + (sizeof(RECORDS) - TRACE_BIN_HEADER_SIZE) * REPEAT];
+    size_t i;
+
+    for(i = 0; i < REPEAT; i++){
+        memcpy(Text + i * (sizeof(CASES) - 1), CASES, sizeof(CASES) - 1);
+    }
+    Trace_OpenMemory(&TEXT_TRACE, Text, (sizeof(CASES) - 1) * REPEAT);
+
+    memcpy(Binary, RECORDS, TRACE_BIN_HEADER_SIZE);
+    for(i = 0; i < REPEAT; i++){
+        memcpy(Binary + TRACE_BIN_HEADER_SIZE + i * (sizeof(RECORDS) - TRACE_BIN_HEADER_SIZE),
+               RECORDS + TRACE_BIN_HEADER_SIZE, sizeof(RECORDS) - TRACE_BIN_HEADER_SIZE);
+    }
+    Trace_OpenMemory(&BINARY_TRACE, Binary, TRACE_BIN_HEADER_SIZE + (sizeof(RECORDS) - TRACE_BIN_HEADER_SIZE) * REPEAT);
+}
+
+
+/** @brief Most Benchmarks read from a Baseline File */
+#define BENCH_MAX_BASELINE      64
+
+
+/** @brief All Benchmarks */
+static const Bench_t BENCHMARKS[] = {
+    {"Speed_Update/idle",           Bench_SpeedUpdate,   &IDLE},
+    {"Speed_Update/postive_edge",   Bench_SpeedUpdate,   &POSTIVE_EDGE},
+    {"Speed_Update/negative_edge",  Bench_SpeedUpdate,   &NEGATIVE_EDGE},
+    {"Speed_Update/p_short_press",  Bench_SpeedUpdate,   &P_SHORT_PRESS},
+    {"Speed_Update/p_long_press",   Bench_SpeedUpdate,   &P_LONG_PRESS},
+    {"Speed_Update/all_rules",      Bench_SpeedUpdate,   &ALL_RULES},
+    {"Speed_Init+MotAngle_Write",   Bench_SpeedInit,     NULL},
+    {"MotAngle_Write",              Bench_MotAngleWrite, NULL},
+    {"Speed_Increase",              Bench_SpeedIncrease, NULL},
+    {"Speed_Decrease",              Bench_SpeedDecrease, NULL},
+    {"Update_Switch/3_switches",    Bench_UpdateSwitch,  NULL},
+    {"EventRing_Record",            Bench_EventRecord,   NULL},
+    {"Trace_ReadLine/text",         Bench_TraceReadLine, &TEXT_TRACE},
+    {"Trace_ReadLine/binary",       Bench_TraceReadLine, &BINARY_TRACE},
+};
+
+#define BENCH_COUNT     (sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]))
+
+
+/** @brief main function run all Benchmarks matching the filter
+ * @param argc int
+ * @param argv[] char*
+ * @return int 0 if all is fine, 1 if there's an error & 2 if a Benchmark regressed
+ */
+int main(int argc, char* argv[])
+{
+    BenchConfig_t Config = {15, 200, 20};
+    BenchResult_t Results[BENCH_COUNT];
+    const char* Filter = NULL;
+    const char* Json = NULL;
+    const char* BaselineFile = NULL;
+    BenchGate_t Gate = {10.0, 3.0};
+    static BenchBaseline_t Baseline[BENCH_MAX_BASELINE];
+    const Bench_t* Ran[BENCH_COUNT];
+    bool Regressed[BENCH_COUNT];
+    unsigned int Count = 0, BaseCount = 0, Confirm = 2, Regressions, Run, i;
+    int Arg;
+    FILE* Out;
+
+    for(Arg = 1; Arg + 1 < argc; Arg += 2){
+        if(strcmp(argv[Arg], "-r") == 0){
+            Config.Repetitions = (unsigned int)strtoul(argv[Arg + 1], NULL, 10);
+        }else if(strcmp(argv[Arg], "-w") == 0){
+            Config.WarmupMs = strtod(argv[Arg + 1], NULL);
+        }else if(strcmp(argv[Arg], "-t") == 0){
+            Config.RepetitionMs = strtod(argv[Arg + 1], NULL);
+        }else if(strcmp(argv[Arg], "-f") == 0){
+            Filter = argv[Arg + 1];
+        }else if(strcmp(argv[Arg], "-j") == 0){
+            Json = argv[Arg + 1];
+        }else if(strcmp(argv[Arg], "-b") == 0){
+            BaselineFile = argv[Arg + 1];
+        }else if(strcmp(argv[Arg], "-T") == 0){
+            Gate.ThresholdPct = strtod(argv[Arg + 1], NULL);
+        }else if(strcmp(argv[Arg], "-k") == 0){
+            Gate.NoiseMads = strtod(argv[Arg + 1], NULL);
+        }else if(strcmp(argv[Arg], "-c") == 0){
+            Confirm = (unsigned int)strtoul(argv[Arg + 1], NULL, 10);
+        }else{
+            break;
+        }
+    }
+    if(Arg != argc){
+        fprintf(stderr, "Usage: %s [-r REPETITIONS] [-w WARMUP_MS] [-t REPETITION_MS] [-f FILTER] [-j JSON_FILE]"
+                        " [-b BASELINE_FILE] [-T THRESHOLD_PCT] [-k NOISE_MADS] [-c CONFIRM_RUNS]\n", argv[0]);
+        return 1;
+    }
+
+    /* Read Baseline first, no need to wait for all Benchmarks to find it's missing */
+    if(BaselineFile && !Bench_ReadJson(BaselineFile, Baseline, BENCH_MAX_BASELINE, &BaseCount)){
+        fprintf(stderr, "Failed To read %s\n", BaselineFile);
+        return 1;
+    }
+
+    SW_Init(P);
+    SW_Init(POSTIVE);
+    SW_Init(NEGATIVE);
+    FakeSW_Init(P);
+    FakeSW_Init(POSTIVE);
+    FakeSW_Init(NEGATIVE);
+    Get_SWState = Get_FakeSW_State;
+    Get_PressTime = Get_FakeSW_PressTime;
+    Bench_MakeTraces();
+
+    for(i = 0; i < BENCH_COUNT; i++){
+        if(Filter && !strstr(BENCHMARKS[i].Name, Filter)){
+            continue;
+        }
+        Ran[Count] = &BENCHMARKS[i];
+        Bench_Run(&BENCHMARKS[i], &Config, &Results[Count++]);
+    }
+
+    Bench_PrintTable(stdout, Results, Count);
+
+    /* Run regressed Benchmarks again, the last run is kept so a Benchmark fails only if all runs regressed */
+    if(BaselineFile){
+        Regressions = Bench_CompareBaseline(NULL, Results, Count, Baseline, BaseCount, &Gate, Regressed);
+        for(Run = 0; Run < Confirm && Regressions != 0; Run++){
+            for(i = 0; i < Count; i++){
+                if(Regressed[i]){
+                    Bench_Run(Ran[i], &Config, &Results[i]);
+                }
+            }
+            Regressions = Bench_CompareBaseline(NULL, Results, Count, Baseline, BaseCount, &Gate, Regressed);
+        }
+    }
+
+    if(Json){
+        Out = fopen(Json, "w");
+        if(!Out || !Bench_WriteJson(Out, Results, Count)){
+            fprintf(stderr, "Failed To write %s\n", Json);
+            if(Out){
+                fclose(Out);
+            }
+            return 1;
+        }
+        fclose(Out);
+    }
+
+    if(BaselineFile){
+        printf("\nCompared with %s (threshold %.1f%%, noise %.1f MADs)\n", BaselineFile, Gate.ThresholdPct, Gate.NoiseMads);
+        Regressions = Bench_CompareBaseline(stdout, Results, Count, Baseline, BaseCount, &Gate, NULL);
+        if(Regressions != 0){
+            printf("%u Benchmark(s) regressed\n", Regressions);
+            return 2;
+        }
+    }
+    return 0;
+}
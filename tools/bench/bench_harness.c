@@ -0,0 +1,345 @@
+/**
+ * @file bench_harness.c
+ * @brief Benchmark Harness main file
+ * @details Here we time Benchmarks with the monotonic clock and the CPU cycle counter (x86 only).
+ * Every Benchmark is warmed up, then run in Repetitions of about the same time, and
+ * median & MAD of all Repetitions are reported so one slow Repetition doesn't move the Result.
+ * Results can be compared with a stored Baseline File to catch regressions before merge
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_CYCLES    1
+#else
+#define BENCH_HAS_CYCLES    0
+#endif
+
+ /*    Include Header    */
+#include"bench_harness.h"
+
+
+/** @brief Current monotonic time
+ * @param void
+ * @return double Time in ns
+ */
+static double Bench_NowNs(void){
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return (double)Now.tv_sec * 1e9 + (double)Now.tv_nsec;
+}
+
+
+/** @brief Current CPU cycle counter
+ * @param void
+ * @return uint64_t Cycles or 0 if there is no counter
+ */
+static uint64_t Bench_Cycles(void){
+#if BENCH_HAS_CYCLES
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+
+/** @brief Compare two values for qsort
+ * @param A const void* First value
+ * @param B const void* Second value
+ * @return int <0, 0 or >0
+ */
+static int Bench_CompareDouble(const void* A, const void* B){
+    double X = *(const double*)A, Y = *(const double*)B;
+    return (X > Y) - (X < Y);
+}
+
+
+BenchStat_t Bench_Stat(double* VALUES, unsigned int COUNT){
+    double Deviations[BENCH_MAX_REPETITIONS];
+    BenchStat_t Stat = {0, 0};
+    unsigned int i;
+
+    if(COUNT == 0 || COUNT > BENCH_MAX_REPETITIONS){
+        return Stat;
+    }
+
+    qsort(VALUES, COUNT, sizeof(double), Bench_CompareDouble);
+    Stat.Median = (COUNT % 2) ? VALUES[COUNT / 2] : (VALUES[COUNT / 2 - 1] + VALUES[COUNT / 2]) / 2;
+
+    for(i = 0; i < COUNT; i++){
+        Deviations[i] = (VALUES[i] > Stat.Median) ? VALUES[i] - Stat.Median : Stat.Median - VALUES[i];
+    }
+    qsort(Deviations, COUNT, sizeof(double), Bench_CompareDouble);
+    Stat.Mad = (COUNT % 2) ? Deviations[COUNT / 2] : (Deviations[COUNT / 2 - 1] + Deviations[COUNT / 2]) / 2;
+
+    return Stat;
+}
+
+
+void Bench_Run(const Bench_t* BENCH, const BenchConfig_t* CONFIG, BenchResult_t* RESULT){
+    double Ns[BENCH_MAX_REPETITIONS], Cycles[BENCH_MAX_REPETITIONS];
+    double Start, Elapsed;
+    unsigned long Iters = 1;
+    unsigned int Reps = CONFIG->Repetitions, r;
+    uint64_t CycleStart;
+
+    if(Reps == 0){
+        Reps = 1;
+    }
+    if(Reps > BENCH_MAX_REPETITIONS){
+        Reps = BENCH_MAX_REPETITIONS;
+    }
+
+    /* Warm up caches & branch predictors, and grow Iterations till one Repetition is long enough */
+    Start = Bench_NowNs();
+    do{
+        double RepStart = Bench_NowNs();
+        BENCH->Fn(BENCH->Arg, Iters);
+        Elapsed = Bench_NowNs() - RepStart;
+        if(Elapsed < CONFIG->RepetitionMs * 1e6 && Iters < (1UL << 40)){
+            Iters *= 2;
+        }
+    }while(Bench_NowNs() - Start < CONFIG->WarmupMs * 1e6 || Elapsed < CONFIG->RepetitionMs * 1e6 / 2);
+
+    for(r = 0; r < Reps; r++){
+        CycleStart = Bench_Cycles();
+        Start = Bench_NowNs();
+        BENCH->Fn(BENCH->Arg, Iters);
+        Elapsed = Bench_NowNs() - Start;
+        Cycles[r] = (double)(Bench_Cycles() - CycleStart) / (double)Iters;
+        Ns[r] = Elapsed / (double)Iters;
+    }
+
+    RESULT->Name = BENCH->Name;
+    RESULT->Iterations = Iters;
+    RESULT->Repetitions = Reps;
+    RESULT->Ns = Bench_Stat(Ns, Reps);
+    RESULT->Cycles = Bench_Stat(Cycles, Reps);
+    RESULT->HasCycles = BENCH_HAS_CYCLES;
+}
+
+
+void Bench_PrintTable(FILE* OUT, const BenchResult_t* RESULTS, unsigned int COUNT){
+    unsigned int i;
+
+    fprintf(OUT, "%-36s %12s %10s %12s %10s %12s\n", "Benchmark", "ns/op", "MAD", "cycles/op", "MAD", "iterations");
+    for(i = 0; i < COUNT; i++){
+        fprintf(OUT, "%-36s %12.3f %10.3f", RESULTS[i].Name, RESULTS[i].Ns.Median, RESULTS[i].Ns.Mad);
+        if(RESULTS[i].HasCycles){
+            fprintf(OUT, " %12.2f %10.2f", RESULTS[i].Cycles.Median, RESULTS[i].Cycles.Mad);
+        }else{
+            fprintf(OUT, " %12s %10s", "-", "-");
+        }
+        fprintf(OUT, " %12lu\n", RESULTS[i].Iterations);
+    }
+}
+
+
+bool Bench_WriteJson(FILE* OUT, const BenchResult_t* RESULTS, unsigned int COUNT){
+    unsigned int i;
+
+    fprintf(OUT, "{\n  \"benchmarks\": [\n");
+    for(i = 0; i < COUNT; i++){
+        fprintf(OUT, "    {\"name\": \"%s\", \"iterations\": %lu, \"repetitions\": %u, "
+                "\"ns_per_op\": {\"median\": %.4f, \"mad\": %.4f}, ",
+                RESULTS[i].Name, RESULTS[i].Iterations, RESULTS[i].Repetitions,
+                RESULTS[i].Ns.Median, RESULTS[i].Ns.Mad);
+        if(RESULTS[i].HasCycles){
+            fprintf(OUT, "\"cycles_per_op\": {\"median\": %.3f, \"mad\": %.3f}}", RESULTS[i].Cycles.Median, RESULTS[i].Cycles.Mad);
+        }else{
+            fprintf(OUT, "\"cycles_per_op\": null}");
+        }
+        fprintf(OUT, (i + 1 < COUNT) ? ",\n" : "\n");
+    }
+    fprintf(OUT, "  ]\n}\n");
+
+    return ferror(OUT) == 0;
+}
+
+
+/** @brief MAD of normal noise is 0.6745 sigma, so this factor turns MAD into sigma */
+#define BENCH_MAD_TO_SIGMA      1.4826
+
+
+/** @brief Find a JSON key after a position and read the number after it
+ * @param TEXT const char* JSON text
+ * @param KEY const char* Key with its quotes
+ * @param VALUE double* Number read
+ * @return const char* Position after the number or NULL if Key or number is missing
+ */
+static const char* Bench_JsonNumber(const char* TEXT, const char* KEY, double* VALUE){
+    char* End;
+    const char* p = strstr(TEXT, KEY);
+
+    if(!p){
+        return NULL;
+    }
+    p += strlen(KEY);
+    while(*p == ' ' || *p == ':' || *p == '\t'){
+        p++;
+    }
+    *VALUE = strtod(p, &End);
+    return (End == p) ? NULL : End;
+}
+
+
+/** @brief Read median & MAD of one metric object
+ * @param TEXT const char* JSON text at the metric Key
+ * @param STAT BenchStat_t* Median & MAD read
+ * @return bool true if both are read & false if metric is null or missing
+ */
+static bool Bench_JsonStat(const char* TEXT, BenchStat_t* STAT){
+    const char* p = TEXT;
+
+    while(*p && *p != '{' && *p != 'n'){
+        p++;
+    }
+    if(*p != '{'){
+        return false;
+    }
+    p = Bench_JsonNumber(p, "\"median\"", &STAT->Median);
+    return p && Bench_JsonNumber(p, "\"mad\"", &STAT->Mad);
+}
+
+
+bool Bench_ReadJson(const char* PATH, BenchBaseline_t* BASELINE, unsigned int MAX, unsigned int* COUNT){
+    char* Text;
+    const char* p;
+    const char* End;
+    const char* Next;
+    const char* Metric;
+    long Size;
+    size_t Len;
+    FILE* File = fopen(PATH, "rb");
+
+    *COUNT = 0;
+    if(!File){
+        return false;
+    }
+    fseek(File, 0, SEEK_END);
+    Size = ftell(File);
+    fseek(File, 0, SEEK_SET);
+    Text = malloc((size_t)(Size > 0 ? Size : 0) + 1);
+    if(!Text || fread(Text, 1, (size_t)Size, File) != (size_t)Size){
+        free(Text);
+        fclose(File);
+        return false;
+    }
+    fclose(File);
+    Text[Size] = '\0';
+
+    for(p = strstr(Text, "\"name\""); p && *COUNT < MAX; p = Next){
+        BenchBaseline_t* Entry = &BASELINE[*COUNT];
+
+        /* Fields of one Benchmark end where next Benchmark starts */
+        Next = strstr(p + 1, "\"name\"");
+
+        p = strchr(p + 6, '"');
+        End = p ? strchr(p + 1, '"') : NULL;
+        if(!End){
+            break;
+        }
+        Len = (size_t)(End - p - 1);
+        if(Len >= sizeof(Entry->Name)){
+            Len = sizeof(Entry->Name) - 1;
+        }
+        memcpy(Entry->Name, p + 1, Len);
+        Entry->Name[Len] = '\0';
+
+        Metric = strstr(End, "\"ns_per_op\"");
+        if(!Metric || (Next && Metric > Next) || !Bench_JsonStat(Metric + 11, &Entry->Ns)){
+            continue;
+        }
+        Metric = strstr(End, "\"cycles_per_op\"");
+        Entry->HasCycles = Metric && (!Next || Metric < Next) && Bench_JsonStat(Metric + 15, &Entry->Cycles);
+        (*COUNT)++;
+    }
+
+    free(Text);
+    return true;
+}
+
+
+/** @brief Check one metric against its Baseline
+ * @param CURRENT const BenchStat_t* Current median & MAD
+ * @param BASE const BenchStat_t* Baseline median & MAD
+ * @param GATE const BenchGate_t* Threshold & noise limits
+ * @param CHANGE double* Change of median in percent
+ * @return bool true if metric regressed & false if not
+ */
+static bool Bench_Regressed(const BenchStat_t* CURRENT, const BenchStat_t* BASE, const BenchGate_t* GATE, double* CHANGE){
+    double Delta = CURRENT->Median - BASE->Median;
+    double Noise = GATE->NoiseMads * BENCH_MAD_TO_SIGMA * sqrt(CURRENT->Mad * CURRENT->Mad + BASE->Mad * BASE->Mad);
+
+    *CHANGE = (BASE->Median > 0) ? 100.0 * Delta / BASE->Median : 0;
+    return *CHANGE > GATE->ThresholdPct && Delta > Noise;
+}
+
+
+unsigned int Bench_CompareBaseline(FILE* OUT, const BenchResult_t* RESULTS, unsigned int COUNT,
+                                   const BenchBaseline_t* BASELINE, unsigned int BASE_COUNT, const BenchGate_t* GATE,
+                                   bool* REGRESSED){
+    unsigned int Regressions = 0, i, j;
+    double NsChange;
+    bool Slower;
+
+    if(OUT){
+        fprintf(OUT, "%-36s %12s %12s %9s %9s  %s\n", "Benchmark", "base ns/op", "ns/op", "ns", "cycles", "verdict");
+    }
+    for(i = 0; i < COUNT; i++){
+        double CyclesChange = 0;
+        bool HasCycles = RESULTS[i].HasCycles;
+
+        for(j = 0; j < BASE_COUNT && strcmp(BASELINE[j].Name, RESULTS[i].Name) != 0; j++){
+        }
+        if(REGRESSED){
+            REGRESSED[i] = false;
+        }
+        if(j == BASE_COUNT){
+            if(OUT){
+                fprintf(OUT, "%-36s %12s %12.3f %9s %9s  new\n", RESULTS[i].Name, "-", RESULTS[i].Ns.Median, "-", "-");
+            }
+            continue;
+        }
+
+        Slower = Bench_Regressed(&RESULTS[i].Ns, &BASELINE[j].Ns, GATE, &NsChange);
+        HasCycles = HasCycles && BASELINE[j].HasCycles;
+        if(HasCycles){
+            Slower = Bench_Regressed(&RESULTS[i].Cycles, &BASELINE[j].Cycles, GATE, &CyclesChange) || Slower;
+        }
+        Regressions += Slower;
+        if(REGRESSED){
+            REGRESSED[i] = Slower;
+        }
+        if(!OUT){
+            continue;
+        }
+
+        /* Cycles change is only printed when both runs counted cycles */
+        fprintf(OUT, "%-36s %12.3f %12.3f %+8.1f%% ", RESULTS[i].Name, BASELINE[j].Ns.Median, RESULTS[i].Ns.Median, NsChange);
+        if(HasCycles){
+            fprintf(OUT, "%+8.1f%%", CyclesChange);
+        }else{
+            fprintf(OUT, "%9s", "-");
+        }
+        fprintf(OUT, "  %s\n", Slower ? "REGRESSED" : "ok");
+    }
+
+    /* A Benchmark that vanished can't be checked, say so but don't fail */
+    for(j = 0; j < BASE_COUNT && OUT; j++){
+        for(i = 0; i < COUNT && strcmp(BASELINE[j].Name, RESULTS[i].Name) != 0; i++){
+        }
+        if(i == COUNT){
+            fprintf(OUT, "%-36s %12.3f %12s %9s %9s  missing\n", BASELINE[j].Name, BASELINE[j].Ns.Median, "-", "-", "-");
+        }
+    }
+
+    return Regressions;
+}
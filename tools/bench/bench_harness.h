@@ -0,0 +1,133 @@
+/**
+ * @file bench_harness.h
+ * @brief Benchmark Harness header file
+ */
+
+#ifndef BENCH_HARNESS_H_INCLUDED
+#define BENCH_HARNESS_H_INCLUDED
+
+#include <stdio.h>
+#include <stdbool.h>
+
+/** @brief Function under benchmark, it must do its operation ITERS times
+ * @param ARG void* Benchmark own data
+ * @param ITERS unsigned long Number of operations
+ */
+typedef void (*BenchFn_t)(void* ARG, unsigned long ITERS);
+
+
+/** @brief One Benchmark */
+typedef struct {
+    const char* Name;
+    BenchFn_t Fn;
+    void* Arg;
+} Bench_t;
+
+
+/** @brief How Benchmarks are run */
+typedef struct {
+    unsigned int Repetitions;
+    double WarmupMs;
+    double RepetitionMs;
+} BenchConfig_t;
+
+
+/** @brief Median & Median Absolute Deviation of one metric */
+typedef struct {
+    double Median;
+    double Mad;
+} BenchStat_t;
+
+
+/** @brief Result of one Benchmark */
+typedef struct {
+    const char* Name;
+    unsigned long Iterations;
+    unsigned int Repetitions;
+    BenchStat_t Ns;
+    BenchStat_t Cycles;
+    bool HasCycles;
+} BenchResult_t;
+
+
+/** @brief One Benchmark from a stored Baseline File */
+typedef struct {
+    char Name[64];
+    BenchStat_t Ns;
+    BenchStat_t Cycles;
+    bool HasCycles;
+} BenchBaseline_t;
+
+
+/** @brief How current Results are compared with a Baseline */
+typedef struct {
+    double ThresholdPct;
+    double NoiseMads;
+} BenchGate_t;
+
+
+/** @brief Most Repetitions of one Benchmark */
+#define BENCH_MAX_REPETITIONS   101
+
+
+/** @brief Warm up, find how many operations fill one Repetition, then time all Repetitions
+ * @param BENCH const Bench_t* Benchmark to run
+ * @param CONFIG const BenchConfig_t* How to run it
+ * @param RESULT BenchResult_t* Median & MAD of ns/op and cycles/op
+ * @return void
+ */
+void Bench_Run(const Bench_t* BENCH, const BenchConfig_t* CONFIG, BenchResult_t* RESULT);
+
+
+/** @brief Median & Median Absolute Deviation of some values
+ * @param VALUES double* Values, they are sorted
+ * @param COUNT unsigned int Number of values
+ * @return BenchStat_t Median & MAD
+ */
+BenchStat_t Bench_Stat(double* VALUES, unsigned int COUNT);
+
+
+/** @brief Print Results as a table
+ * @param OUT FILE* Where to print
+ * @param RESULTS const BenchResult_t* Results
+ * @param COUNT unsigned int Number of Results
+ * @return void
+ */
+void Bench_PrintTable(FILE* OUT, const BenchResult_t* RESULTS, unsigned int COUNT);
+
+
+/** @brief Write Results as JSON
+ * @param OUT FILE* Where to write
+ * @param RESULTS const BenchResult_t* Results
+ * @param COUNT unsigned int Number of Results
+ * @return bool true if JSON is written & false if not
+ */
+bool Bench_WriteJson(FILE* OUT, const BenchResult_t* RESULTS, unsigned int COUNT);
+
+/** @brief Read Baseline File written by Bench_WriteJson()
+ * @param PATH const char* Baseline File path
+ * @param BASELINE BenchBaseline_t* Benchmarks read
+ * @param MAX unsigned int Most Benchmarks to read
+ * @param COUNT unsigned int* Number of Benchmarks read
+ * @return bool true if Baseline File is read & false if not
+ */
+bool Bench_ReadJson(const char* PATH, BenchBaseline_t* BASELINE, unsigned int MAX, unsigned int* COUNT);
+
+
+/** @brief Compare Results with Baseline and print one report Line per Benchmark. A metric regressed only if
+ * its median is more than ThresholdPct above Baseline median AND the change is larger than
+ * NoiseMads times the noise (scaled MADs of both), so noisy Repetitions don't fail the gate
+ * @param OUT FILE* Where to print the report, NULL to print nothing
+ * @param RESULTS const BenchResult_t* Current Results
+ * @param COUNT unsigned int Number of Results
+ * @param BASELINE const BenchBaseline_t* Baseline Benchmarks
+ * @param BASE_COUNT unsigned int Number of Baseline Benchmarks
+ * @param GATE const BenchGate_t* Threshold & noise limits
+ * @param REGRESSED bool* Set per Result if it regressed, may be NULL
+ * @return unsigned int Number of regressed Benchmarks
+ */
+unsigned int Bench_CompareBaseline(FILE* OUT, const BenchResult_t* RESULTS, unsigned int COUNT,
+                                   const BenchBaseline_t* BASELINE, unsigned int BASE_COUNT, const BenchGate_t* GATE,
+                                   bool* REGRESSED);
+
+#endif // BENCH_HARNESS_H_INCLUDED
@@ -0,0 +1,83 @@
+/**
+ * @file event_dump.c
+ * @brief Event Dump tool
+ * @details Here we decode a Raw Dump of the Event Ring (events.bin written when the Controller crashes)
+ * and print its Records in order, oldest first <br>
+ * Usage: event_dump DUMP
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*    Include Modules    */
+#include "../../source/event_ring/event_ring.h"
+
+
+/** @brief Order Records by Seq
+ * @param A const void* First Record
+ * @param B const void* Second Record
+ * @return int Negative, 0 or positive like strcmp()
+ */
+static int EventDump_CompareSeq(const void* A, const void* B){
+    uint32_t First = ((const EventRecord_t*)A)->Seq;
+    uint32_t Second = ((const EventRecord_t*)B)->Seq;
+
+    return (First > Second) - (First < Second);
+}
+
+
+/** @brief main function decode Raw Dump
+ * @param argc int
+ * @param argv[] char*
+ * @return int 0 if all is fine & 1 if there's an error
+ */
+int main(int argc, char* argv[])
+{
+    unsigned char Header[EVENT_RING_HEADER_SIZE];
+    EventRecord_t* Records;
+    uint32_t Count, Valid = 0, i;
+    FILE* File;
+
+    if(argc != 2){
+        fprintf(stderr, "Usage: %s DUMP\n", argv[0]);
+        return 1;
+    }
+
+    File = fopen(argv[1], "rb");
+    if(File == NULL){
+        fprintf(stderr, "Failed To open %s\n", argv[1]);
+        return 1;
+    }
+
+    if(fread(Header, 1, sizeof(Header), File) != sizeof(Header) || memcmp(Header, EVENT_RING_MAGIC, 4) != 0
+       || Header[4] != EVENT_RING_VERSION || Header[5] != sizeof(EventRecord_t)){
+        fprintf(stderr, "%s is not an Event Ring Dump\n", argv[1]);
+        fclose(File);
+        return 1;
+    }
+    memcpy(&Count, Header + 8, sizeof(Count));
+
+    Records = (Count != 0) ? malloc(Count * sizeof(EventRecord_t)) : NULL;
+    if(Count != 0 && (Records == NULL || fread(Records, sizeof(EventRecord_t), Count, File) != Count)){
+        fprintf(stderr, "%s is cut\n", argv[1]);
+        free(Records);
+        fclose(File);
+        return 1;
+    }
+    fclose(File);
+
+    /* Slots are in ring order, Seq 0 is never written or was being written at the crash */
+    for(i = 0; i < Count; i++){
+        if(Records[i].Seq != 0){
+            Records[Valid++] = Records[i];
+        }
+    }
+    qsort(Records, Valid, sizeof(EventRecord_t), EventDump_CompareSeq);
+
+    printf("%lu events, time in %s\n", (unsigned long)Valid, Header[6] == EVENT_TIME_CYCLES ? "cycles" : "ns");
+    EventRing_Print(stdout, Records, Valid);
+    free(Records);
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file gateway_daemon.c
+ * @brief Gateway Daemon tool
+ * @details Here we host many Speed Controllers (simulated units) in one process behind a UNIX socket,
+ * so a test farm needs one process instead of one per unit. Protocol & batching are in source/gateway <br>
+ * Usage: gateway_daemon [-j SHARDS] [-n UNITS] SOCKET <br>
+ * -j SHARDS     Shard threads (default 0, one per CPU) <br>
+ * -n UNITS      Units, numbered 0 to UNITS - 1 (default 4096) <br>
+ * Stops on SIGINT or SIGTERM
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+
+/*    Include Modules    */
+#include "../../source/gateway/gateway.h"
+
+/** @brief Set by SIGINT or SIGTERM to stop serving */
+static volatile sig_atomic_t STOP;
+
+
+/** @brief Stop serving after the current wait
+ * @param SIG int Signal number
+ * @return void
+ */
+static void Stop(int SIG){
+    (void)SIG;
+    STOP = 1;
+}
+
+
+/** @brief main function serve Units on a socket
+ * @param argc int
+ * @param argv[] char*
+ * @return int 0 if all is fine & 1 if there's an error
+ */
+int main(int argc, char* argv[])
+{
+    static Gateway_t Gateway;
+    GatewayStats_t Stats;
+    unsigned long Units = 4096;
+    unsigned int Shards = 0;
+    int Arg;
+
+    for(Arg = 1; Arg + 2 < argc; Arg += 2){
+        if(strcmp(argv[Arg], "-j") == 0){
+            Shards = (unsigned int)strtoul(argv[Arg + 1], NULL, 10);
+        }else if(strcmp(argv[Arg], "-n") == 0){
+            Units = strtoul(argv[Arg + 1], NULL, 10);
+        }else{
+            break;
+        }
+    }
+    if(Arg + 1 != argc){
+        fprintf(stderr, "Usage: %s [-j SHARDS] [-n UNITS] SOCKET\n", argv[0]);
+        return 1;
+    }
+
+    if(!Gateway_Init(&Gateway, Units, Shards)){
+        fprintf(stderr, "Failed To create %lu Units\n", Units);
+        return 1;
+    }
+    if(!Gateway_Listen(&Gateway, argv[Arg])){
+        fprintf(stderr, "Failed To listen on %s\n", argv[Arg]);
+        Gateway_Destroy(&Gateway);
+        return 1;
+    }
+    signal(SIGINT, Stop);
+    signal(SIGTERM, Stop);
+    printf("Serving %lu Units on %u Shards at %s\n", Gateway.Units, Gateway.ShardCount, argv[Arg]);
+
+    while(!STOP){
+        Gateway_Poll(&Gateway, 100);
+    }
+
+    Gateway_Stats(&Gateway, &Stats);
+    printf("%llu Requests in %llu batches from %lu clients\n", Stats.Requests, Stats.Batches, Stats.Accepted);
+    Gateway_Destroy(&Gateway);
+    return 0;
+}
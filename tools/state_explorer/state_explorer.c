@@ -0,0 +1,70 @@
+/**
+ * @file state_explorer.c
+ * @brief State Space Explorer tool
+ * @details Here we compare Speed Update with the Reference Model on every Input sequence up to a length,
+ * and print how many sequences were checked, how fast & the reached State transition coverage. <br>
+ * A failed sequence is printed as switch.txt Lines so it can be added to the UPDATE tests. <br>
+ * Usage: state_explorer [-k DEPTH] (default 3, at most 8)
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*    Include Modules    */
+#include "../../test/state_explorer/state_explorer.h"
+
+/** @brief Switch State names as in switch.txt */
+static const char* const STATE_NAMES[] = {"PRE_PRESSED", "PRESSED", "PRE_RELEASED", "RELEASED"};
+
+/** @brief Speed names */
+static const char* const SPEED_NAMES[] = {"MIN", "MED", "MAX"};
+
+
+/** @brief main function explore Speed Update
+ * @param argc int
+ * @param argv[] char*
+ * @return int 0 if all sequences match, 1 if there's an error & 2 if a sequence failed
+ */
+int main(int argc, char* argv[])
+{
+    ExplorerReport_t Report;
+    unsigned int Depth = 3, i;
+    clock_t Start;
+    double Seconds;
+    bool Ok;
+
+    if(argc == 3 && strcmp(argv[1], "-k") == 0){
+        Depth = (unsigned int)strtoul(argv[2], NULL, 10);
+    }else if(argc != 1){
+        Depth = 0;
+    }
+    if(Depth < 1 || Depth > EXPLORER_MAX_DEPTH){
+        fprintf(stderr, "Usage: %s [-k DEPTH] (DEPTH from 1 to %d)\n", argv[0], EXPLORER_MAX_DEPTH);
+        return 1;
+    }
+
+    Start = clock();
+    Ok = Explorer_Run(SpeedCtl_Update, Depth, &Report);
+    Seconds = (double)(clock() - Start) / CLOCKS_PER_SEC;
+
+    printf("Depth %u: %llu sequences, %llu Speed Updates in %.2f s (%.1f M/s)\n", Depth, Report.Sequences,
+           Report.Steps, Seconds, Seconds > 0 ? Report.Steps / Seconds / 1e6 : 0.0);
+    printf("Speed transitions reached: %u, pairs of transitions reached (1-switch): %u\n",
+           Report.Transitions, Report.TransitionPairs);
+
+    if(Ok){
+        printf("All sequences match the Reference Model\n");
+        return 0;
+    }
+
+    printf("Failed from %s Speed after %u Input(s), expected Motor Angle %d but was %d:\n",
+           SPEED_NAMES[Report.StartSpeed], Report.Length, Report.Expected, Report.Actual);
+    for(i = 0; i < Report.Length; i++){
+        printf("%s\t%s\t%s\t%u\n", STATE_NAMES[Report.Inputs[i].Postive_State], STATE_NAMES[Report.Inputs[i].Negative_State],
+               STATE_NAMES[Report.Inputs[i].P_State], Report.Inputs[i].P_PressTime);
+    }
+    return 2;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file telemetry_monitor.c
+ * @brief Telemetry Monitor tool
+ * @details Here we print the live Counters of running Controllers (started with -s NAME) every interval,
+ * reading them never stops nor slows the Control Loop <br>
+ * Usage: telemetry_monitor [-i INTERVAL_MS] [-n SAMPLES] NAME <br>
+ * -i INTERVAL_MS    Time between Samples (default 1000) <br>
+ * -n SAMPLES        Stop after SAMPLES Samples (default 0, never stop)
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/*    Include Modules    */
+#include "../../source/telemetry/telemetry.h"
+
+
+/** @brief Sleep some time
+ * @param MS unsigned long Time in ms
+ * @return void
+ */
+static void Monitor_Sleep(unsigned long MS){
+#ifdef _WIN32
+    Sleep((DWORD)MS);
+#else
+    struct timespec Time;
+
+    Time.tv_sec = (time_t)(MS / 1000);
+    Time.tv_nsec = (long)(MS % 1000) * 1000000L;
+    nanosleep(&Time, NULL);
+#endif
+}
+
+
+/** @brief main function print Counters
+ * @param argc int
+ * @param argv[] char*
+ * @return int 0 if all is fine & 1 if there's an error
+ */
+int main(int argc, char* argv[])
+{
+    static const char* const SPEEDS[] = {"MIN", "MED", "MAX"};
+    Telemetry_t Telemetry;
+    TelemetryCounters_t Counters;
+    unsigned long Interval = 1000, Samples = 0, Sample;
+    unsigned int Controller;
+    int Arg;
+
+    for(Arg = 1; Arg + 2 < argc; Arg += 2){
+        if(strcmp(argv[Arg], "-i") == 0){
+            Interval = strtoul(argv[Arg + 1], NULL, 10);
+        }else if(strcmp(argv[Arg], "-n") == 0){
+            Samples = strtoul(argv[Arg + 1], NULL, 10);
+        }else{
+            break;
+        }
+    }
+    if(Arg + 1 != argc){
+        fprintf(stderr, "Usage: %s [-i INTERVAL_MS] [-n SAMPLES] NAME\n", argv[0]);
+        return 1;
+    }
+    if(!Telemetry_Attach(&Telemetry, argv[Arg])){
+        fprintf(stderr, "No Controller Telemetry %s\n", argv[Arg]);
+        return 1;
+    }
+
+    printf("%-4s %12s %9s %5s %5s %11s %9s %9s %9s %14s\n", "ctl", "ticks", "overruns", "speed", "angle",
+           "transitions", "+ve", "-ve", "P", "edge->angle us");
+    for(Sample = 0; Samples == 0 || Sample < Samples; Sample++){
+        if(Sample != 0){
+            Monitor_Sleep(Interval);
+        }
+        for(Controller = 0; Controller < Telemetry_Controllers(&Telemetry); Controller++){
+            if(!Telemetry_Read(&Telemetry, Controller, &Counters)){
+                printf("%-4u busy\n", Controller);
+                continue;
+            }
+            printf("%-4u %12llu %9llu %5s %5lu %11llu %9llu %9llu %9llu %14.3f\n", Controller,
+                   (unsigned long long)Counters.Ticks, (unsigned long long)Counters.Overruns,
+                   SPEEDS[Counters.Speed % 3], (unsigned long)Counters.Angle, (unsigned long long)Counters.Transitions,
+                   (unsigned long long)Counters.Presses[0], (unsigned long long)Counters.Presses[1],
+                   (unsigned long long)Counters.Presses[2], (double)Counters.LastEdgeLatencyNs / 1000.0);
+        }
+        fflush(stdout);
+    }
+
+    Telemetry_Close(&Telemetry);
+    return 0;
+}
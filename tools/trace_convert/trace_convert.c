@@ -0,0 +1,97 @@
+/**
+ * @file trace_convert.c
+ * @brief Trace Converter tool
+ * @details Here we convert a Trace from switch.txt Text Format to the Binary Format or back.
+ * Input Format is detected from its Header <br>
+ * Usage: trace_convert [-t | -b] INPUT OUTPUT <br>
+ * -b write Binary Trace (default when Input is Text), -t write Text Trace (default when Input is Binary)
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/*    Include Modules    */
+#include "../../test/trace_reader/trace_reader.h"
+#include "../../test/trace_reader/trace_writer.h"
+
+
+/** @brief Print how to use this tool
+ * @param NAME const char* Program name
+ * @return int 1 as an error
+ */
+static int Print_Usage(const char* NAME){
+    fprintf(stderr, "Usage: %s [-t | -b] INPUT OUTPUT\n", NAME);
+    fprintf(stderr, "  -t  Write switch.txt Text Trace\n");
+    fprintf(stderr, "  -b  Write packed Binary Trace\n");
+    return 1;
+}
+
+
+/** @brief main function convert Input Trace into Output Trace
+ * @param argc int
+ * @param argv[] char*
+ * @return int 0 if all is fine & 1 if there's an error
+ */
+int main(int argc, char* argv[])
+{
+    TraceReader_t Reader;
+    TraceWriter_t Writer;
+    TraceLine_t Line;
+    TraceFormat_t Format = TRACE_BINARY;
+    TraceStatus_t Status;
+    unsigned long Lines = 0, Cases = 0, Incorrect = 0;
+    bool Forced = false, Ok = true;
+    int Arg = 1;
+
+    if(argc == 4 && (strcmp(argv[1], "-t") == 0 || strcmp(argv[1], "-b") == 0)){
+        Format = (argv[1][1] == 'b') ? TRACE_BINARY : TRACE_TEXT;
+        Forced = true;
+        Arg = 2;
+    }else if(argc != 3){
+        return Print_Usage(argv[0]);
+    }
+
+    if(!Trace_Open(&Reader, argv[Arg])){
+        fprintf(stderr, "Failed To open Trace %s\n", argv[Arg]);
+        return 1;
+    }
+
+    /*    Convert to the other Format unless told which one    */
+    if(!Forced){
+        Format = (Reader.Format == TRACE_TEXT) ? TRACE_BINARY : TRACE_TEXT;
+    }
+
+    if(!Trace_WriterOpen(&Writer, argv[Arg + 1], Format)){
+        fprintf(stderr, "Failed To create Trace %s\n", argv[Arg + 1]);
+        Trace_Close(&Reader);
+        return 1;
+    }
+
+    while(Ok && (Status = Trace_ReadLine(&Reader, &Line)) != TRACE_END_OF_FILE){
+        switch(Status){
+        case TRACE_DATA:
+            Ok = Trace_WriteLine(&Writer, &Line);
+            Lines++;
+            break;
+        case TRACE_END_OF_CASE:
+            Ok = Trace_WriteEndOfCase(&Writer);
+            Cases++;
+            break;
+        default:
+            Incorrect++;
+            break;
+        }
+    }
+
+    Ok = Trace_WriterClose(&Writer) && Ok;
+    Trace_Close(&Reader);
+
+    if(!Ok){
+        fprintf(stderr, "Failed To write Trace %s\n", argv[Arg + 1]);
+        return 1;
+    }
+
+    printf("%lu Test Lines, %lu Test Cases, %lu incorrect Lines skipped\n", Lines, Cases, Incorrect);
+    return 0;
+}
@@ -0,0 +1,347 @@
+/**
+ * @file trace_gen.c
+ * @brief Trace Generator tool
+ * @details Here we generate random Test Cases in switch.txt Text Format or in Binary Format,
+ * and the expected Motor Angle of every Test Case (motor.txt Format) from the Reference Model. <br>
+ * Every Switch moves RELEASED -> PRE_PRESSED -> PRESSED -> PRE_RELEASED -> RELEASED like a real one,
+ * and may chatter (bounce between PRE_PRESSED and PRE_RELEASED) for some Lines. <br>
+ * Usage: trace_gen [options] TRACE EXPECTED <br>
+ * -n CASES          Number of Test Cases (default 1000) <br>
+ * -l MIN,MAX        Test Lines per Test Case (default 1,8) <br>
+ * -p POS,NEG,P      Probability a released Switch is pressed on a Line (default 0.2,0.2,0.1) <br>
+ * -L PROB           Probability a P press is a long press, 30 or more (default 0.3) <br>
+ * -c PROB           Probability a released Switch starts chattering on a Line (default 0.02) <br>
+ * -s SEED           Random seed, same seed gives the same Trace (default 1) <br>
+ * -b                Write Binary Trace <br>
+ * A bad option value (not a whole number, a Probability out of 0..1, trailing text) prints the Usage
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <limits.h>
+
+/*    Include Modules    */
+#include "../../test/trace_reader/trace_writer.h"
+#include "../../test/result_sink/result_sink.h"
+#include "../../test/reference_model/reference_model.h"
+
+/** @brief Number of simulated Switches */
+#define GEN_SWITCHES    3
+
+/** @brief Generator settings */
+typedef struct {
+    unsigned long Cases;
+    unsigned int MinLines;
+    unsigned int MaxLines;
+    double Press[GEN_SWITCHES];
+    double LongPress;
+    double Chatter;
+    uint64_t Seed;
+    TraceFormat_t Format;
+} GenConfig_t;
+
+/** @brief One simulated Switch */
+typedef struct {
+    SwitchState_t State;
+    unsigned int Hold;
+    unsigned int Chatter;
+    unsigned int Time;
+    unsigned int Target;
+} GenSwitch_t;
+
+/** @brief Random generator state (xorshift64*), same on every platform */
+static uint64_t RANDOM_STATE;
+
+
+/** @brief Next random number
+ * @param void
+ * @return uint64_t Random number
+ */
+static uint64_t Random_Next(void){
+    RANDOM_STATE ^= RANDOM_STATE >> 12;
+    RANDOM_STATE ^= RANDOM_STATE << 25;
+    RANDOM_STATE ^= RANDOM_STATE >> 27;
+    return RANDOM_STATE * 0x2545F4914F6CDD1DULL;
+}
+
+
+/** @brief Random number in a range
+ * @param MIN unsigned int Smallest number
+ * @param MAX unsigned int Largest number
+ * @return unsigned int Random number from MIN to MAX
+ */
+static unsigned int Random_Range(unsigned int MIN, unsigned int MAX){
+    return MIN + (unsigned int)(Random_Next() % ((uint64_t)MAX - MIN + 1));
+}
+
+
+/** @brief Random event
+ * @param PROB double Probability of the event
+ * @return int 1 if the event happens & 0 if not
+ */
+static int Random_Chance(double PROB){
+    return (double)(Random_Next() >> 11) * (1.0 / 9007199254740992.0) < PROB;
+}
+
+
+/** @brief Move simulated Switch to its State on the next Line
+ * @param SW GenSwitch_t* Simulated Switch
+ * @param IS_P int 1 if it is P Switch, P Press Time is counted only for it
+ * @param PRESS double Probability to be pressed now
+ * @param CONFIG const GenConfig_t* Generator settings
+ * @return void
+ */
+static void GenSwitch_Step(GenSwitch_t* SW, int IS_P, double PRESS, const GenConfig_t* CONFIG){
+    if(SW->Chatter != 0){
+        SW->State = Random_Chance(0.5) ? PREPRESSED : PRERELEASED;
+        if(--SW->Chatter == 0){
+            SW->State = PRERELEASED;
+        }
+        return;
+    }
+
+    switch(SW->State){
+    case RELEASED:
+        if(Random_Chance(PRESS)){
+            SW->State = PREPRESSED;
+            SW->Hold = Random_Range(1, 4);
+            SW->Time = 0;
+            SW->Target = (IS_P && Random_Chance(CONFIG->LongPress)) ? Random_Range(30, 255) : Random_Range(1, 29);
+
+        }else if(Random_Chance(CONFIG->Chatter)){
+            SW->State = PREPRESSED;
+            SW->Chatter = Random_Range(2, 6);
+        }
+        break;
+
+    case PREPRESSED:
+        SW->State = PRESSED;
+        break;
+
+    case PRESSED:
+        /* P Press Time grows till its target in some Lines, other Switches are held some Lines */
+        if(IS_P){
+            if(SW->Time >= SW->Target){
+                SW->State = PRERELEASED;
+            }else{
+                SW->Time += Random_Range(1, SW->Target);
+                if(SW->Time > SW->Target){
+                    SW->Time = SW->Target;
+                }
+            }
+        }else if(--SW->Hold == 0){
+            SW->State = PRERELEASED;
+        }
+        break;
+
+    default:
+        SW->State = RELEASED;
+        break;
+    }
+}
+
+
+/** @brief Read a list of numbers separated by commas
+ * @param TEXT const char* Option value
+ * @param VALUES double* Numbers
+ * @param COUNT int Number of Numbers expected
+ * @return int 1 if all Numbers are read & 0 if not
+ */
+static int Parse_List(const char* TEXT, double* VALUES, int COUNT){
+    char* End;
+    int i;
+
+    for(i = 0; i < COUNT; i++){
+        VALUES[i] = strtod(TEXT, &End);
+        if(End == TEXT || (i + 1 < COUNT && *End != ',')){
+            return 0;
+        }
+        TEXT = End + 1;
+    }
+    return *End == '\0';
+}
+
+
+/** @brief Read a whole number, strtoull() alone would take spaces, a sign or trailing text
+ * @param TEXT const char* Option value
+ * @param VALUE unsigned long long* Number
+ * @return int 1 if TEXT has only digits & the Number fits & 0 if not
+ */
+static int Parse_Unsigned(const char* TEXT, unsigned long long* VALUE){
+    char* End;
+
+    if(*TEXT < '0' || *TEXT > '9'){
+        return 0;
+    }
+    errno = 0;
+    *VALUE = strtoull(TEXT, &End, 10);
+    return *End == '\0' && errno != ERANGE;
+}
+
+
+/** @brief Read Probabilities separated by commas
+ * @param TEXT const char* Option value
+ * @param VALUES double* Probabilities
+ * @param COUNT int Number of Probabilities expected
+ * @return int 1 if all are read & between 0 and 1 & 0 if not
+ */
+static int Parse_Probabilities(const char* TEXT, double* VALUES, int COUNT){
+    int i;
+
+    if(!Parse_List(TEXT, VALUES, COUNT)){
+        return 0;
+    }
+    for(i = 0; i < COUNT; i++){
+        /* NaN fails both */
+        if(!(VALUES[i] >= 0 && VALUES[i] <= 1)){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+/** @brief Read Command Line options
+ * @param argc int
+ * @param argv[] char*
+ * @param CONFIG GenConfig_t* Generator settings
+ * @return int Index of first path or 0 if options are wrong
+ */
+static int Parse_Options(int argc, char* argv[], GenConfig_t* CONFIG){
+    double Values[GEN_SWITCHES];
+    unsigned long long Number;
+    int i;
+
+    for(i = 1; i < argc && argv[i][0] == '-'; i++){
+        if(strcmp(argv[i], "-b") == 0){
+            CONFIG->Format = TRACE_BINARY;
+            continue;
+        }
+        if(argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc){
+            return 0;
+        }
+
+        switch(argv[i++][1]){
+        case 'n':
+            if(!Parse_Unsigned(argv[i], &Number) || Number == 0 || Number > ULONG_MAX){
+                return 0;
+            }
+            CONFIG->Cases = (unsigned long)Number;
+            break;
+        case 'l':
+            if(!Parse_List(argv[i], Values, 2) || Values[0] < 1 || Values[1] < Values[0]){
+                return 0;
+            }
+            CONFIG->MinLines = (unsigned int)Values[0];
+            CONFIG->MaxLines = (unsigned int)Values[1];
+            break;
+        case 'p':
+            if(!Parse_Probabilities(argv[i], CONFIG->Press, GEN_SWITCHES)){
+                return 0;
+            }
+            break;
+        case 'L':
+            if(!Parse_Probabilities(argv[i], &CONFIG->LongPress, 1)){
+                return 0;
+            }
+            break;
+        case 'c':
+            if(!Parse_Probabilities(argv[i], &CONFIG->Chatter, 1)){
+                return 0;
+            }
+            break;
+        case 's':
+            if(!Parse_Unsigned(argv[i], &Number)){
+                return 0;
+            }
+            CONFIG->Seed = (uint64_t)Number;
+            break;
+        default:
+            return 0;
+        }
+    }
+
+    return (argc - i == 2) ? i : 0;
+}
+
+
+/** @brief main function generate Trace & expected Results
+ * @param argc int
+ * @param argv[] char*
+ * @return int 0 if all is fine & 1 if there's an error
+ */
+int main(int argc, char* argv[])
+{
+    GenConfig_t Config = {1000, 1, 8, {0.2, 0.2, 0.1}, 0.3, 0.02, 1, TRACE_TEXT};
+    GenSwitch_t Switches[GEN_SWITCHES];
+    TraceWriter_t Writer;
+    ResultSink_t Expected;
+    TraceLine_t Line;
+    SpeedInput_t Input;
+    unsigned long Case;
+    unsigned int Lines, i, Sw;
+    unsigned char Speed;
+    int Ok = 1;
+    int Arg = Parse_Options(argc, argv, &Config);
+
+    if(Arg == 0){
+        fprintf(stderr, "Usage: %s [-n CASES] [-l MIN,MAX] [-p POS,NEG,P] [-L PROB] [-c PROB] [-s SEED] [-b] TRACE EXPECTED\n", argv[0]);
+        return 1;
+    }
+
+    /* xorshift never leaves 0 */
+    RANDOM_STATE = Config.Seed ? Config.Seed : 0x9E3779B97F4A7C15ULL;
+
+    if(!Trace_WriterOpen(&Writer, argv[Arg], Config.Format)){
+        fprintf(stderr, "Failed To create Trace %s\n", argv[Arg]);
+        return 1;
+    }
+    if(!ResultSink_Open(&Expected, argv[Arg + 1])){
+        fprintf(stderr, "Failed To create Result file %s\n", argv[Arg + 1]);
+        Trace_WriterClose(&Writer);
+        return 1;
+    }
+
+    for(Case = 0; Case < Config.Cases && Ok; Case++){
+
+        /* Every Test Case starts from released Switches & default Speed */
+        memset(Switches, 0, sizeof(Switches));
+        for(Sw = 0; Sw < GEN_SWITCHES; Sw++){
+            Switches[Sw].State = RELEASED;
+        }
+        Speed = REF_SPEED_MED;
+
+        Lines = Random_Range(Config.MinLines, Config.MaxLines);
+        for(i = 0; i < Lines && Ok; i++){
+            for(Sw = 0; Sw < GEN_SWITCHES; Sw++){
+                GenSwitch_Step(&Switches[Sw], Sw == P, Config.Press[Sw], &Config);
+            }
+
+            Line.Postive_State = Switches[POSTIVE].State;
+            Line.Negative_State = Switches[NEGATIVE].State;
+            Line.P_State = Switches[P].State;
+            Line.P_PressTime = (unsigned char)((Switches[P].State == PRESSED) ? Switches[P].Time : 0);
+            Ok = Trace_WriteLine(&Writer, &Line);
+
+            Input.Postive_State = Line.Postive_State;
+            Input.Negative_State = Line.Negative_State;
+            Input.P_State = Line.P_State;
+            Input.P_PressTime = Line.P_PressTime;
+            Speed = RefModel_Step(Speed, &Input);
+        }
+
+        Ok = Ok && Trace_WriteEndOfCase(&Writer) && ResultSink_Write(&Expected, (unsigned char)RefModel_Angle(Speed));
+    }
+
+    Ok = Trace_WriterClose(&Writer) && Ok;
+    Ok = ResultSink_Close(&Expected) && Ok;
+    if(!Ok){
+        fprintf(stderr, "Failed To write %s or %s\n", argv[Arg], argv[Arg + 1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file trace_replay.c
+ * @brief Trace Replay tool
+ * @details Here we replay every Test Case of a Trace (Text or Binary) on all CPUs
+ * and write the Motor Angles in motor.txt Format <br>
+ * Usage: trace_replay [-j THREADS] TRACE RESULT
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*    Include Modules    */
+#include "../../test/replay/replay.h"
+
+
+/** @brief main function replay Trace into Result File
+ * @param argc int
+ * @param argv[] char*
+ * @return int 0 if all is fine & 1 if there's an error
+ */
+int main(int argc, char* argv[])
+{
+    unsigned int Threads = 0;
+    int Arg = 1;
+
+    if(argc == 5 && strcmp(argv[1], "-j") == 0){
+        Threads = (unsigned int)strtoul(argv[2], NULL, 10);
+        Arg = 3;
+    }else if(argc != 3){
+        fprintf(stderr, "Usage: %s [-j THREADS] TRACE RESULT\n", argv[0]);
+        return 1;
+    }
+
+    if(!Replay_Run(argv[Arg], argv[Arg + 1], Threads, 0)){
+        fprintf(stderr, "Failed To replay %s into %s\n", argv[Arg], argv[Arg + 1]);
+        return 1;
+    }
+    return 0;
+}